@@ -26,6 +26,10 @@
 /* ///////////////////////////////////////////////////////////////////// */
 #include "pluto.h"
 
+#if GEOMETRY == SPHERICAL
+static void PrimSourceCotangent (double *, double *, double, double);
+#endif
+
 /* *********************************************************************** */
 void PrimRHS (double *v, double *dv, double cs2, double h, double *Adv)
 /*!
@@ -127,6 +131,7 @@ void PrimSource (const State *gas, double **src, int beg, int end, Grid *grid)
  * These include:
  *
  *  - Geometrical sources;
+ *  - Coriolis and centrifugal terms (rotating frame);
  *  - Shearing-box terms 
  *  - Gravity;
  *  - terms related to divergence of B control (Powell eight wave and GLM);
@@ -144,9 +149,8 @@ void PrimSource (const State *gas, double **src, int beg, int end, Grid *grid)
  * \param [in]  end   final   index of computation
  * \param [in]  grid  pointer to a Grid structure
  *
- * \note This function does not work in spherical coordinates yet. 
- *   For future implementations we annotate hereafter the induction 
- *   equation in spherical coordinates:
+ * In spherical coordinates the induction equation in conservative
+ * form reads:
  *
  *  \f[ \partial_tB_r + \frac{1}{r}\partial_\theta E_\phi
  *    - \frac{1}{r\sin\theta}\partial_\phi E_\theta = -E_\phi\cot\theta/r \f]
@@ -173,11 +177,6 @@ void PrimSource (const State *gas, double **src, int beg, int end, Grid *grid)
   static double *phi_p;
   double g[3], ch2, db, scrh;
 
-#if ROTATING_FRAME == YES
-  printLog ("! PrimSource(): does not work with rotations\n");
-  QUIT_PLUTO(1);
-#endif
-
 /* ----------------------------------------------------------
    0. Memory allocation and array initialization
    ---------------------------------------------------------- */
@@ -241,11 +240,82 @@ void PrimSource (const State *gas, double **src, int beg, int end, Grid *grid)
 
 #elif GEOMETRY == SPHERICAL 
 
-  printLog ("! PrimSource: not implemented in Spherical geometry\n");
-  QUIT_PLUTO(1);
+/* -- 1/r terms are included during the radial sweep while
+      cot(theta)/r terms during the meridional sweep,
+      consistently with the conservative update          -- */
+
+  if (g_dir == IDIR) {
+    for (i = beg; i <= end; i++){
+      v     = gas->v[i];
+      tau   = 1.0/v[RHO];
+      r_inv = 1.0/x1[i];
+
+      src[i][RHO]    = -2.0*v[RHO]*v[iVR]*r_inv;
+      #if PHYSICS == HD
+      src[i][iVR]    = (v[iVTH]*v[iVTH] + v[iVPHI]*v[iVPHI])*r_inv;
+      src[i][iVTH]   = -v[iVR]*v[iVTH]*r_inv;
+      src[i][iVPHI]  = -v[iVR]*v[iVPHI]*r_inv;
+      #elif PHYSICS == MHD
+      src[i][iVR]    = (  v[iVTH]*v[iVTH] + v[iVPHI]*v[iVPHI]
+                        - (v[iBTH]*v[iBTH] + v[iBPHI]*v[iBPHI])*tau)*r_inv;
+      src[i][iVTH]   = (-v[iVR]*v[iVTH]  + v[iBR]*v[iBTH]*tau)*r_inv;
+      src[i][iVPHI]  = (-v[iVR]*v[iVPHI] + v[iBR]*v[iBPHI]*tau)*r_inv;
+      src[i][iBR]    = -2.0*v[iBR]*v[iVR]*r_inv;
+      src[i][iBTH]   = -(v[iVTH]*v[iBR]  + v[iVR]*v[iBTH])*r_inv;
+      src[i][iBPHI]  = -(v[iVPHI]*v[iBR] + v[iVR]*v[iBPHI])*r_inv;
+      #endif
+      #if !INCLUDE_JDIR
+      PrimSourceCotangent (v, src[i], x1[i], x2[j]);
+      #endif
+
+      #if EOS == IDEAL
+      src[i][PRS] = a2[i]*src[i][RHO];
+      #endif
+    }
+  }else if (g_dir == JDIR){
+    for (j = beg; j <= end; j++){
+      v = gas->v[j];
+      PrimSourceCotangent (v, src[j], x1[i], x2[j]);
+      #if EOS == IDEAL
+      src[j][PRS] = a2[j]*src[j][RHO];
+      #endif
+    }
+  }
   
 #endif
 
+/* --------------------------------------------------------
+   1a. Coriolis and centrifugal terms in the rotating frame
+       (velocities are relative to the rotating frame).
+   -------------------------------------------------------- */
+
+#if ROTATING_FRAME == YES
+  if (g_dir == IDIR) {
+    double Om = g_OmegaZ, st;
+
+    #if GEOMETRY == SPHERICAL
+    th = x2[j];
+    st = sin(th);
+    ct = cos(th);
+    for (i = beg; i <= end; i++){
+      v = gas->v[i];
+      src[i][iVR]   += 2.0*Om*st*v[iVPHI] + Om*Om*x1[i]*st*st;
+      src[i][iVTH]  += 2.0*Om*ct*v[iVPHI] + Om*Om*x1[i]*st*ct;
+      src[i][iVPHI] -= 2.0*Om*(ct*v[iVTH] + st*v[iVR]);
+    }
+    #elif (GEOMETRY == CYLINDRICAL) || (GEOMETRY == POLAR)
+    for (i = beg; i <= end; i++){
+      v = gas->v[i];
+      src[i][iVR]   += 2.0*Om*v[iVPHI] + Om*Om*x1[i];
+      src[i][iVPHI] -= 2.0*Om*v[iVR];
+    }
+    #else
+    printLog ("! PrimSource(): rotating frame requires curvilinear coordinates\n");
+    QUIT_PLUTO(1);
+    #endif
+  }
+#endif
+
 /* --------------------------------------------------------
    2.  Add body forces. This includes:
        - Coriolis terms for the shearing box module
@@ -351,7 +421,11 @@ void PrimSource (const State *gas, double **src, int beg, int end, Grid *grid)
     #if BODY_FORCE & POTENTIAL
     phi_p[k] = BodyForcePotential(x1[i], x2[j], x3p[k]);
     #endif
+    #if GEOMETRY == SPHERICAL
+    hscale = x1[i]*sin(x2[j]);
+    #else
     hscale = 1.0;
+    #endif
     for (k = beg; k <= end; k++){
       #if BODY_FORCE & VECTOR
       v = gas->v[k];
@@ -493,3 +567,33 @@ void PrimSource (const State *gas, double **src, int beg, int end, Grid *grid)
 #endif
 
 }
+
+#if GEOMETRY == SPHERICAL
+/* ********************************************************************* */
+void PrimSourceCotangent (double *v, double *src, double r, double th)
+/*!
+ * Add the geometrical source terms proportional to 
+ * \f$ \cot\theta/r \f$ in spherical coordinates.
+ *
+ * \param [in]     v    array of primitive variables
+ * \param [in,out] src  array of source terms
+ * \param [in]     r    radial coordinate
+ * \param [in]     th   meridional coordinate
+ *********************************************************************** */
+{
+  double tau = 1.0/v[RHO];
+  double ct  = cos(th)/(sin(th)*r);   /* cot(theta)/r */
+
+  src[RHO]   -= v[RHO]*v[iVTH]*ct;
+  #if PHYSICS == HD
+  src[iVTH]  += v[iVPHI]*v[iVPHI]*ct;
+  src[iVPHI] -= v[iVTH]*v[iVPHI]*ct;
+  #elif PHYSICS == MHD
+  src[iVTH]  += (v[iVPHI]*v[iVPHI] - v[iBPHI]*v[iBPHI]*tau)*ct;
+  src[iVPHI] += (-v[iVTH]*v[iVPHI] + v[iBTH]*v[iBPHI]*tau)*ct;
+  src[iBR]   -= v[iBR]*v[iVTH]*ct;
+  src[iBTH]  -= v[iBTH]*v[iVTH]*ct;
+  src[iBPHI] -= v[iVPHI]*v[iBTH]*ct;
+  #endif
+}
+#endif
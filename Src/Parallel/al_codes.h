@@ -20,6 +20,9 @@
 /* Maximum number of supported arrays */
 #define AL_MAX_ARRAYS  ((int)100)
 
+/* Maximum file name length for I/O forwarding */
+#define AL_IO_FNAME_LEN  ((int)256)
+
 /* Stack indicator values for stack_ptr (in al_szptr_.c) */
 #define AL_STACK_FREE  ((int)0)
 #define AL_STACK_USED  ((int)1)
@@ -116,6 +116,8 @@ typedef struct szz{
   MPI_Offset io_offset;  /* Offset used to store file pointer */
   MPI_File ifp;          /* Pointer to the file this array is to be
                             written using MPI-IO */
+  int io_forward;        /* AL_TRUE if writes go to an I/O server */
+  char io_fname[AL_IO_FNAME_LEN]; /* Name of the forwarded file */
 } SZ;
 
 
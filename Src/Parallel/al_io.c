@@ -61,6 +61,7 @@ extern int stack_ptr[AL_MAX_ARRAYS];
                           MPI_INFO_NULL, &ifp);
 
   s->io_offset = 0;
+  s->io_forward = AL_FALSE;
   s->ifp = ifp;
 
   /* DIAGNOSTICS */
@@ -94,6 +95,11 @@ int AL_File_close(int sz_ptr)
   s = sz_stack[sz_ptr];
   myrank = s->rank;
 
+  if (s->io_forward == AL_TRUE){  /* Nothing was opened */
+    s->io_forward = AL_FALSE;
+    return (int) AL_SUCCESS;
+  }
+
   errcode =  MPI_File_close(&(s->ifp));
 
   /* DIAGNOSTICS */
@@ -154,31 +160,35 @@ int AL_Write_array(void *va, int sz_ptr, int istag)
     lsub_arr = s->lsubarr_stag[istag];
   }
 
-  MPI_Barrier(s->comm);
+  if (s->io_forward == AL_TRUE){
+    AL_Write_array_forward_(va, sz_ptr, gsub_arr, lsub_arr);
+  }else{
+    MPI_Barrier(s->comm);
+
+    errcode = MPI_File_set_view(ifp, offset, MPI_BYTE, gsub_arr,
+                      "native", MPI_INFO_NULL);
 
-  errcode = MPI_File_set_view(ifp, offset, MPI_BYTE, gsub_arr,
-                    "native", MPI_INFO_NULL);
- 
 #ifdef DEBUG
-    int myid, len;
-    char es[256];
-    MPI_Comm_rank(MPI_COMM_WORLD, &myid);
-    if( errcode ){
-      MPI_Error_string(errcode, es, &len);
-      printf("Errcode from MPI_File_set_view: %d | %s\n", errcode, es);
-    }
-    printf("myid %d, offset file_set_view %lld\n", myid,offset);
+      int myid, len;
+      char es[256];
+      MPI_Comm_rank(MPI_COMM_WORLD, &myid);
+      if( errcode ){
+        MPI_Error_string(errcode, es, &len);
+        printf("Errcode from MPI_File_set_view: %d | %s\n", errcode, es);
+      }
+      printf("myid %d, offset file_set_view %lld\n", myid,offset);
 #endif
 
-  errcode = MPI_File_write_all(ifp, a, 1, lsub_arr, &status);
+    errcode = MPI_File_write_all(ifp, a, 1, lsub_arr, &status);
 
 #ifdef DEBUG
-    if( errcode ){
-      MPI_Error_string(errcode, es, &len);
-      printf("Errcode from MPI_File_write_all: %d | %s\n", errcode, es);
-    }
+      if( errcode ){
+        MPI_Error_string(errcode, es, &len);
+        printf("Errcode from MPI_File_write_all: %d | %s\n", errcode, es);
+      }
 #endif
-    
+  }
+
   MPI_Type_size( s->type, &size);
 
   nelem = 1;
@@ -309,6 +319,11 @@ int AL_Write_header(void *vbuffer, int nelem, AL_Datatype type, int sz_ptr)
 
   ifp    = s->ifp;
   offset = s->io_offset;
+  if (s->io_forward == AL_TRUE){
+    AL_Write_header_forward_(buffer, nbytes, sz_ptr);
+    s->io_offset += nbytes;
+    return (int) AL_SUCCESS;
+  }
   MPI_Barrier(s->comm);
   MPI_File_set_view(ifp, offset, MPI_BYTE, MPI_CHAR,
                     "native", MPI_INFO_NULL);
@@ -0,0 +1,506 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief ArrayLib routines for I/O forwarding to dedicated server ranks.
+
+  When enabled with AL_Io_server_start(), a few additional MPI processes
+  per node are spawned from the running executable and act as I/O
+  servers.
+  Each compute rank is attached to one server (on the same node, when
+  the MPI library honours the \c map_by placement hint).
+  Files opened for writing with AL_File_open_forward() are then not
+  opened by the compute ranks: AL_Write_array() and AL_Write_header()
+  copy the local interior block into a message buffer and post it to the
+  server with a non-blocking send, together with the file name, offset
+  and the layout of the block in the file.
+  The compute ranks return immediately and the server performs the
+  actual (independent) MPI-IO write while computation proceeds.
+
+  Single precision output (.flt and .vtk scalars) is written with
+  AL_Write_array_convert(): the compute ranks send the double precision
+  block as it is, and the server scales it, converts it to single
+  precision and swaps bytes (for big endian VTK files) before writing,
+  so that the compute ranks do no work for any of the formats beyond
+  copying the block.
+
+  Send buffers are released as soon as the corresponding request has
+  completed; AL_Io_server_stop() waits for all pending requests, shuts
+  the servers down and must be called before AL_Finalize().
+
+  Spawned processes recognize themselves through their parent
+  communicator: AL_Io_server_run() must be called right after AL_Init()
+  and serves requests until all compute ranks have called
+  AL_Io_server_stop().
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include "al_hidden.h"  /*I "al_hidden.h" I*/
+#include <unistd.h>
+
+#define AL_IO_TAG_WRITE   ((int) 701)
+#define AL_IO_TAG_STOP    ((int) 702)
+
+/*
+   The SZ structure stack is defined and maintained
+   in al_szptr_.c
+   Here we include an external reference to it in
+   order to be able to make internal references to it.
+*/
+extern SZ *sz_stack[AL_MAX_ARRAYS];
+extern int stack_ptr[AL_MAX_ARRAYS];
+
+/* Header of each forwarded message, followed by the raw data */
+typedef struct AL_Io_msg_{
+  MPI_Offset offset;            /* File offset of the view   */
+  int  ndim;                    /* 0 for contiguous headers  */
+  int  elsize;                  /* Size of one element       */
+  int  convert;                 /* Data are doubles to be
+                                   written as floats         */
+  int  swap;                    /* Swap bytes after converting */
+  double scale;                 /* Factor applied before it  */
+  int  gdims[AL_MAX_DIM];       /* File subarray             */
+  int  ldims[AL_MAX_DIM];
+  int  starts[AL_MAX_DIM];
+  char fname[AL_IO_FNAME_LEN];
+} AL_Io_msg;
+
+static MPI_Comm io_comm = MPI_COMM_NULL; /* Intercommunicator to servers */
+static int io_server = -1;               /* Server serving this rank     */
+static int io_npending = 0, io_maxpending = 0;
+static MPI_Request *io_req = NULL;
+static char **io_buf = NULL;
+
+static int  AL_Io_forward_(void *, int, AL_Datatype, AL_Datatype,
+                           int, double, int);
+static int  AL_Io_send_(AL_Io_msg *, void *, size_t);
+static void AL_Io_test_(int);
+static int  AL_Subarray_get_(MPI_Datatype, int *, int *, int *, int *);
+
+/* ********************************************************************* */
+int AL_Io_server_start(char *command, int nper_node)
+/*!
+ * Spawn \c nper_node I/O servers on every node running the compute
+ * ranks and attach each compute rank to one of them.
+ * Collective over MPI_COMM_WORLD.
+ *
+ * \param [in] command    the executable to be spawned (argv[0])
+ * \param [in] nper_node  number of I/O server processes per node
+ *
+ * \return the total number of servers, or -1 on failure.
+ *********************************************************************** */
+{
+  int i, nnodes, node_id, node_rank, is_leader, nservers, err;
+  int *errcodes;
+  char info_str[64], cwd[1024];
+  MPI_Comm node_comm;
+  MPI_Info info;
+
+  if (nper_node <= 0) return 0;
+
+/* -- Count nodes and find the index of the node of this rank -- */
+
+  MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0,
+                      MPI_INFO_NULL, &node_comm);
+  MPI_Comm_rank(node_comm, &node_rank);
+  is_leader = (node_rank == 0);
+  MPI_Allreduce(&is_leader, &nnodes, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  node_id = 0;
+  MPI_Exscan(&is_leader, &node_id, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Bcast(&node_id, 1, MPI_INT, 0, node_comm);
+  MPI_Comm_free(&node_comm);
+
+/* -- Spawn nper_node servers per node in the current directory -- */
+
+  nservers = nnodes*nper_node;
+  errcodes = (int *) malloc(nservers*sizeof(int));
+
+  MPI_Info_create(&info);
+  sprintf (info_str, "ppr:%d:node", nper_node);
+  MPI_Info_set(info, "map_by", info_str);
+  if (getcwd(cwd, sizeof(cwd)) != NULL) MPI_Info_set(info, "wdir", cwd);
+
+  err = MPI_Comm_spawn(command, MPI_ARGV_NULL, nservers, info, 0,
+                       MPI_COMM_WORLD, &io_comm, errcodes);
+  MPI_Info_free(&info);
+
+  for (i = 0; i < nservers; i++) err = err || (errcodes[i] != MPI_SUCCESS);
+  free(errcodes);
+  if (err != MPI_SUCCESS) {
+    io_comm = MPI_COMM_NULL;
+    return -1;
+  }
+
+  io_server = node_id*nper_node + node_rank%nper_node;
+  return nservers;
+}
+
+/* ********************************************************************* */
+int AL_Io_server_stop()
+/*!
+ * Wait for all forwarded writes to complete and terminate the
+ * I/O servers. Collective over MPI_COMM_WORLD.
+ *********************************************************************** */
+{
+  int n, nservers;
+
+  if (io_comm == MPI_COMM_NULL) return (int) AL_SUCCESS;
+
+  AL_Io_test_(1);
+  MPI_Comm_remote_size(io_comm, &nservers);
+  for (n = 0; n < nservers; n++){
+    MPI_Send(NULL, 0, MPI_BYTE, n, AL_IO_TAG_STOP, io_comm);
+  }
+  MPI_Comm_disconnect(&io_comm);
+  io_comm = MPI_COMM_NULL;
+
+  free(io_req);
+  free(io_buf);
+  io_maxpending = 0;
+
+  return (int) AL_SUCCESS;
+}
+
+/* ********************************************************************* */
+int AL_Io_server_run()
+/*!
+ * Serve forwarded write requests if this process has been spawned by
+ * AL_Io_server_start().
+ *
+ * \return AL_FALSE if this is not an I/O server process, AL_TRUE once
+ *         all compute ranks have called AL_Io_server_stop().
+ *********************************************************************** */
+{
+  int nclients, nstop, nbytes, n;
+  char *buf, fname[AL_IO_FNAME_LEN] = "";
+  AL_Io_msg *msg;
+  MPI_Comm parent;
+  MPI_File fh = MPI_FILE_NULL;
+  MPI_Datatype etype, ftype;
+  MPI_Status status;
+
+  MPI_Comm_get_parent(&parent);
+  if (parent == MPI_COMM_NULL) return AL_FALSE;
+
+  MPI_Comm_remote_size(parent, &nclients);
+  nstop = 0;
+  while (nstop < nclients){
+
+  /* -- Close the file when idle, so that it can be read while running -- */
+
+    MPI_Iprobe(MPI_ANY_SOURCE, MPI_ANY_TAG, parent, &n, &status);
+    if (!n && fh != MPI_FILE_NULL){
+      MPI_File_close(&fh);
+      fname[0] = '\0';
+    }
+
+    MPI_Probe(MPI_ANY_SOURCE, MPI_ANY_TAG, parent, &status);
+    MPI_Get_count(&status, MPI_BYTE, &nbytes);
+    buf = (char *) malloc(nbytes > 0 ? nbytes:1);
+    MPI_Recv(buf, nbytes, MPI_BYTE, status.MPI_SOURCE, status.MPI_TAG,
+             parent, MPI_STATUS_IGNORE);
+
+    if (status.MPI_TAG == AL_IO_TAG_STOP){
+      nstop++;
+      free(buf);
+      continue;
+    }
+
+    msg = (AL_Io_msg *) buf;
+    if (strcmp(fname, msg->fname)){
+      if (fh != MPI_FILE_NULL) MPI_File_close(&fh);
+      if (MPI_File_open(MPI_COMM_SELF, msg->fname,
+                        MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                        MPI_INFO_NULL, &fh) != MPI_SUCCESS){
+        fprintf (stderr,"! AL_Io_server_run(): cannot open %s\n",msg->fname);
+        MPI_Abort(parent, 1);
+      }
+      strcpy (fname, msg->fname);
+    }
+
+    nbytes -= sizeof(AL_Io_msg);
+    if (msg->convert){   /* -- double to float, in place -- */
+      double *vd = (double *)(buf + sizeof(AL_Io_msg));
+      float  *vf = (float *) (buf + sizeof(AL_Io_msg));
+      float  q;
+      char   *c, tmp;
+
+      nbytes /= 2;
+      for (n = 0; n < nbytes/(int)sizeof(float); n++){
+        q = (float)(vd[n]*msg->scale);
+        if (msg->swap){
+          c = (char *) &q;
+          tmp = c[0]; c[0] = c[3]; c[3] = tmp;
+          tmp = c[1]; c[1] = c[2]; c[2] = tmp;
+        }
+        vf[n] = q;
+      }
+    }
+    if (msg->ndim == 0){
+      MPI_File_set_view(fh, msg->offset, MPI_BYTE, MPI_BYTE,
+                        "native", MPI_INFO_NULL);
+    }else{
+      MPI_Type_contiguous(msg->elsize, MPI_BYTE, &etype);
+      MPI_Type_create_subarray(msg->ndim, msg->gdims, msg->ldims, msg->starts,
+                               MPI_ORDER_FORTRAN, etype, &ftype);
+      MPI_Type_commit(&ftype);
+      MPI_File_set_view(fh, msg->offset, MPI_BYTE, ftype,
+                        "native", MPI_INFO_NULL);
+      MPI_Type_free(&ftype);
+      MPI_Type_free(&etype);
+    }
+    MPI_File_write(fh, buf + sizeof(AL_Io_msg), nbytes, MPI_BYTE,
+                   MPI_STATUS_IGNORE);
+    free(buf);
+  }
+
+  if (fh != MPI_FILE_NULL) MPI_File_close(&fh);
+  MPI_Comm_disconnect(&parent);
+  return AL_TRUE;
+}
+
+/* ********************************************************************* */
+int AL_File_open_forward(char *filename, int sz_ptr)
+/*!
+ * Open a file for writing through the I/O servers.
+ * If no server is running, fall back to AL_File_open().
+ *
+ * \param [in] filename    name of the file
+ * \param [in] sz_ptr      integer pointer to the distributed array descriptor
+ *********************************************************************** */
+{
+  SZ *s;
+
+  if (io_comm == MPI_COMM_NULL) return AL_File_open(filename, sz_ptr);
+
+  if (strlen(filename) >= AL_IO_FNAME_LEN){
+    printf("AL_File_open_forward: file name too long\n");
+    return (int) AL_FAILURE;
+  }
+
+  s = sz_stack[sz_ptr];
+  s->io_offset  = 0;
+  s->io_forward = AL_TRUE;
+  strcpy (s->io_fname, filename);
+
+  AL_Io_test_(0);
+  return (int) AL_SUCCESS;
+}
+
+/* ********************************************************************* */
+int AL_File_is_forward(int sz_ptr)
+/*!
+ * Return AL_TRUE if the file currently opened with the distributed
+ * array descriptor sz_ptr is written by the I/O servers.
+ *********************************************************************** */
+{
+  return sz_stack[sz_ptr]->io_forward;
+}
+
+/* ********************************************************************* */
+int AL_Write_array_forward_(void *va, int sz_ptr, AL_Datatype gsub_arr,
+                            AL_Datatype lsub_arr)
+/*!
+ * Copy the local block described by \c lsub_arr into a message buffer
+ * and post it to the I/O server.
+ * Called by AL_Write_array(), which also updates the file offset.
+ *********************************************************************** */
+{
+  return AL_Io_forward_(va, sz_ptr, gsub_arr, lsub_arr, 0, 1.0, 0);
+}
+
+/* ********************************************************************* */
+int AL_Write_array_convert(double *va, int sz_ptr, double scale, int swap)
+/*!
+ * Write a cell-centered double precision array through a single
+ * precision distributed array descriptor (e.g. SZ_float) opened with
+ * AL_File_open_forward().
+ * The block is sent in double precision; the I/O server multiplies it
+ * by \c scale, converts it to float and swaps bytes when
+ * \c swap == 1.
+ *
+ * \param [in] va      pointer to the double precision array
+ * \param [in] sz_ptr  integer pointer to the distributed array descriptor
+ * \param [in] scale   multiplicative factor (e.g. to c.g.s. units)
+ * \param [in] swap    swap the bytes of the single precision values
+ *
+ * \return AL_FAILURE if the file is not handled by an I/O server.
+ *********************************************************************** */
+{
+  int i, size;
+  long long nelem;
+  SZ *s;
+
+  s = sz_stack[sz_ptr];
+  if (s->io_forward != AL_TRUE) return (int) AL_FAILURE;
+
+  AL_Io_forward_(va, sz_ptr, s->gsubarr, s->lsubarr, 1, scale, swap);
+
+  MPI_Type_size(s->type, &size);
+  nelem = 1;
+  for (i = 0; i < s->ndim; i++) nelem *= (long long)(s->arrdim[i]);
+  s->io_offset += (long long)(size)*nelem;
+
+  return (int) AL_SUCCESS;
+}
+
+/* ********************************************************************* */
+int AL_Io_forward_(void *va, int sz_ptr, AL_Datatype gsub_arr,
+                   AL_Datatype lsub_arr, int convert, double scale, int swap)
+/*
+ * Pack the local block and post it to the I/O server. With
+ * convert == 1 the elements of va are doubles (twice the size of
+ * the file elements), converted by the server.
+ *********************************************************************** */
+{
+  int i, n, nrows, row, size, srcsize, ndim;
+  int lgdims[AL_MAX_DIM], lldims[AL_MAX_DIM], lstarts[AL_MAX_DIM], idx[AL_MAX_DIM];
+  size_t nbytes, src;
+  char *a = (char *) va, *buf, *dst;
+  AL_Io_msg msg;
+  SZ *s;
+
+  s = sz_stack[sz_ptr];
+  MPI_Type_size(s->type, &size);
+  srcsize = convert ? 2*size:size;
+
+  AL_Subarray_get_(gsub_arr, &ndim, msg.gdims, msg.ldims, msg.starts);
+  AL_Subarray_get_(lsub_arr, &ndim, lgdims, lldims, lstarts);
+
+  msg.offset  = s->io_offset;
+  msg.ndim    = ndim;
+  msg.elsize  = size;
+  msg.convert = convert;
+  msg.swap    = swap;
+  msg.scale   = scale;
+  strcpy (msg.fname, s->io_fname);
+
+/* -- Pack rows of the (Fortran-ordered) local subarray -- */
+
+  nrows = 1;
+  for (i = 1; i < ndim; i++) nrows *= lldims[i];
+  nbytes = (size_t)nrows*lldims[0]*srcsize;
+
+  buf = (char *) malloc(sizeof(AL_Io_msg) + nbytes);
+  dst = buf + sizeof(AL_Io_msg);
+
+  for (i = 0; i < ndim; i++) idx[i] = 0;
+  for (row = 0; row < nrows; row++){
+    src = 0;
+    for (n = ndim - 1; n >= 0; n--) src = src*lgdims[n] + lstarts[n] + idx[n];
+    memcpy (dst, a + src*srcsize, (size_t)lldims[0]*srcsize);
+    dst += (size_t)lldims[0]*srcsize;
+    for (n = 1; n < ndim; n++){
+      if (++idx[n] < lldims[n]) break;
+      idx[n] = 0;
+    }
+  }
+
+  return AL_Io_send_(&msg, buf, nbytes);
+}
+
+/* ********************************************************************* */
+int AL_Write_header_forward_(void *vbuffer, int nbytes, int sz_ptr)
+/*!
+ * Post a contiguous header to the I/O server (rank 0 only).
+ * Called by AL_Write_header(), which also updates the file offset.
+ *********************************************************************** */
+{
+  char *buf;
+  AL_Io_msg msg;
+  SZ *s;
+
+  s = sz_stack[sz_ptr];
+  if (s->rank != 0) return (int) AL_SUCCESS;
+
+  msg.offset  = s->io_offset;
+  msg.ndim    = 0;
+  msg.elsize  = 1;
+  msg.convert = 0;
+  strcpy (msg.fname, s->io_fname);
+
+  buf = (char *) malloc(sizeof(AL_Io_msg) + nbytes);
+  memcpy (buf + sizeof(AL_Io_msg), vbuffer, nbytes);
+  return AL_Io_send_(&msg, buf, nbytes);
+}
+
+/* ********************************************************************* */
+int AL_Io_send_(AL_Io_msg *msg, void *vbuf, size_t nbytes)
+/*
+ * Complete the message header in the first bytes of vbuf and post the
+ * non-blocking send. Ownership of vbuf passes to the pending list.
+ *********************************************************************** */
+{
+  char *buf = (char *) vbuf;
+
+  AL_Io_test_(0);
+
+  if (io_npending == io_maxpending){
+    io_maxpending += 64;
+    io_req = (MPI_Request *) realloc(io_req, io_maxpending*sizeof(MPI_Request));
+    io_buf = (char **) realloc(io_buf, io_maxpending*sizeof(char *));
+  }
+
+  memcpy (buf, msg, sizeof(AL_Io_msg));
+  MPI_Isend(buf, (int)(sizeof(AL_Io_msg) + nbytes), MPI_BYTE, io_server,
+            AL_IO_TAG_WRITE, io_comm, io_req + io_npending);
+  io_buf[io_npending] = buf;
+  io_npending++;
+
+  return (int) AL_SUCCESS;
+}
+
+/* ********************************************************************* */
+void AL_Io_test_(int wait)
+/*
+ * Release the buffers of completed sends (wait for all of them
+ * when wait == 1).
+ *********************************************************************** */
+{
+  int n, m, done;
+
+  m = 0;
+  for (n = 0; n < io_npending; n++){
+    if (wait) MPI_Wait(io_req + n, MPI_STATUS_IGNORE);
+    else      MPI_Test(io_req + n, &done, MPI_STATUS_IGNORE);
+    if (wait || done){
+      free(io_buf[n]);
+    }else{
+      io_req[m] = io_req[n];
+      io_buf[m] = io_buf[n];
+      m++;
+    }
+  }
+  io_npending = m;
+}
+
+/* ********************************************************************* */
+int AL_Subarray_get_(MPI_Datatype type, int *ndim, int *gdims,
+                     int *ldims, int *starts)
+/*
+ * Retrieve the parameters of a datatype created with
+ * MPI_Type_create_subarray().
+ *********************************************************************** */
+{
+  int n, ni, na, nd, combiner;
+  int ints[3*AL_MAX_DIM + 2];
+  MPI_Aint aints[1];
+  MPI_Datatype oldtype;
+
+  MPI_Type_get_envelope(type, &ni, &na, &nd, &combiner);
+  MPI_Type_get_contents(type, ni, 0, 1, ints, aints, &oldtype);
+
+  *ndim = ints[0];
+  for (n = 0; n < *ndim; n++){
+    gdims[n]  = ints[1 + n];
+    ldims[n]  = ints[1 + *ndim + n];
+    starts[n] = ints[1 + 2*(*ndim) + n];
+  }
+
+/* -- oldtype is a new handle unless it is a predefined type -- */
+
+  MPI_Type_get_envelope(oldtype, &ni, &na, &nd, &combiner);
+  if (combiner != MPI_COMBINER_NAMED) MPI_Type_free(&oldtype);
+  return (int) AL_SUCCESS;
+}
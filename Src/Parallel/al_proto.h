@@ -82,6 +82,13 @@ extern int AL_Read_array(void *, int, int);
 
 extern int AL_Write_array_begin(void *, int , int *, int *, int);
 extern int AL_Write_array_end(void *, int);
+
+extern int AL_Io_server_start(char *, int);
+extern int AL_Io_server_stop();
+extern int AL_Io_server_run();
+extern int AL_File_open_forward(char *, int);
+extern int AL_File_is_forward(int);
+extern int AL_Write_array_convert(double *, int, double, int);
 /*
 extern int AL_Write_array_begin(void *, int, int, int *, int);
 extern int AL_Write_array_end(void *, int); 
@@ -92,6 +99,8 @@ extern int AL_Allocate_sz_();
 extern int AL_Deallocate_sz_(int);
 extern int AL_Auto_Decomp_(int, int, int *, int *);
 extern int AL_Sort_(int, int *, int *);
+extern int AL_Write_array_forward_(void *, int, AL_Datatype, AL_Datatype);
+extern int AL_Write_header_forward_(void *, int, int);
 
 #ifdef __cplusplus
 }
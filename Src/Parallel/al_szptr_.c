@@ -92,6 +92,7 @@ int AL_Allocate_sz_()
     indicating the need for intialization.
   */
   sz_stack[sz_ptr]->compiled = AL_FALSE;
+  sz_stack[sz_ptr]->io_forward = AL_FALSE;
 
   return sz_ptr;
 
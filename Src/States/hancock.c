@@ -95,6 +95,11 @@ void HancockStep (const Sweep *sweep, int beg, int end, Grid *grid)
       d_dl[i] = 1.0/(grid->x[IDIR][g_i]*grid->dx[JDIR][i]);
     }
   }
+#elif GEOMETRY == SPHERICAL
+  {
+    double *inv_dl = GetInverse_dl(grid);
+    for (i = beg; i <= end; i++) d_dl[i] = inv_dl[i];
+  }
 #endif
 
 /* --------------------------------------------------------
@@ -30,6 +30,15 @@
 
 #define CHECK_MONOTONICITY       NO
 
+/*! When set to YES, States() (with <tt> CHAR_LIMITING == NO </tt>) 
+    computes slopes one variable at a time along the whole 1D sweep using
+    branch-free limiter expressions, so that the inner loops over zones
+    can be vectorized by the compiler.
+    Set it to NO to recover the original zone-by-zone implementation. */
+#ifndef PLM_VECTORIZE
+ #define PLM_VECTORIZE  YES
+#endif
+
 /* ********************************************************************* */
 /*! Simple structure used to retrieve 1D reconstruction weights 
     (c, w, d) used by piecewise linear interpolation (see sweeps_plm.c)
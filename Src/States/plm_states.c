@@ -78,6 +78,10 @@ static void MonotonicityTest(double **, double **, double **, int, int);
 #if LIMITER == FOURTH_ORDER_LIM
 static void FourthOrderLinear(const Sweep *, int, int, Grid *);
 #endif
+#if PLM_VECTORIZE == YES
+static void VectorLinear(const Sweep *, int, int, PLM_Coeffs *);
+static void VectorLimiter(int, double *, double *, PLM_Coeffs *, int, int);
+#endif
 
 /* ********************************************************************* */
 void States (const Sweep *sweep, int beg, int end, Grid *grid)
@@ -93,20 +97,27 @@ void States (const Sweep *sweep, int beg, int end, Grid *grid)
  *
  ************************************************************************ */
 {
-  int    nv, i;
-  const State *stateC = &(sweep->stateC);
   const State *stateL = &(sweep->stateL);
   const State *stateR = &(sweep->stateR);
-  double **v  = stateC->v;
   double **vp = stateL->v;
   double **vm = stateR->v-1;
   double **up = stateL->u;
   double **um = stateR->u-1;
 
+  PLM_Coeffs plm_coeffs;
+#if (PLM_VECTORIZE == NO) || (defined STAGGERED_MHD)
+  int    i;
+#endif
+#if (PLM_VECTORIZE == NO) || (CHECK_MONOTONICITY == YES) || (RECONSTRUCT_4VEL == YES)
+  const State *stateC = &(sweep->stateC);
+  double **v  = stateC->v;
+#endif
+#if PLM_VECTORIZE == NO
+  int    nv;
   double dv_lim[NVAR], dvp[NVAR], dvm[NVAR];
   double cp, cm, wp, wm, dp, dm;
-  PLM_Coeffs plm_coeffs;
   static double **dv;
+#endif
 
 #if (INTERNAL_BOUNDARY == YES) && (INTERNAL_BOUNDARY_REFLECT == YES)
   FluidInterfaceBoundary(sweep, beg, end, grid);
@@ -122,9 +133,11 @@ void States (const Sweep *sweep, int beg, int end, Grid *grid)
       coefficients and conversion to 4vel (if required)
    ----------------------------------------------------------- */
 
+#if PLM_VECTORIZE == NO
   if (dv == NULL) {
     dv = ARRAY_2D(NMAX_POINT, NVAR, double);
   }
+#endif
 
 #if UNIFORM_CARTESIAN_GRID == NO
   PLM_CoefficientsGet (&plm_coeffs, g_dir);
@@ -138,6 +151,10 @@ void States (const Sweep *sweep, int beg, int end, Grid *grid)
    1. Compute undivided differences
    ------------------------------------------- */
 
+#if PLM_VECTORIZE == YES
+  VectorLinear (sweep, beg, end, &plm_coeffs);
+#else
+
   for (i = beg-1; i <= end; i++){
     NVAR_LOOP(nv)  dv[i][nv] = v[i+1][nv] - v[i][nv];
   }
@@ -261,6 +278,7 @@ void States (const Sweep *sweep, int beg, int end, Grid *grid)
     VelocityLimiter (v[i], vp[i], vm[i]);
     #endif
   } /* -- end loop on zones -- */
+#endif /* PLM_VECTORIZE == NO */
 
 /* ----------------------------------------------
    3a. Check monotonicity
@@ -299,6 +317,8 @@ void States (const Sweep *sweep, int beg, int end, Grid *grid)
   CharTracingStep(sweep, beg, end, grid);
 #elif TIME_STEPPING == HANCOCK && PRIMITIVE_HANCOCK == YES
   HancockStep(sweep, beg, end, grid);  
+#elif TIME_STEPPING == MUSCL_HANCOCK
+  if (sweep->vh != NULL) MUSCLHancockStates(sweep, beg, end);
 #endif
 
 /* ----------------------------------------------
@@ -330,6 +350,270 @@ void States (const Sweep *sweep, int beg, int end, Grid *grid)
 
 }
 
+#if PLM_VECTORIZE == YES
+/* ********************************************************************* */
+void VectorLinear (const Sweep *sweep, int beg, int end, PLM_Coeffs *plm)
+/*!
+ * Compute (+) and (-) states using piecewise linear interpolation
+ * for all zones between beg and end.
+ * Same as steps 1-2 of States() but primitive variables are first
+ * copied into a structure-of-arrays buffer so that differences,
+ * limiters and states are computed one variable at a time along
+ * the whole 1D sweep.
+ * The shock-flattening fallbacks (FLAG_FLAT and FLAG_MINMOD) are
+ * applied as a masked blend rather than by skipping zones.
+ *
+ * \param [in] sweep pointer to a Sweep structure
+ * \param [in] beg   starting point where vp and vm must be computed
+ * \param [in] end   final    point where vp and vm must be computed
+ * \param [in] plm   pointer to the PLM_Coeffs structure (ignored on
+ *                   uniform Cartesian grids)
+ *
+ * \return This function has no return value.
+ *********************************************************************** */
+{
+  int    i, nv, lim;
+  double **v  = sweep->stateC.v;
+  double **vp = sweep->stateL.v;
+  double **vm = sweep->stateR.v-1;
+  double *q, *qp, *qm, *dp, *dm;
+  static double **vT, **vpT, **vmT;
+  static double *dq, *dl;
+#if SHOCK_FLATTENING == MULTID
+  uint16_t *flag = sweep->flag;
+  double *wp, *wm, dvp, dvm, dv_mm;
+#endif
+#if UNIFORM_CARTESIAN_GRID == YES
+  static double *c2, *w1, *d05;
+  PLM_Coeffs plm_unif;
+#endif
+
+  if (vT == NULL){
+    vT  = ARRAY_2D(NVAR, NMAX_POINT, double);
+    vpT = ARRAY_2D(NVAR, NMAX_POINT, double);
+    vmT = ARRAY_2D(NVAR, NMAX_POINT, double);
+    dq  = ARRAY_1D(NMAX_POINT, double);
+    dl  = ARRAY_1D(NMAX_POINT, double);
+    #if UNIFORM_CARTESIAN_GRID == YES
+    c2  = ARRAY_1D(NMAX_POINT, double);
+    w1  = ARRAY_1D(NMAX_POINT, double);
+    d05 = ARRAY_1D(NMAX_POINT, double);
+    for (i = 0; i < NMAX_POINT; i++){
+      c2[i]  = 2.0;
+      w1[i]  = 1.0;
+      d05[i] = 0.5;
+    }
+    #endif
+  }
+
+#if UNIFORM_CARTESIAN_GRID == YES
+  plm_unif.cp = plm_unif.cm = c2;
+  plm_unif.wp = plm_unif.wm = w1;
+  plm_unif.dp = plm_unif.dm = d05;
+  plm = &plm_unif;
+#endif
+  dp = plm->dp;
+  dm = plm->dm;
+#if SHOCK_FLATTENING == MULTID
+  wp = plm->wp;
+  wm = plm->wm;
+#endif
+
+/* -------------------------------------------
+   1. Gather primitive variables (AoS -> SoA)
+   ------------------------------------------- */
+
+  for (i = beg-1; i <= end+1; i++){
+    NVAR_LOOP(nv) vT[nv][i] = v[i][nv];
+  }
+
+/* -------------------------------------------
+   2. Loop on variables
+   ------------------------------------------- */
+
+  for (nv = 0; nv < NVAR; nv++){
+    q  = vT[nv];
+    qp = vpT[nv];
+    qm = vmT[nv];
+
+  /* -- 2a. Undivided differences -- */
+
+    for (i = beg-1; i <= end; i++) dq[i] = q[i+1] - q[i];
+
+  /* -- 2b. Limited slopes; limiter choice is done outside
+            the zone loop (see the DEFAULT setting in States()) -- */
+
+    #if LIMITER == DEFAULT
+    lim = VANLEER_LIM;
+    if (nv == RHO) lim = MC_LIM;
+    #if HAVE_ENERGY
+    if (nv == PRS) lim = MINMOD_LIM;
+    #endif
+    #ifdef GLM_MHD
+    if (nv == PSI_GLM) lim = MC_LIM;
+    #ifdef PHI_GLM
+    if (nv == PHI_GLM) lim = MC_LIM;
+    #endif
+    #endif
+    if (nv >= NFLX) lim = MC_LIM;
+    #else
+    lim = LIMITER;
+    #endif
+    VectorLimiter (lim, dq, dl, plm, beg, end);
+
+  /* -- 2c. Shock flattening: revert to minmod or to flat
+            reconstruction on flagged zones -- */
+
+    #if SHOCK_FLATTENING == MULTID
+    for (i = beg; i <= end; i++){
+      dvp = dq[i]*wp[i];
+      dvm = dq[i-1]*wm[i];
+      dv_mm = (dvp*dvm > 0.0 ? ABS_MIN(dvp, dvm):0.0);
+      dl[i] = (flag[i] & FLAG_MINMOD ? dv_mm:dl[i]);
+      dl[i] = (flag[i] & FLAG_FLAT   ? 0.0:dl[i]);
+    }
+    #endif
+
+  /* -- 2d. Construct (+) and (-) states -- */
+
+    for (i = beg; i <= end; i++){
+      qp[i] = q[i] + dl[i]*dp[i];
+      qm[i] = q[i] - dl[i]*dm[i];
+    }
+  }
+
+/* -------------------------------------------
+   3. Scatter states back (SoA -> AoS)
+   ------------------------------------------- */
+
+  for (i = beg; i <= end; i++){
+    NVAR_LOOP(nv) {
+      vp[i][nv] = vpT[nv][i];
+      vm[i][nv] = vmT[nv][i];
+    }
+    #if (PHYSICS == RHD) || (PHYSICS == RMHD) || (PHYSICS == ResRMHD) 
+    #if SHOCK_FLATTENING == MULTID
+    if (flag[i] & FLAG_FLAT) continue;
+    #endif
+    VelocityLimiter (v[i], vp[i], vm[i]);
+    #endif
+  }
+}
+
+/* ********************************************************************* */
+void VectorLimiter (int lim, double *dv, double *dv_lim, PLM_Coeffs *plm,
+                    int beg, int end)
+/*!
+ * Compute the limited slope dv_lim[i] for beg <= i <= end from the
+ * undivided differences dv[] of a single variable.
+ * Limiters are the same as the SET_XX_LIMITER macros in plm_coeffs.h
+ * but written in branch-free form: for rational limiters the product 
+ * dvp*dvm is set to zero (rather than skipping the zone) when 
+ * dvp*dvm <= 0 and the denominator is guarded against division by zero.
+ * This allows the compiler to if-convert and vectorize each loop.
+ *
+ * \param [in]  lim     the limiter (e.g. MC_LIM, VANLEER_LIM, ...)
+ * \param [in]  dv      1D array of undivided differences 
+ * \param [out] dv_lim  1D array of limited slopes
+ * \param [in]  plm     pointer to the PLM_Coeffs structure 
+ * \param [in]  beg     initial zone index
+ * \param [in]  end     final zone index
+ *********************************************************************** */
+{
+  int i;
+  double *cp = plm->cp, *cm = plm->cm;
+  double *wp = plm->wp, *wm = plm->wm;
+  double dvp, dvm, s, qc, scrh, den;
+
+  switch (lim){
+
+    case FLAT_LIM:
+      for (i = beg; i <= end; i++) dv_lim[i] = 0.0;
+      break;
+
+    case MINMOD_LIM:
+      for (i = beg; i <= end; i++){
+        dvp = dv[i]*wp[i]; dvm = dv[i-1]*wm[i];
+        s   = dvp*dvm;
+        dv_lim[i] = (s > 0.0 ? ABS_MIN(dvp, dvm):0.0);
+      }
+      break;
+
+    case VANALBADA_LIM:
+      for (i = beg; i <= end; i++){
+        dvp  = dv[i]*wp[i]; dvm = dv[i-1]*wm[i];
+        s    = dvp*dvm;
+        qc   = dvp*dvp; scrh = dvm*dvm;
+        den  = (dvp*(scrh + 1.e-18) + dvm*(qc + 1.e-18))/(qc + scrh + 1.e-18);
+        dv_lim[i] = (s > 0.0 ? den:0.0);
+      }
+      break;
+
+    case UMIST_LIM:
+      for (i = beg; i <= end; i++){
+        dvp  = dv[i]*wp[i]; dvm = dv[i-1]*wm[i];
+        s    = dvp*dvm;
+        scrh = 2.0*ABS_MIN(dvp, dvm);
+        scrh = ABS_MIN(scrh, 0.25*(dvp + 3.0*dvm));
+        scrh = ABS_MIN(scrh, 0.25*(dvm + 3.0*dvp));
+        dv_lim[i] = (s > 0.0 ? scrh:0.0);
+      }
+      break;
+
+    case OSPRE_LIM:
+      for (i = beg; i <= end; i++){
+        dvp = dv[i]*wp[i]; dvm = dv[i-1]*wm[i];
+        s   = dvp*dvm;
+        #if UNIFORM_CARTESIAN_GRID == YES
+        den = dvp*dvp + dvm*dvm + dvp*dvm;
+        den = (den > 0.0 ? den:1.0);
+        s   = (s > 0.0 ? s:0.0);
+        dv_lim[i] = 1.5*s*(dvm + dvp)/den;
+        #else
+        den = 2.0*dvp*dvp + 2.0*dvm*dvm + (cp[i] + cm[i] - 2.0)*dvp*dvm;
+        den = (den > 0.0 ? den:1.0);
+        s   = (s > 0.0 ? s:0.0);
+        dv_lim[i] = s*((1.0 + cp[i])*dvm + (1.0 + cm[i])*dvp)/den;
+        #endif
+      }
+      break;
+
+    case MC_LIM:
+      for (i = beg; i <= end; i++){
+        dvp  = dv[i]*wp[i]; dvm = dv[i-1]*wm[i];
+        s    = dvp*dvm;
+        qc   = 0.5*(dvm + dvp);
+        #if UNIFORM_CARTESIAN_GRID == YES
+        scrh = 2.0*ABS_MIN(dvp, dvm);
+        #else
+        scrh = ABS_MIN(dvp*cp[i], dvm*cm[i]);
+        #endif
+        scrh = ABS_MIN(qc, scrh);
+        dv_lim[i] = (s > 0.0 ? scrh:0.0);
+      }
+      break;
+
+    default:  /* VANLEER_LIM */
+      for (i = beg; i <= end; i++){
+        dvp = dv[i]*wp[i]; dvm = dv[i-1]*wm[i];
+        s   = dvp*dvm;
+        #if UNIFORM_CARTESIAN_GRID == YES
+        den = dvp + dvm;
+        den = (den != 0.0 ? den:1.0);
+        s   = (s > 0.0 ? s:0.0);
+        dv_lim[i] = 2.0*s/den;
+        #else
+        den = dvp*dvp + dvm*dvm + (cp[i] + cm[i] - 2.0)*dvp*dvm;
+        den = (den > 0.0 ? den:1.0);
+        s   = (s > 0.0 ? s:0.0);
+        dv_lim[i] = s*(cp[i]*dvm + cm[i]*dvp)/den;
+        #endif
+      }
+      break;
+  }
+}
+#endif /* PLM_VECTORIZE == YES */
+
 #if LIMITER == FOURTH_ORDER_LIM
 /* ********************************************************************** */
 void FourthOrderLinear(const Sweep *sweep, int beg, int end, Grid *grid)
@@ -703,6 +987,8 @@ void States (const Sweep *sweep, int beg, int end,  Grid *grid)
   CharTracingStep(sweep, beg, end, grid);
 #elif TIME_STEPPING == HANCOCK && PRIMITIVE_HANCOCK == YES
   HancockStep(sweep, beg, end, grid);
+#elif TIME_STEPPING == MUSCL_HANCOCK
+  if (sweep->vh != NULL) MUSCLHancockStates(sweep, beg, end);
 #endif
 
 /* --------------------------------------------------------
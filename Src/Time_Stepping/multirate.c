@@ -0,0 +1,337 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Radial multirate (local) time stepping for spherical shells.
+
+  On a spherical grid the stability limit of a zone depends on its
+  radius, so that with a single time step the outer shells are advanced
+  with a step much smaller than they allow.
+  When \c MULTIRATE_LEVELS is larger than 1 (set it in definitions.h),
+  the Euler step of length \c g_dt is instead taken as follows:
+
+  - every radial shell \c i is given a level \f$ l_i \f$, between 0 and
+    <tt> MULTIRATE_LEVELS-1 </tt>, and is advanced with
+    \f$ 2^{l_i} \f$ sub-steps of length \f$ \Delta t/2^{l_i} \f$.
+    The level is the smallest one for which the sub-step satisfies the
+    Courant condition of every zone of the shell (taken from the
+    previous step, or from a sweep with zero time step at the first
+    step of a run or after a restart); levels never increase outwards;
+  - all shells of a level share the same sub-steps and are advanced
+    together by UpdateStage(), restricted to their range of radial
+    indices. At each sub-step the fluxes are computed from the current
+    state of all shells, those of a coarser level being frozen at the
+    beginning of their own sub-step;
+  - the flux through the inner face of the first shell of a coarser
+    level is also computed at every sub-step of the finer level below
+    it. The difference between the time integral of these fluxes and
+    the one taken by the coarser shell is added back to it when its
+    sub-step ends (refluxing), so that the fluxes through level
+    interfaces cancel and the conserved quantities are kept to round-off
+    (see Tools/Check/check_conservation.sh).
+
+  The time step computed by NextTimeStep() is that of level 0, i.e.
+  \f$ 2^{\rm MULTIRATE\_LEVELS-1} \f$ times the one of the fastest zone.
+  With a fixed time step (\c CFL_max_var = 1) the levels still follow
+  the Courant condition, so that \c first_dt can be increased
+  accordingly.
+  The scheme is first order in time at level interfaces, as the Euler
+  integrator it is built on.
+
+  \b References
+     - "Multirate timestepping methods for hyperbolic conservation
+        laws", Constantinescu & Sandu, J. Sci. Comput. (2007) 33, 239.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include "pluto.h"
+
+#if MULTIRATE_LEVELS > 1
+
+#if TIME_STEPPING != EULER
+ #error MULTIRATE_LEVELS > 1 requires TIME_STEPPING == EULER
+#endif
+#if (GEOMETRY != SPHERICAL) || (DIMENSIONS == 1)
+ #error MULTIRATE_LEVELS > 1 requires a multi-dimensional spherical grid
+#endif
+#if (defined STAGGERED_MHD) || (defined FARGO) || PARTICLES || RADIATION \
+    || (PARABOLIC_FLUX != NO) || (defined GLM_MHD)
+ #error MULTIRATE_LEVELS > 1: not compatible with CT, FARGO, particles, \
+        radiation, diffusion or GLM
+#endif
+
+static void MultirateReflux (Data_Arr, double ***, int, Grid *);
+
+static double ***mr_reg;          /* Flux register being filled */
+static double    mr_w = 0.0;      /* Weight of the flux stored in mr_reg */
+static double   *mr_inv_dt;       /* Inverse time step of every (global)
+                                     shell */
+static int       mr_ioff;         /* Global shell index minus local one */
+
+/* ********************************************************************* */
+int MultirateAdvanceStep (Data *d, timeStep *Dts, Grid *grid)
+/*!
+ * Advance the equations by \c g_dt, taking a different number of
+ * Euler sub-steps in every group of radial shells.
+ *
+ * \param [in,out]      d  pointer to Data structure
+ * \param [in,out]    Dts  pointer to time step structure
+ * \param [in]       grid  pointer to array of Grid structures
+ *
+ * \return 0 on success, the error of ConsToPrim3D() otherwise.
+ *********************************************************************** */
+{
+  int    i, l, a, s, nsub, lmax, err = 0;
+  int    ibeg = IBEG, iend = IEND, nx = grid->np_int_glob[IDIR];
+  int    ib[MULTIRATE_LEVELS], ie[MULTIRATE_LEVELS];
+  int    left[MULTIRATE_LEVELS], upd[MULTIRATE_LEVELS];
+  long   iupd;
+  double t0 = g_time, invdt = 0.0, dt, q;
+  static int     *level;
+  static double ****reg;
+  RBox   box;
+
+/* --------------------------------------------------------
+   0. Allocate memory
+   -------------------------------------------------------- */
+
+  mr_ioff = grid->beg[IDIR] - grid->gbeg[IDIR] - IBEG;
+  if (level == NULL){
+    level     = ARRAY_1D(nx, int);
+    mr_inv_dt = ARRAY_1D(nx, double);
+    reg       = ARRAY_4D(MULTIRATE_LEVELS, NX3_TOT, NX2_TOT, NVAR+1, double);
+    for (i = 0; i < nx; i++) mr_inv_dt[i] = 0.0;
+    memset (reg[0][0][0], 0, MULTIRATE_LEVELS*NX3_TOT*NX2_TOT*(NVAR+1)*sizeof(double));
+
+  /* -- First step of the run, or after a restart (where g_dt
+        is already the step of the outer shells): take the
+        inverse time step of every shell from a sweep with
+        zero time step -- */
+
+    RBoxDefine (IBEG, IEND, JBEG, JEND, KBEG, KEND, CENTER, &box);
+    PrimToCons3D (d->Vc, d->Uc, &box);
+    g_intStage = 1;
+    Boundary (d, ALL_DIR, grid);
+    Dts->invDt_hyp = 0.0;
+    UpdateStage (d, d->Uc, d->Vs, NULL, 0.0, Dts, grid);
+    #ifdef PARALLEL
+    MPI_Allreduce (MPI_IN_PLACE, mr_inv_dt, nx, MPI_DOUBLE, MPI_MAX,
+                   MPI_COMM_WORLD);
+    #endif
+  }
+
+/* --------------------------------------------------------
+   1. Level of every shell from the inverse time step of
+      the previous step, then the range of local shells of
+      every level.
+   -------------------------------------------------------- */
+
+  for (i = nx-1; i >= 0; i--){
+    q = g_dt*mr_inv_dt[i]/Dts->cfl;
+    for (l = 0; l < MULTIRATE_LEVELS-1 && q > 1.0 + 1.e-9; l++) q *= 0.5;
+    if (i < nx-1) l = MAX(l, level[i+1]);
+    level[i] = l;
+  }
+  lmax = level[0];
+  nsub = 1 << lmax;
+
+  for (l = 0; l < MULTIRATE_LEVELS; l++){
+    ib[l] = iend + 1;
+    ie[l] = ibeg - 1;
+  }
+  for (i = ibeg; i <= iend; i++){
+    l = level[i + mr_ioff];
+    ib[l] = MIN(ib[l], i);
+    ie[l] = MAX(ie[l], i);
+  }
+  for (l = 0; l < MULTIRATE_LEVELS; l++){
+    i = ib[l] + mr_ioff - 1;
+    left[l] = (ib[l] <= ie[l] && i >= 0 ? level[i] : l);
+  }
+
+  if (g_stepNumber%RuntimeGet()->log_freq == 0){
+    print ("%s [multirate: shells per level =", IndentString());
+    for (l = 0; l <= lmax; l++){
+      for (a = 0, i = 0; i < nx; i++) a += (level[i] == l);
+      print (" %d", a);
+    }
+    print ("]\n");
+  }
+  for (i = 0; i < nx; i++) mr_inv_dt[i] = 0.0;
+
+/* --------------------------------------------------------
+   2. Sub-steps of the finest level
+   -------------------------------------------------------- */
+
+  RBoxDefine (IBEG, IEND, JBEG, JEND, KBEG, KEND, CENTER, &box);
+  #if RING_AVERAGE > 1
+  PrimToCons3D (d->Vc, d->Uc, &box);
+  RingAverageCons(d, grid);
+  ConsToPrim3D (d->Uc, d->Vc, d->flag, &box);
+  #endif
+  PrimToCons3D (d->Vc, d->Uc, &box);
+
+  for (s = 0; s < nsub; s++){
+    g_time     = t0 + s*g_dt/nsub;
+    g_intStage = 1;
+    Boundary (d, ALL_DIR, grid);
+    #if (SHOCK_FLATTENING == MULTID) || (ENTROPY_SWITCH)
+    FlagShock (d, grid);
+    #endif
+
+  /* -- 2a. Update active levels and store the fluxes of the
+            finer levels at their inner face -- */
+
+    for (l = lmax; l >= 0; l--){
+      upd[l] = 0;
+      if (ib[l] > ie[l]) continue;
+      a    = left[l];
+      iupd = ie[l];
+      if (s % (1 << (lmax - l)) == 0){
+        dt   = g_dt/(1 << l);
+        mr_w = (a > l ? g_dt/(1 << a) - dt : 0.0);
+        upd[l] = 1;
+      }else if (a > l && s % (1 << (lmax - a)) == 0){
+        dt   = 0.0;        /* Fluxes only, the shells are not advanced */
+        mr_w = g_dt/(1 << a);
+        iupd = ib[l];
+      }else continue;
+
+      mr_reg = reg[l];
+      IBEG = ib[l];
+      IEND = iupd;
+      Dts->invDt_hyp = 0.0;
+      UpdateStage (d, d->Uc, d->Vs, NULL, dt, Dts, grid);
+      invdt = MAX(invdt, Dts->invDt_hyp);
+      IBEG = ibeg;
+      IEND = iend;
+    }
+    mr_w = 0.0;
+
+    #if RING_AVERAGE > 1
+    RingAverageCons(d, grid);
+    #endif
+
+  /* -- 2b. Reflux the first shell of levels whose sub-step
+            ends, convert to primitive. A single conversion from
+            the first shell to the last updated one is done, since
+            ConsToPrim3D() is collective; shells left unchanged in
+            between are converted again to the same values -- */
+
+    iupd = IBEG;
+    for (l = lmax; l >= 0; l--){
+      if (ib[l] > ie[l]) continue;
+      if (upd[l]) iupd = MAX(iupd, ie[l]);
+      if (left[l] > l && (s+1) % (1 << (lmax - l)) == 0){
+        MultirateReflux (d->Uc, reg[l], ib[l], grid);
+        iupd = MAX(iupd, ib[l]);
+      }
+    }
+    RBoxDefine (IBEG, iupd, JBEG, JEND, KBEG, KEND, CENTER, &box);
+    err = MAX(err, ConsToPrim3D (d->Uc, d->Vc, d->flag, &box));
+  }
+
+/* --------------------------------------------------------
+   3. Restore time, share the inverse time step of every
+      shell for the next step
+   -------------------------------------------------------- */
+
+  g_time = t0;
+  Dts->invDt_hyp = invdt;
+  #ifdef PARALLEL
+  MPI_Allreduce (MPI_IN_PLACE, mr_inv_dt, nx, MPI_DOUBLE, MPI_MAX,
+                 MPI_COMM_WORLD);
+  #endif
+
+  #if FAILSAFE == YES
+  return err;
+  #else
+  return 0;
+  #endif
+}
+
+/* ********************************************************************* */
+void MultirateStoreFlux (const Sweep *sweep, int nbeg)
+/*!
+ * Add the flux through the inner face of the range being updated
+ * (<tt> nbeg-1/2 </tt>), times the current weight, to the flux
+ * register. Called by UpdateStage() during the x1 sweep, after
+ * RightHandSide() has added rotation terms to the fluxes.
+ *
+ * \param [in]  sweep   pointer to the Sweep structure
+ * \param [in]  nbeg    first zone of the x1 sweep
+ *********************************************************************** */
+{
+  int nv;
+  double *R = mr_reg[g_k][g_j];
+
+  if (mr_w == 0.0) return;
+  NVAR_LOOP(nv) R[nv] += mr_w*sweep->flux[nbeg-1][nv];
+  R[NVAR] += mr_w*sweep->press[nbeg-1];
+}
+
+/* ********************************************************************* */
+void MultirateStoreInvDt (double ***C_dt)
+/*!
+ * Keep the largest inverse time step of every shell being updated.
+ * Called by UpdateStage() at the first stage.
+ *
+ * \param [in]  C_dt   inverse time step of every zone (sum over
+ *                     directions)
+ *********************************************************************** */
+{
+  int i, j, k;
+  double q, ndim = (double)(INCLUDE_IDIR + INCLUDE_JDIR + INCLUDE_KDIR);
+
+  DOM_LOOP(k,j,i){
+    q = C_dt[k][j][i]/ndim;
+    if (q > mr_inv_dt[i + mr_ioff]) mr_inv_dt[i + mr_ioff] = q;
+  }
+}
+
+/* ********************************************************************* */
+void MultirateReflux (Data_Arr Uc, double ***R, int i, Grid *grid)
+/*!
+ * Add to the zones of shell \c i the contribution of the (time
+ * integrated) flux difference stored in \c R for its inner face, as
+ * done by RightHandSide() for the x1 direction, and reset \c R.
+ *
+ * \param [in,out]  Uc    array of conservative variables
+ * \param [in,out]  R     flux register (NVAR fluxes and pressure)
+ * \param [in]      i     radial index of the shell
+ * \param [in]      grid  pointer to Grid structure
+ *********************************************************************** */
+{
+  int    j, k, nv;
+  double du[NVAR], dV, A, w;
+  double r   = grid->x[IDIR][i];
+  double rm  = grid->xl[IDIR][i];
+  double dr  = grid->dx[IDIR][i];
+
+  KDOM_LOOP(k) JDOM_LOOP(j){
+    A  = grid->A[IDIR][k][j][i-1];
+    dV = grid->dV[k][j][i];
+    NVAR_LOOP(nv) du[nv] = R[k][j][nv]*A/dV;
+    du[MX1]   += R[k][j][NVAR]/dr;
+    du[iMPHI] *= fabs(rm)/fabs(r);
+    #if PHYSICS == MHD
+    du[iBTH]   = R[k][j][iBTH]*rm/(dr*r);
+    du[iBPHI]  = R[k][j][iBPHI]*rm/(dr*r);
+    #endif
+
+    #if ROTATING_FRAME == YES
+    w = g_OmegaZ*r*grid->s[j];
+    du[iMPHI] -= w*du[RHO];
+    IF_ENERGY(du[ENG] -= w*(du[iMPHI] + 0.5*w*du[RHO]);)
+    #endif
+
+    NVAR_LOOP(nv) {
+      Uc[k][j][i][nv] += du[nv];
+      R[k][j][nv] = 0.0;
+    }
+    R[k][j][NVAR] = 0.0;
+  }
+}
+
+#endif /* MULTIRATE_LEVELS > 1 */
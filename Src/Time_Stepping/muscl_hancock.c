@@ -0,0 +1,262 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Unsplit single-stage MUSCL-Hancock predictor.
+
+  Implement the predictor step of a dimensionally unsplit MUSCL-Hancock
+  scheme in primitive variables.
+  For each zone, the half time-step increment
+  \f[
+     \Delta V^{n+\HALF}_i = -\frac{\Delta t}{2}\sum_d\Big(
+                             \frac{A_d(V^n_i)\cdot\Delta_d V_i}{\Delta l_d}
+                             - S_{i,d}\Big)
+  \f]
+  is accumulated from all directions into \c d->dVh, where
+  \f$\Delta_d V_i\f$ are the limited slopes, \c A is the matrix of the
+  quasi-linear form (PrimRHS()) and \c S contains geometrical and body
+  force source terms (PrimSource()).
+  During the corrector (UpdateStage()), the increment is added to the
+  reconstructed interface values by MUSCLHancockStates() so that a
+  single Riemann problem per interface is solved between time-centered
+  states.
+  Unlike CTU, the predictor requires no Riemann solver and works in
+  spherical geometry.
+
+  Ghost zones are not evolved by the predictor: boundary conditions
+  are applied to the half-step solution at \f$t^n + \Delta t/2\f$ and
+  their increment is the change of the boundary values.
+  Next to a physical boundary the limited slope of a ghost zone depends
+  on the first zone of the domain, and changes in time even when the
+  boundary values do not: there the increment is the change of the
+  state on the face of the domain, reconstructed from the half-step
+  solution.
+
+  On a fixed grid the scheme is first order in the time step: the
+  predictor evolves the states with the quasi-linear derivative of the
+  limited slopes rather than with the semi-discrete operator of the
+  corrector, and their difference (which shrinks with the zone size)
+  gives an error proportional to \f$\Delta t\f$.
+  Halving the time step on the smooth case of Tools/Check/check_order.sh
+  halves the difference from an RK3 reference (RK2 divides it by 4):
+  \verbatim
+   Tools/Check/check_order.sh -order 1 "TIME_STEPPING=MUSCL_HANCOCK"
+  \endverbatim
+  Each step costs 30% less than with RK2.
+
+  \b References
+     - "A multidimensional upwind scheme for magnetohydrodynamics",
+        Falle, Komissarov & Joarder, MNRAS (1998) 297, 265.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include "pluto.h"
+
+#if TIME_STEPPING == MUSCL_HANCOCK
+
+#if RECONSTRUCTION != LINEAR
+ #error MUSCL_HANCOCK works with LINEAR reconstruction only
+#endif
+#if (PHYSICS != HD) && (PHYSICS != MHD)
+ #error MUSCL_HANCOCK works with HD or MHD only
+#endif
+#ifdef STAGGERED_MHD
+ #error MUSCL_HANCOCK does not support constrained transport
+#endif
+
+/* ********************************************************************* */
+void MUSCLHancockPredictor (Data *d, Grid *grid)
+/*!
+ * Compute the half time-step increment of primitive variables
+ * in the computational domain and in the ghost zones and store it
+ * into \c d->dVh.
+ * Ghost zones take the change of their boundary values or, next to
+ * a physical boundary, of their state on the face of the domain, so
+ * that the states at the domain boundary are time-centered as well.
+ *
+ * \param [in,out]  d     pointer to PLUTO Data structure
+ * \param [in]      grid  pointer to Grid structure
+ *********************************************************************** */
+{
+  int    i, j, k, nv, dir;
+  int    ntot, nbeg, nend, first = 1;
+  int    side, bnd, ig, ibeg, iend, pass;
+  int    *ip;
+  double dt_2 = 0.5*g_dt, t0 = g_time, scrh;
+  double dv[NVAR], Adv[NVAR], vface[2][NVAR];
+  double *vc, *vp, *vm, *dvh, *vf, *inv_dl;
+  static Sweep sweep;
+  static Data_Arr Vh;
+  Data_Arr Vn, V;
+  State *stateC = &(sweep.stateC);
+  State *stateL = &(sweep.stateL);
+  State *stateR = &(sweep.stateR);
+  RBox   box;
+
+  if (stateC->v == NULL) MakeState (&sweep);
+
+  for (dir = 0; dir < DIMENSIONS; dir++){
+
+    g_dir = dir;
+
+    #if !INCLUDE_JDIR
+    if (g_dir == JDIR) continue;
+    #endif
+
+    RBoxDefine (IBEG, IEND, JBEG, JEND, KBEG, KEND, CENTER, &box);
+    RBoxSetDirections (&box, g_dir);
+    SetVectorIndices (g_dir);
+    ResetState(d, &sweep, grid);
+
+    ntot = grid->np_tot[g_dir];
+    nbeg = *box.nbeg;
+    nend = *box.nend;
+    BOX_TRANSVERSE_LOOP(&box, k,j,i){
+
+      ip  = box.n;
+      g_i = i;  g_j = j;  g_k = k;
+      for ((*ip) = 0; (*ip) < ntot; (*ip)++) {
+        NVAR_LOOP(nv) stateC->v[*ip][nv] = d->Vc[nv][k][j][i];
+        sweep.flag[*ip] = d->flag[k][j][i];
+      }
+
+      States (&sweep, nbeg, nend, grid);
+      SoundSpeed2 (stateC, nbeg, nend, CELL_CENTER, grid);
+      PrimSource  (stateC, sweep.src, nbeg, nend, grid);
+      inv_dl = GetInverse_dl(grid);
+
+      for ((*ip) = nbeg; (*ip) <= nend; (*ip)++) {
+        vc  = stateC->v[*ip];
+        vp  = stateL->v[*ip];
+        vm  = stateR->v[(*ip)-1];
+        dvh = d->dVh[k][j][i];
+
+        NVAR_LOOP(nv) dv[nv] = vp[nv] - vm[nv];
+        PrimRHS (vc, dv, stateC->a2[*ip], stateC->h[*ip], Adv);
+        NVAR_LOOP(nv) {
+          scrh = dt_2*(inv_dl[*ip]*Adv[nv] - sweep.src[*ip][nv]);
+          dvh[nv] = (first ? -scrh:dvh[nv] - scrh);
+        }
+      }
+    }
+    first = 0;
+  }
+
+/* --------------------------------------------------------
+   Ghost zones: the increment is the change of their
+   boundary values between t and t + dt/2, computed by
+   applying boundary conditions to the half-step solution.
+   -------------------------------------------------------- */
+
+  if (Vh == NULL) Vh = ARRAY_4D(NVAR, NX3_TOT, NX2_TOT, NX1_TOT, Data_Type);
+  Vn = d->Vc;
+  NVAR_LOOP(nv) TOT_LOOP(k,j,i) Vh[nv][k][j][i] = Vn[nv][k][j][i];
+  DOM_LOOP(k,j,i) NVAR_LOOP(nv) Vh[nv][k][j][i] += d->dVh[k][j][i][nv];
+
+  d->Vc  = Vh;
+  g_time = t0 + dt_2;
+  Boundary (d, ALL_DIR, grid);
+  g_time = t0;
+  d->Vc  = Vn;
+
+  TOT_LOOP(k,j,i){
+    if (   i >= IBEG && i <= IEND && j >= JBEG && j <= JEND
+        && k >= KBEG && k <= KEND) continue;
+    NVAR_LOOP(nv) d->dVh[k][j][i][nv] = Vh[nv][k][j][i] - Vn[nv][k][j][i];
+  }
+
+/* --------------------------------------------------------
+   Ghost zones next to a physical boundary: the limited
+   slope of the ghost zone depends on the first zone of the
+   domain, which changes in time even when the boundary
+   values do not. Their increment is instead the change of
+   the state they give on the face of the domain, i.e. the
+   difference between the states reconstructed from the
+   half-step and from the initial solution.
+   -------------------------------------------------------- */
+
+  for (dir = 0; dir < DIMENSIONS; dir++){
+
+    g_dir = dir;
+
+    #if !INCLUDE_JDIR
+    if (g_dir == JDIR) continue;
+    #endif
+
+    RBoxDefine (IBEG, IEND, JBEG, JEND, KBEG, KEND, CENTER, &box);
+    RBoxSetDirections (&box, g_dir);
+    SetVectorIndices (g_dir);
+    ResetState(d, &sweep, grid);
+
+    ntot = grid->np_tot[g_dir];
+    nbeg = *box.nbeg;
+    nend = *box.nend;
+    for (side = 0; side < 2; side++){
+      bnd = (side == 0 ? grid->lbound[g_dir]:grid->rbound[g_dir]);
+      if (bnd == 0 || bnd == PERIODIC) continue;
+
+      ig   = (side == 0 ? nbeg - 1:nend + 1);
+      ibeg = (side == 0 ? 0:nend - 1);
+      iend = (side == 0 ? nbeg + 1:ntot - 1);
+      BOX_TRANSVERSE_LOOP(&box, k,j,i){
+
+        ip  = box.n;
+        g_i = i;  g_j = j;  g_k = k;
+        for (pass = 0; pass < 2; pass++){
+          V = (pass == 0 ? Vn:Vh);
+          for ((*ip) = ibeg; (*ip) <= iend; (*ip)++) {
+            NVAR_LOOP(nv) stateC->v[*ip][nv] = V[nv][k][j][i];
+            sweep.flag[*ip] = d->flag[k][j][i];
+          }
+          States (&sweep, ig, ig, grid);
+          vf = (side == 0 ? stateL->v[ig]:stateR->v[ig-1]);
+          NVAR_LOOP(nv) vface[pass][nv] = vf[nv];
+        }
+        *ip = ig;
+        NVAR_LOOP(nv) d->dVh[k][j][i][nv] = vface[1][nv] - vface[0][nv];
+      }
+    }
+  }
+}
+
+/* ********************************************************************* */
+void MUSCLHancockStates (const Sweep *sweep, int beg, int end)
+/*!
+ * Evolve L/R states and center value by dt/2 by adding the unsplit
+ * increment computed by MUSCLHancockPredictor().
+ * Zones where the evolved states would have negative density or
+ * pressure are not evolved (first order in time).
+ *
+ * \param [in,out] sweep  pointer to a Sweep structure
+ * \param [in]     beg    initial index of computation
+ * \param [in]     end    final   index of computation
+ *********************************************************************** */
+{
+  int    i, nv, ok;
+  const State *stateC = &(sweep->stateC);
+  const State *stateL = &(sweep->stateL);
+  const State *stateR = &(sweep->stateR);
+  double *vc, *vp, *vm, *vh;
+
+  for (i = beg; i <= end; i++) {
+    vc = stateC->v[i];
+    vp = stateL->v[i];
+    vm = stateR->v[i-1];
+    vh = sweep->vh[i];
+
+    ok = (vp[RHO] + vh[RHO] > 0.0) && (vm[RHO] + vh[RHO] > 0.0);
+    #if HAVE_ENERGY
+    ok = ok && (vp[PRS] + vh[PRS] > 0.0) && (vm[PRS] + vh[PRS] > 0.0);
+    #endif
+    if (!ok) continue;
+
+    NVAR_LOOP(nv) {
+      vp[nv] += vh[nv];
+      vm[nv] += vh[nv];
+      vc[nv] += vh[nv];
+    }
+  }
+}
+
+#endif /* TIME_STEPPING == MUSCL_HANCOCK */
@@ -7,6 +7,34 @@
   methods (RK3).
   Time stepping include Euler, RK2 and RK3.
 
+  When <tt> TIME_STEPPING == SSP_RK_LS </tt>, the equations are advanced
+  with a low-storage (2N) strong-stability-preserving Runge-Kutta method
+  written in Shu-Osher form,
+  \f[
+     U^{(s)} = a_s U^n + b_s U^{(s-1)} + c_s\Delta t R(U^{(s-1)})\,,
+  \f]
+  which only requires the solution array and one register (\c U0).
+  The linear combination is fused into the write-back of UpdateStage().
+  The number of stages and the order are set in definitions.h with
+  \c SSP_RK_LS_STAGES and \c SSP_RK_LS_ORDER:
+  - order 2, \c m >= 2 stages: SSPRK(m,2), SSP coefficient \c m-1;
+  - order 3, 3 stages: SSPRK(3,3), SSP coefficient 1;
+  - order 3, 4 stages: SSPRK(4,3), SSP coefficient 2.
+  
+  The CFL number may be increased up to the SSP coefficient.
+
+  When <tt> TIME_STEPPING == MUSCL_HANCOCK </tt>, the equations are
+  advanced with a single-stage, second-order unsplit MUSCL-Hancock
+  scheme: the primitive variables are first evolved by dt/2 using the
+  quasi-linear form of the equations (see muscl_hancock.c) and the
+  resulting time-centered interface states are used to solve one 
+  Riemann problem per interface.
+
+  \b References
+     - "Highly efficient strong stability preserving Runge-Kutta 
+        methods with low-storage implementations",
+        D.I. Ketcheson, SIAM J. Sci. Comput. (2008), 30, 2113.
+
   \authors A. Mignone (mignone@to.infn.it)\n
   \date    Nov 11, 2020
 */
@@ -23,6 +51,32 @@
  #define wc 0.25
 #endif
 
+#if TIME_STEPPING == SSP_RK_LS
+ #if SSP_RK_LS_ORDER == 2
+  #if SSP_RK_LS_STAGES < 2
+   #error SSP_RK_LS: second-order schemes require at least 2 stages
+  #endif
+ #elif SSP_RK_LS_ORDER == 3
+  #if (SSP_RK_LS_STAGES != 3) && (SSP_RK_LS_STAGES != 4)
+   #error SSP_RK_LS: third-order schemes require 3 or 4 stages
+  #endif
+ #else
+  #error SSP_RK_LS: only order 2 or 3 is supported
+ #endif
+ #if PARTICLES || RADIATION || (UPDATE_VECTOR_POTENTIAL == YES)
+  #error SSP_RK_LS: not compatible with particles, radiation or vector potential
+ #endif
+static int  AdvanceStepLowStorage (Data *, timeStep *, Grid *);
+static void SSP_LS_Coefficients (int, double *, double *, double *);
+#endif
+
+#if TIME_STEPPING == MUSCL_HANCOCK
+ #if PARTICLES || RADIATION || (UPDATE_VECTOR_POTENTIAL == YES)
+  #error MUSCL_HANCOCK: not compatible with particles, radiation or vector potential
+ #endif
+static int  AdvanceStepMUSCLHancock (Data *, timeStep *, Grid *);
+#endif
+
 //static void SolutionCorrect(Data *, timeStep *, Data_Arr, Data_Arr, double, Grid *);
 
 /* ********************************************************************* */
@@ -48,6 +102,16 @@ int AdvanceStep (Data *d, timeStep *Dts, Grid *grid)
   static Data_Arr Vhalf;
 #endif
 
+#if TIME_STEPPING == SSP_RK_LS
+  return AdvanceStepLowStorage (d, Dts, grid);
+#endif
+#if TIME_STEPPING == MUSCL_HANCOCK
+  return AdvanceStepMUSCLHancock (d, Dts, grid);
+#endif
+#if MULTIRATE_LEVELS > 1
+  return MultirateAdvanceStep (d, Dts, grid);
+#endif
+
   RBoxDefine (IBEG, IEND, JBEG, JEND, KBEG, KEND, CENTER, &box);
 
   #if RADIATION && RADIATION_IMEX_SSP2 && (TIME_STEPPING != RK2)
@@ -70,9 +134,13 @@ int AdvanceStep (Data *d, timeStep *Dts, Grid *grid)
    -------------------------------------------------------- */
 
   if (U0 == NULL){
-    U0 = ARRAY_4D(NX3_TOT, NX2_TOT, NX1_TOT, NVAR, double);
+    #if TIME_STEPPING != EULER  /* -- Euler does not need a copy -- */
+    U0 = ARRAY_4D(NX3_TOT, NX2_TOT, NX1_TOT, NVAR, Data_Type);
+    #else
+    U0 = d->Uc;
+    #endif
     #if PARTICLES
-    Vhalf = ARRAY_4D(NVAR, NX3_TOT, NX2_TOT, NX1_TOT, double);
+    Vhalf = ARRAY_4D(NVAR, NX3_TOT, NX2_TOT, NX1_TOT, Data_Type);
     #endif
 
     #ifdef STAGGERED_MHD
@@ -119,9 +187,11 @@ int AdvanceStep (Data *d, timeStep *Dts, Grid *grid)
 /* -- 1b. Convert primitive to conservative, save initial stage  -- */
 
   PrimToCons3D(d->Vc, d->Uc, &box);
+#if TIME_STEPPING != EULER
   RBoxCopy (&box, U0, d->Uc, NVAR, CONS_ARRAY);
-#ifdef STAGGERED_MHD
+  #ifdef STAGGERED_MHD
   DIM_LOOP(nv) TOT_LOOP(k,j,i) Bs0[nv][k][j][i] = d->Vs[nv][k][j][i];
+  #endif
 #endif
 
 /* -- 1c. Compute Particles feedback / Advance with pred. step -- */
@@ -152,6 +222,10 @@ int AdvanceStep (Data *d, timeStep *Dts, Grid *grid)
   RingAverageCons(d, grid);
   #endif
 
+  #if (defined FARGO) && (TIME_STEPPING == EULER)
+  FARGO_ShiftSolution (d->Uc, d->Vs, grid);  /* Single-stage orbital shift */
+  #endif
+
 #if RADIATION
   #if RADIATION_IMEX_SSP2
   AddRadSource1(d->Uc, Srad1, &box, dt_rk2);
@@ -330,6 +404,234 @@ int AdvanceStep (Data *d, timeStep *Dts, Grid *grid)
   return 0; /* -- step has been achieved, return success -- */
 }
 
+#if TIME_STEPPING == SSP_RK_LS
+/* ********************************************************************* */
+int AdvanceStepLowStorage (Data *d, timeStep *Dts, Grid *grid)
+/*!
+ * Advance the equations by a single time step using a low-storage
+ * SSP Runge-Kutta method with SSP_RK_LS_STAGES stages.
+ * Each stage is
+ *
+ *   U = a*U0 + b*U + c*dt*R(U)
+ *
+ * where the combination with U0 is performed by UpdateStage()
+ * (see UpdateStageWeights()).
+ *
+ * \param [in,out]      d  pointer to Data structure
+ * \param [in,out]    Dts  pointer to time step structure
+ * \param [in]       grid  pointer to array of Grid structures
+ *
+ * \return 0 on success, a positive number if the conversion to 
+ *         primitive variables failed (FAILSAFE only).
+ *********************************************************************** */
+{
+  int    s;
+#if FAILSAFE == YES
+  int    err;
+#endif
+  double a, b, c;
+  static Data_Arr U0;
+#ifdef STAGGERED_MHD
+  int    i, j, k, nv;
+  static double ***Bs0[3];
+#endif
+  RBox   box;
+
+  RBoxDefine (IBEG, IEND, JBEG, JEND, KBEG, KEND, CENTER, &box);
+
+/* --------------------------------------------------------
+   0. Allocate memory for the register
+   -------------------------------------------------------- */
+
+  if (U0 == NULL){
+    U0 = ARRAY_4D(NX3_TOT, NX2_TOT, NX1_TOT, NVAR, Data_Type);
+    #ifdef STAGGERED_MHD
+    DIM_EXPAND(
+      Bs0[IDIR] = ARRAY_3D(NX3_TOT, NX2_TOT, NX1_TOT, double);  ,
+      Bs0[JDIR] = ARRAY_3D(NX3_TOT, NX2_TOT, NX1_TOT, double);  ,
+      Bs0[KDIR] = ARRAY_3D(NX3_TOT, NX2_TOT, NX1_TOT, double);
+    )
+    #endif
+  }
+
+/* --------------------------------------------------------
+   1. Loop over stages
+   -------------------------------------------------------- */
+
+  for (s = 1; s <= SSP_RK_LS_STAGES; s++){
+
+    g_intStage = s;
+    SSP_LS_Coefficients (s, &a, &b, &c);
+
+  /* -- 1a. Set boundary conditions, save initial stage -- */
+
+    if (s == 1){
+      #if RING_AVERAGE > 1
+      PrimToCons3D (d->Vc, d->Uc, &box);
+      RingAverageCons(d, grid);
+      ConsToPrim3D (d->Uc, d->Vc, d->flag, &box);
+      #endif
+      Boundary (d, ALL_DIR, grid);
+      #if (SHOCK_FLATTENING == MULTID) || (ENTROPY_SWITCH) 
+      FlagShock (d, grid);
+      #endif
+      PrimToCons3D(d->Vc, d->Uc, &box);
+      RBoxCopy (&box, U0, d->Uc, NVAR, CONS_ARRAY);
+      #ifdef STAGGERED_MHD
+      DIM_LOOP(nv) TOT_LOOP(k,j,i) Bs0[nv][k][j][i] = d->Vs[nv][k][j][i];
+      #endif
+    }else{
+      Boundary (d, ALL_DIR, grid);
+    }
+
+  /* -- 1b. Combine staggered fields before the emf update -- */
+
+    #ifdef STAGGERED_MHD
+    if (a != 0.0 || b != 1.0){
+      DIM_LOOP(nv) TOT_LOOP(k,j,i) {
+        d->Vs[nv][k][j][i] = a*Bs0[nv][k][j][i] + b*d->Vs[nv][k][j][i];
+      }
+    }
+    #endif
+
+  /* -- 1c. Update stage: U = a*U0 + b*U + c*dt*R -- */
+
+    if (a != 0.0 || b != 1.0) UpdateStageWeights (U0, a, b);
+    UpdateStage(d, d->Uc, d->Vs, NULL, c*g_dt, Dts, grid);
+    UpdateStageWeights (NULL, 0.0, 1.0);
+
+    #if RING_AVERAGE > 1
+    RingAverageCons(d, grid);
+    #endif
+    #ifdef STAGGERED_MHD
+    CT_AverageStaggeredFields (d->Vs, d->Uc, &box, grid);
+    #endif
+
+  /* -- 1d. Apply FARGO orbital shift at the last stage -- */
+
+    #ifdef FARGO
+    if (s == SSP_RK_LS_STAGES) FARGO_ShiftSolution (d->Uc, d->Vs, grid);
+    #endif
+
+    #if FAILSAFE == YES
+    err = ConsToPrim3D (d->Uc, d->Vc, d->flag, &box);
+    if (err > 0) return err;
+    #else
+    ConsToPrim3D (d->Uc, d->Vc, d->flag, &box);
+    #endif
+  }
+
+  return 0;
+}
+
+/* ********************************************************************* */
+void SSP_LS_Coefficients (int s, double *a, double *b, double *c)
+/*!
+ * Return the Shu-Osher coefficients of stage s (starting at 1) 
+ * of the low-storage SSP Runge-Kutta method.
+ *
+ * \param [in]   s   the stage number
+ * \param [out]  a   weight of the solution at the beginning of the step
+ * \param [out]  b   weight of the solution at the previous stage
+ * \param [out]  c   weight of the right hand side
+ *********************************************************************** */
+{
+  int m = SSP_RK_LS_STAGES;
+
+  *a = 0.0;
+  *b = 1.0;
+
+#if SSP_RK_LS_ORDER == 2   /* -- SSPRK(m,2) -- */
+  *c = 1.0/(m - 1.0);
+  if (s == m){
+    *a = 1.0/m;
+    *b = (m - 1.0)/m;
+    *c = 1.0/m;
+  }
+#elif SSP_RK_LS_STAGES == 3  /* -- SSPRK(3,3) -- */
+  *c = 1.0;
+  if (s == 2){
+    *a = 0.75; *b = 0.25; *c = 0.25;
+  }else if (s == 3){
+    *a = 1.0/3.0; *b = 2.0/3.0; *c = 2.0/3.0;
+  }
+#else                      /* -- SSPRK(4,3) -- */
+  *c = 0.5;
+  if (s == 3){
+    *a = 2.0/3.0; *b = 1.0/3.0; *c = 1.0/6.0;
+  }
+#endif
+}
+#endif /* TIME_STEPPING == SSP_RK_LS */
+
+#if TIME_STEPPING == MUSCL_HANCOCK
+/* ********************************************************************* */
+int AdvanceStepMUSCLHancock (Data *d, timeStep *Dts, Grid *grid)
+/*!
+ * Advance the equations by a single time step using the unsplit
+ * MUSCL-Hancock scheme.
+ * The predictor computes the half time-step increment of primitive
+ * variables (MUSCLHancockPredictor()); the corrector is a single call
+ * to UpdateStage() which adds the increment to the reconstructed
+ * states before solving the Riemann problem.
+ *
+ * \param [in,out]      d  pointer to Data structure
+ * \param [in,out]    Dts  pointer to time step structure
+ * \param [in]       grid  pointer to array of Grid structures
+ *
+ * \return 0 on success, a positive number if the conversion to 
+ *         primitive variables failed (FAILSAFE only).
+ *********************************************************************** */
+{
+  int  err;
+  RBox box;
+
+  RBoxDefine (IBEG, IEND, JBEG, JEND, KBEG, KEND, CENTER, &box);
+
+/* --------------------------------------------------------
+   1. Set boundary conditions and flag shocked zones
+   -------------------------------------------------------- */
+
+  g_intStage = 1;
+  #if RING_AVERAGE > 1
+  PrimToCons3D (d->Vc, d->Uc, &box);
+  RingAverageCons(d, grid);
+  ConsToPrim3D (d->Uc, d->Vc, d->flag, &box);
+  #endif
+  Boundary (d, ALL_DIR, grid);
+  #if (SHOCK_FLATTENING == MULTID) || (ENTROPY_SWITCH) 
+  FlagShock (d, grid);
+  #endif
+  PrimToCons3D(d->Vc, d->Uc, &box);
+
+/* --------------------------------------------------------
+   2. Predictor: evolve primitive variables by dt/2
+   -------------------------------------------------------- */
+
+  MUSCLHancockPredictor (d, grid);
+
+/* --------------------------------------------------------
+   3. Corrector: U += dt*R(V^{n+1/2})
+   -------------------------------------------------------- */
+
+  UpdateStage(d, d->Uc, d->Vs, NULL, g_dt, Dts, grid);
+
+  #if RING_AVERAGE > 1
+  RingAverageCons(d, grid);
+  #endif
+  #ifdef FARGO
+  FARGO_ShiftSolution (d->Uc, d->Vs, grid);
+  #endif
+
+  err = ConsToPrim3D (d->Uc, d->Vc, d->flag, &box);
+  #if FAILSAFE == YES
+  if (err > 0) return err;
+  #endif
+
+  return 0;
+}
+#endif /* TIME_STEPPING == MUSCL_HANCOCK */
+
 //#if TIME_STEP_CONTROL == YES
 ///* ********************************************************************* */
 //void SolutionCorrect(Data *d, timeStep *Dts,
@@ -22,6 +22,20 @@
   When the integrator stage is the first one (predictor), this function 
   also computes the maximum of inverse time steps for hyperbolic and 
   parabolic terms (if the latters are included explicitly).
+
+  Multistage integrators written in Shu-Osher form may set, through
+  UpdateStageWeights(), a register \f$ U_0 \f$ and two weights 
+  \f$ a, b\f$ so that the zone-centered update becomes
+  \f[
+      U_c \quad\Longleftarrow \quad  a U_0 + b U_c + \Delta t R_c(V)
+  \f]
+  The linear combination is done during the write-back of the first 
+  sweep direction, thus avoiding an additional loop over the domain.
+
+  With \c MIXED_PRECISION the solution arrays are stored in single
+  precision: the primitive variables are widened to double when copied
+  into the sweep, and each pencil is updated in double and rounded once
+  when written back to \f$ U_c \f$.
   
   \authors A. Mignone (mignone@to.infn.it)\n
            C. Zanni   (zanni@oato.inaf.it)\n
@@ -31,8 +45,31 @@
 /* ///////////////////////////////////////////////////////////////////// */
 #include "pluto.h"
 
+static Data_Arr stage_U0 = NULL;  /* Register combined with Uc, if any */
+static double   stage_a  = 0.0;
+static double   stage_b  = 1.0;
+
+/* ********************************************************************* */
+void UpdateStageWeights(Data_Arr U0, double a, double b)
+/*!
+ * Set the register and weights used by the next call(s) to 
+ * UpdateStage(), which will then compute 
+ * <tt> Uc = a*U0 + b*Uc + dt*R </tt>.
+ * Call with <tt> U0 = NULL </tt> to restore the plain update
+ * <tt> Uc += dt*R </tt>.
+ *
+ * \param [in]  U0   array of conservative variables (the register)
+ * \param [in]  a    weight of U0
+ * \param [in]  b    weight of Uc
+ *********************************************************************** */
+{
+  stage_U0 = U0;
+  stage_a  = a;
+  stage_b  = b;
+}
+
 /* ********************************************************************* */
-void UpdateStage(Data *d, Data_Arr Uc, Data_Arr Us, double **aflux,
+void UpdateStage(Data *d, Data_Arr Uc, double ****Us, double **aflux,
                  double dt, timeStep *Dts, Grid *grid)
 /*!
  * 
@@ -50,7 +87,8 @@ void UpdateStage(Data *d, Data_Arr Uc, Data_Arr Us, double **aflux,
 {
   int  i, j, k;
   int  nv, dir, beg_dir, end_dir;
-  int ntot, nbeg, nend;
+  int ntot, nbeg, nend, ncbeg, ncend;
+  int  combine = (stage_U0 != NULL);
   int  *ip;
 
   static Sweep sweep;
@@ -73,6 +111,9 @@ void UpdateStage(Data *d, Data_Arr Uc, Data_Arr Us, double **aflux,
 
   if (stateC->v == NULL){
     MakeState (&sweep);    
+    #if TIME_STEPPING == MUSCL_HANCOCK
+    sweep.vh = ARRAY_2D(NMAX_POINT, NVAR, double);
+    #endif
     #if DIMENSIONS > 1
     C_dt = ARRAY_3D(NX3_MAX, NX2_MAX, NX1_MAX, double);
     #endif
@@ -80,8 +121,8 @@ void UpdateStage(Data *d, Data_Arr Uc, Data_Arr Us, double **aflux,
 
   #if DIMENSIONS > 1
   if (g_intStage == 1){
-    KTOT_LOOP(k) JTOT_LOOP(j){
-      memset ((void *)C_dt[k][j],'\0', NX1_TOT*sizeof(double));
+    KDOM_LOOP(k) JDOM_LOOP(j){
+      memset ((void *)(C_dt[k][j] + IBEG),'\0', (IEND-IBEG+1)*sizeof(double));
     }
   }
   #endif
@@ -150,17 +191,28 @@ void UpdateStage(Data *d, Data_Arr Uc, Data_Arr Us, double **aflux,
     ntot = grid->np_tot[g_dir];
     nbeg = *sweepBox.nbeg;
     nend = *sweepBox.nend;
+
+  /* -- Only the stencil of [nbeg,nend] needs to be copied (this
+        matters when the box is much smaller than the grid, as
+        in MarchSteadyState()) -- */
+
+    ncbeg = MAX(nbeg - grid->nghost[g_dir], 0);
+    ncend = MIN(nend + grid->nghost[g_dir], ntot - 1);
     BOX_TRANSVERSE_LOOP(&sweepBox, k,j,i){
 
     /* ----------------------------------------------------
-       2a. Copy data to 1D arrays
+       2a. Copy data to 1D arrays (with MIXED_PRECISION
+           this widens d->Vc to double)
        ---------------------------------------------------- */
 
       ip  = sweepBox.n;
       g_i = i;  g_j = j;  g_k = k;
-      for ((*ip) = 0; (*ip) < ntot; (*ip)++) {
+      for ((*ip) = ncbeg; (*ip) <= ncend; (*ip)++) {
         NVAR_LOOP(nv) stateC->v[*ip][nv] = d->Vc[nv][k][j][i];
         sweep.flag[*ip] = d->flag[k][j][i];
+        #if TIME_STEPPING == MUSCL_HANCOCK
+        NVAR_LOOP(nv) sweep.vh[*ip][nv] = d->dVh[k][j][i][nv];
+        #endif
         #ifdef STAGGERED_MHD
         sweep.Bn[*ip] = d->Vs[g_dir][k][j][i];
         #if (PHYSICS == ResRMHD) && (DIVE_CONTROL == CONSTRAINED_TRANSPORT)
@@ -199,7 +251,7 @@ void UpdateStage(Data *d, Data_Arr Uc, Data_Arr Us, double **aflux,
        2b. Compute L/R states 
        ---------------------------------------------------- */
       
-      CheckNaN (stateC->v, 0, ntot-1, "stateC->v");
+      CheckNaN (stateC->v, ncbeg, ncend, "stateC->v");
       States  (&sweep, nbeg - 1, nend + 1, grid);
 
       #if (RING_AVERAGE > 1) && (GEOMETRY == POLAR)
@@ -240,6 +292,9 @@ CheckNaN (stateR->v, nbeg, nend, "StateR->v");
        ---------------------------------------------------- */
 
       RightHandSide (&sweep, Dts, nbeg, nend, dt, grid);
+      #if MULTIRATE_LEVELS > 1
+      if (g_dir == IDIR) MultirateStoreFlux (&sweep, nbeg);
+      #endif
 
       #if FORCED_TURB == YES
       if (g_stepNumber%Ft->StirFreq == 0 ? 1:0){
@@ -251,10 +306,28 @@ CheckNaN (stateR->v, nbeg, nend, "StateR->v");
        2e. Update conservative solution array,
 
            U += dt*R
+
+           or, during the first sweep of a multistage
+           integrator (see UpdateStageWeights()),
+
+           U = a*U0 + b*U + dt*R
+
+           The right hand side of the pencil is in double and
+           the sum is formed in double, so that with
+           MIXED_PRECISION the new U is rounded only once.
        ---------------------------------------------------- */
 
-      for ((*ip) = nbeg; (*ip) <= nend; (*ip)++) { 
-        NVAR_LOOP(nv) Uc[k][j][i][nv] += sweep.rhs[*ip][nv];
+      if (combine){
+        for ((*ip) = nbeg; (*ip) <= nend; (*ip)++) { 
+          NVAR_LOOP(nv) {
+            Uc[k][j][i][nv] =   stage_a*stage_U0[k][j][i][nv] 
+                              + stage_b*Uc[k][j][i][nv] + sweep.rhs[*ip][nv];
+          }
+        }
+      }else{
+        for ((*ip) = nbeg; (*ip) <= nend; (*ip)++) { 
+          NVAR_LOOP(nv) Uc[k][j][i][nv] += sweep.rhs[*ip][nv];
+        }
       }
       #ifdef CHOMBO
       for ((*ip) = nbeg-1; (*ip) <= nend; (*ip)++){
@@ -291,6 +364,7 @@ CheckNaN (stateR->v, nbeg, nend, "StateR->v");
       }
       #endif
     }
+    combine = 0;  /* Linear combination is done once (first sweep) */
   }
 
 /* --------------------------------------------------------
@@ -360,6 +434,9 @@ CheckNaN (stateR->v, nbeg, nend, "StateR->v");
   if (g_intStage == 1){
     DOM_LOOP(k,j,i) Dts->invDt_hyp = MAX(Dts->invDt_hyp, C_dt[k][j][i]);
     Dts->invDt_hyp /= (double)(INCLUDE_IDIR + INCLUDE_JDIR + INCLUDE_KDIR);
+    #if MULTIRATE_LEVELS > 1
+    MultirateStoreInvDt (C_dt);
+    #endif
   }
 #endif
 }
@@ -0,0 +1,161 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Adaptive CFL number with rollback of failed steps.
+
+  The controller is enabled by the optional \c CFL_adapt line in the
+  <tt> [Time] </tt> section of pluto.ini:
+  \verbatim
+   CFL_adapt   0.4   0.95   0.2
+  \endverbatim
+  giving the smallest and the largest CFL number and the largest
+  relative change of ::g_maxMach between two steps for which the flow
+  is taken as quiet. \c CFL is the initial value.
+
+  AdaptCFLSave() keeps a copy of the solution before every step.
+  After the step, AdaptCFLCheck() counts the zones of all processes
+  where the conversion to primitive variables failed
+  (::FLAG_CONS2PRIM_FAIL, e.g. a negative pressure).
+  If there are any, the step is rolled back: the saved solution is
+  restored, the CFL number and ::g_dt are halved and the step is taken
+  again. A step failing with the smallest CFL number is kept, as it
+  would be without the controller.
+
+  Otherwise the CFL number of the next step is lowered by
+  ::ADAPT_CFL_DECREASE when the maximum Mach number changed by more
+  than the given fraction (e.g. a CME entering the domain) and is
+  raised by ::ADAPT_CFL_INCREASE, up to the largest value, after a
+  quiet step. The time step follows through NextTimeStep(), so
+  \c CFL_max_var must be larger than 1.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include "pluto.h"
+
+#ifndef ADAPT_CFL_INCREASE
+ #define ADAPT_CFL_INCREASE  1.02  /**< CFL growth after a quiet step */
+#endif
+
+#ifndef ADAPT_CFL_DECREASE
+ #define ADAPT_CFL_DECREASE  0.8   /**< CFL reduction after a fast change
+                                        of the Mach number */
+#endif
+
+static Data_Arr ac_Uc, ac_Vc;
+#ifdef STAGGERED_MHD
+static double ***ac_Vs[3];
+#endif
+
+/* ********************************************************************* */
+void AdaptCFLSave (const Data *d, Grid *grid)
+/*!
+ * Save the solution at the beginning of a step.
+ *
+ * \param [in] d     pointer to the PLUTO Data structure
+ * \param [in] grid  pointer to an array of Grid structures
+ *********************************************************************** */
+{
+  int i, j, k, nv;
+
+  if (ac_Uc == NULL){
+    ac_Uc = ARRAY_4D(NX3_TOT, NX2_TOT, NX1_TOT, NVAR, Data_Type);
+    ac_Vc = ARRAY_4D(NVAR, NX3_TOT, NX2_TOT, NX1_TOT, Data_Type);
+    #ifdef STAGGERED_MHD
+    DIM_EXPAND(
+      ac_Vs[IDIR] = ARRAY_3D(NX3_TOT, NX2_TOT, NX1_TOT, double);  ,
+      ac_Vs[JDIR] = ARRAY_3D(NX3_TOT, NX2_TOT, NX1_TOT, double);  ,
+      ac_Vs[KDIR] = ARRAY_3D(NX3_TOT, NX2_TOT, NX1_TOT, double);
+    )
+    #endif
+  }
+
+  TOT_LOOP(k,j,i) NVAR_LOOP(nv) ac_Uc[k][j][i][nv] = d->Uc[k][j][i][nv];
+  NVAR_LOOP(nv)   TOT_LOOP(k,j,i) ac_Vc[nv][k][j][i] = d->Vc[nv][k][j][i];
+  #ifdef STAGGERED_MHD
+  DIM_LOOP(nv) TOT_LOOP(k,j,i) ac_Vs[nv][k][j][i] = d->Vs[nv][k][j][i];
+  #endif
+}
+
+/* ********************************************************************* */
+int AdaptCFLCheck (Data *d, timeStep *Dts, Runtime *runtime, Grid *grid)
+/*!
+ * Check the step just taken and set the CFL number of the next one.
+ * Called by all processes after Integrate(), before ::g_time is
+ * advanced.
+ *
+ * \param [in,out] d        pointer to the PLUTO Data structure
+ * \param [in,out] Dts      pointer to the timeStep structure
+ * \param [in,out] runtime  pointer to a Runtime structure
+ * \param [in]     grid     pointer to an array of Grid structures
+ *
+ * \return 1 if the step has been rolled back and must be taken again
+ *         with the new ::g_dt, 0 otherwise.
+ *********************************************************************** */
+{
+  int    i, j, k, nv, nfail = 0;
+  double mach = g_maxMach, dmach;
+  double cfl0 = runtime->cfl;
+  static double mach_prev = -1.0;
+
+/* --------------------------------------------------------
+   1. Count failed zones and get the maximum Mach number
+      over all processes
+   -------------------------------------------------------- */
+
+  DOM_LOOP(k,j,i) if (d->flag[k][j][i] & FLAG_CONS2PRIM_FAIL) nfail++;
+
+#ifdef PARALLEL
+  {
+    int    nloc = nfail;
+    double mloc = mach;
+    MPI_Allreduce (&nloc, &nfail, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce (&mloc, &mach, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+  }
+#endif
+
+/* --------------------------------------------------------
+   2. Failed step: restore the solution and take the step
+      again with half the CFL number
+   -------------------------------------------------------- */
+
+  if (nfail > 0 && cfl0 > runtime->cfl_min){
+    runtime->cfl = MAX(0.5*cfl0, runtime->cfl_min);
+    Dts->cfl     = runtime->cfl;
+    g_dt        *= runtime->cfl/cfl0;
+    print ("! AdaptCFLCheck(): %d zone(s) failed at t = %12.6e, ", nfail, g_time);
+    print ("retrying with CFL = %f\n", runtime->cfl);
+
+    TOT_LOOP(k,j,i) NVAR_LOOP(nv)   d->Uc[k][j][i][nv] = ac_Uc[k][j][i][nv];
+    NVAR_LOOP(nv)   TOT_LOOP(k,j,i) d->Vc[nv][k][j][i] = ac_Vc[nv][k][j][i];
+    #ifdef STAGGERED_MHD
+    DIM_LOOP(nv) TOT_LOOP(k,j,i) d->Vs[nv][k][j][i] = ac_Vs[nv][k][j][i];
+    #endif
+    return 1;
+  }
+
+  if (nfail > 0){
+    print ("! AdaptCFLCheck(): %d zone(s) failed with the smallest CFL, ", nfail);
+    print ("step kept\n");
+  }
+
+/* --------------------------------------------------------
+   3. CFL number of the next step
+   -------------------------------------------------------- */
+
+  dmach     = (mach_prev > 0.0 ? fabs(mach - mach_prev)/mach_prev : 0.0);
+  mach_prev = mach;
+
+  if (nfail > 0 || dmach > runtime->cfl_mach_var){
+    runtime->cfl = MAX(ADAPT_CFL_DECREASE*cfl0, runtime->cfl_min);
+  }else{
+    runtime->cfl = MIN(ADAPT_CFL_INCREASE*cfl0, runtime->cfl_max);
+  }
+  Dts->cfl = runtime->cfl;
+
+  if (g_stepNumber%runtime->log_freq == 0) {
+    print ("%s [CFL              = %f]\n", IndentString(), runtime->cfl);
+  }
+  return 0;
+}
@@ -24,6 +24,23 @@
 
   The functions ArrayMap() can be used to convert a one-dimensional
   array into a 3D array.
+
+  Data blocks (not pointer tables) are obtained from AlignedMalloc() 
+  which returns storage aligned to ::ARRAY_ALIGNMENT bytes and, 
+  optionally:
+  - backs large blocks with transparent huge pages 
+    (<tt> ARRAYS_HUGE_PAGES == YES </tt>);
+  - touches every page right after allocation so that memory is placed 
+    on the NUMA node of the allocating process
+    (<tt> ARRAYS_FIRST_TOUCH == YES </tt>);
+  - pads the fastest index of 2D arrays to a multiple of 
+    ::ARRAY_ALIGNMENT bytes (<tt> ARRAYS_PAD_ROWS == YES </tt>).
+    This breaks contiguity between rows and should be enabled only
+    when no part of the code accesses a 2D array as a flat 1D buffer.
+
+  Allocated memory is also accounted per subsystem (the source 
+  directory of the caller, as recorded by the ARRAY_XD macros) and 
+  can be printed with ArrayMemoryReport().
   
   \author A. Mignone (mignone@to.infn.it)
   \date   June 24, 2019
@@ -35,6 +52,34 @@
 
 #define ARRAYS_DEBUG  NO
 
+#define ARRAY_ALIGNMENT  64  /* Alignment (in bytes) of data blocks */
+#define HUGE_PAGE_SIZE   (2*1024*1024)
+
+#ifndef ARRAYS_HUGE_PAGES
+  #define ARRAYS_HUGE_PAGES  NO  /* Use 2 MB pages for large blocks */
+#endif
+
+#ifndef ARRAYS_FIRST_TOUCH
+  #define ARRAYS_FIRST_TOUCH YES /* Touch pages from the owning process */
+#endif
+
+#ifndef ARRAYS_PAD_ROWS
+  #define ARRAYS_PAD_ROWS    NO  /* Pad rows of 2D arrays */
+#endif
+
+#if ARRAYS_HUGE_PAGES == YES
+  #include <sys/mman.h>
+#endif
+
+#define NMAX_MEMORY_TAGS  32
+static struct {
+  char name[32];
+  long int nbytes;
+  int  ncalls;
+} mem_tag[NMAX_MEMORY_TAGS];
+static int  mem_ntags = 0;
+static const char *mem_source = NULL;
+
 #define NMAX_ARRAYS    2048
 static char *p1_list[NMAX_ARRAYS];
 static char **p2_list[NMAX_ARRAYS];
@@ -49,6 +94,115 @@ static int p4_count=0;
 static int pb_count=0;
 static int pb_nrl[NMAX_ARRAYS], pb_ncl[NMAX_ARRAYS], pb_ndl[NMAX_ARRAYS];
 
+/* ********************************************************************* */
+void ArraySetSource (const char *fname)
+/*!
+ * Set the name of the source file requesting the next allocation.
+ * Called by the ARRAY_XD macros (see prototypes.h) with \c __FILE__.
+ *
+ * \param [in] fname   the source file name
+ *********************************************************************** */
+{
+  mem_source = fname;
+}
+
+/* ********************************************************************* */
+static void ArrayAccount (size_t nbytes)
+/*!
+ * Add nbytes to the subsystem of the current caller.
+ * The subsystem is the directory following "Src/" in the source file 
+ * name (e.g. "States", "Parallel"), "Src" for files in the main source
+ * directory or "User" for files outside of it.
+ *********************************************************************** */
+{
+  int  n, len;
+  char name[32];
+  const char *s, *e;
+
+  g_usedMemory += nbytes;
+
+  s = (mem_source == NULL ? NULL:strstr(mem_source, "Src/"));
+  if (s == NULL) {
+    sprintf (name, "User");
+  }else{
+    s += 4;
+    e  = strchr(s, '/');
+    if (e == NULL) sprintf (name, "Src");
+    else {
+      len = MIN((int)(e - s), 31);
+      strncpy (name, s, len);
+      name[len] = '\0';
+    }
+  }
+  mem_source = NULL;
+
+  for (n = 0; n < mem_ntags; n++){
+    if (strcmp(mem_tag[n].name, name) == 0) break;
+  }
+  if (n == mem_ntags){
+    if (mem_ntags == NMAX_MEMORY_TAGS) n--;  /* Merge into last tag */
+    else {
+      strcpy (mem_tag[n].name, name);
+      mem_ntags++;
+    }
+  }
+  mem_tag[n].nbytes += nbytes;
+  mem_tag[n].ncalls++;
+}
+
+/* ********************************************************************* */
+void ArrayMemoryReport (void)
+/*!
+ * Print the amount of memory allocated by each subsystem
+ * on the current processor.
+ *********************************************************************** */
+{
+  int n;
+
+  print ("> Allocated memory by subsystem (proc #%d):\n",prank);
+  for (n = 0; n < mem_ntags; n++){
+    print ("  %-16s %10.2f Mb  (%d calls)\n", mem_tag[n].name,
+            (double)mem_tag[n].nbytes/1.e6, mem_tag[n].ncalls);
+  }
+}
+
+/* ********************************************************************* */
+static void *AlignedMalloc (size_t nbytes)
+/*!
+ * Allocate a block of nbytes aligned to ARRAY_ALIGNMENT bytes.
+ * The size is rounded up to a multiple of the alignment.
+ * Blocks larger than HUGE_PAGE_SIZE are aligned to a huge page
+ * boundary and advised for transparent huge pages when 
+ * ARRAYS_HUGE_PAGES is enabled.
+ *
+ * \param [in] nbytes  size of the block in bytes
+ *
+ * \return A pointer to the allocated memory or NULL on failure.
+ *********************************************************************** */
+{
+  size_t align = ARRAY_ALIGNMENT;
+  void  *p;
+
+  #if ARRAYS_HUGE_PAGES == YES
+  if (nbytes >= HUGE_PAGE_SIZE) align = HUGE_PAGE_SIZE;
+  #endif
+  nbytes = (nbytes + align - 1)/align*align;
+  if (nbytes == 0) nbytes = align;
+
+  if (posix_memalign (&p, align, nbytes) != 0) return NULL;
+
+  #if (ARRAYS_HUGE_PAGES == YES) && defined(MADV_HUGEPAGE)
+  if (align == HUGE_PAGE_SIZE) madvise (p, nbytes, MADV_HUGEPAGE);
+  #endif
+
+  #if ARRAYS_FIRST_TOUCH == YES
+  memset (p, 0, nbytes);
+  #endif
+
+  ArrayAccount (nbytes);
+  return p;
+}
+
 /* ********************************************************************* */
 char *Array1D (int nx, size_t dsize)
 /*! 
@@ -62,9 +216,8 @@ char *Array1D (int nx, size_t dsize)
  *********************************************************************** */
 {
   char *v;
-  v = (char *) malloc (nx*dsize);
+  v = (char *) AlignedMalloc ((size_t) nx*dsize);
   PlutoError (!v, "Allocation failure in Array1D");
-  g_usedMemory += nx*dsize;
 
   #if ARRAYS_DEBUG
   p1_list[p1_count++] = v;
@@ -109,16 +262,20 @@ char **Array2D (int nx, int ny, size_t dsize)
  *********************************************************************** */
 {
   int i;
+  size_t stride = ny*dsize;  /* Row size in bytes */
   char **m;
- 
+
+  #if ARRAYS_PAD_ROWS == YES
+  stride = (stride + ARRAY_ALIGNMENT - 1)/ARRAY_ALIGNMENT*ARRAY_ALIGNMENT;
+  #endif
   m    = (char **)malloc ((size_t) nx*sizeof(char *));
   PlutoError (!m, "Allocation failure in Array2D (1)");
-  m[0] = (char *) malloc ((size_t) nx*ny*dsize);
+  m[0] = (char *) AlignedMalloc ((size_t) nx*stride);
   PlutoError (!m[0],"Allocation failure in Array2D (2)");
  
-  for (i = 1; i < nx; i++) m[i] = m[(i - 1)] + ny*dsize;
+  for (i = 1; i < nx; i++) m[i] = m[(i - 1)] + stride;
  
-  g_usedMemory += nx*ny*dsize + nx*sizeof(char *);
+  g_usedMemory += nx*sizeof(char *);
   
   #if ARRAYS_DEBUG
   p2_list[p2_count++] = m;
@@ -177,7 +334,7 @@ char ***Array3D (int nx, int ny, int nz, size_t dsize)
   m[0] = (char **) malloc ((size_t) nx*ny*sizeof(char *));
   PlutoError (!m[0],"Allocation failure in Array3D (2)");
 
-  m[0][0] = (char *) malloc ((size_t) nx*ny*nz*dsize);
+  m[0][0] = (char *) AlignedMalloc ((size_t) nx*ny*nz*dsize);
   PlutoError (!m[0][0],"Allocation failure in Array3D (3)");
 
 /* ---------------------------
@@ -209,8 +366,6 @@ char ***Array3D (int nx, int ny, int nz, size_t dsize)
     }
   }}
   
-  g_usedMemory += nx*ny*nz*dsize;
-  
   #if ARRAYS_DEBUG
   p3_list[p3_count++] = m;
   printLog ("> Array3D(): called %d times, [nx, ny, nz] = [%d, %d, %d]\n",
@@ -275,7 +430,7 @@ char ****Array4D (int nx, int ny, int nz, int nv, size_t dsize)
   m[0][0] = (char **) malloc ((size_t) nx*ny*nz*sizeof (char *));
   PlutoError (!m[0][0], "Allocation failure in Array4D (3)");
 
-  m[0][0][0] = (char *) malloc ((size_t) nx*ny*nz*nv*dsize);
+  m[0][0][0] = (char *) AlignedMalloc ((size_t) nx*ny*nz*nv*dsize);
   PlutoError (!m[0][0][0], "Allocation failure in Array4D (4)");
 
 /* ---------------------------
@@ -346,7 +501,6 @@ char ****Array4D (int nx, int ny, int nz, int nv, size_t dsize)
     }
   }
       
-  g_usedMemory += nx*ny*nz*nv*dsize;
   #if ARRAYS_DEBUG
   p4_list[p4_count++] = m;
   printLog ("> Array4D(): called %d times, [nx, ny, nz, nv] = [%d, %d, %d, %d]\n",
@@ -432,7 +586,7 @@ char ***ArrayBox(long int nrl, long int nrh,
 
 /* allocate rows and set pointers to them */
 
-  t[nrl][ncl] = (char *) malloc((size_t) nrow*ncol*ndep*dsize);
+  t[nrl][ncl] = (char *) AlignedMalloc((size_t) nrow*ncol*ndep*dsize);
   if (!t[nrl][ncl]) {
     printLog ("! ArrayBox: allocation failure (3)\n");
     QUIT_PLUTO(1);
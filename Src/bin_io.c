@@ -10,6 +10,10 @@
   
   In parallel mode these functions work as wrappers to the actual
   parallel implementations contained in AL_io.c.
+  Files opened for writing are handed to the I/O servers, when
+  these are enabled with the \c -ioranks command line option
+  (see al_io_server.c); single precision data written with
+  FileWriteFloat() are then also converted by the servers.
  
   Pointer to data array must be cast into (void *) and are assumed to
   start with index 0 for both cell-centered and staggered data arrays.
@@ -126,7 +130,8 @@ print ("Deleting file...\n");
     MPI_File_close(&fh);
   }  
 */      
-  AL_File_open(filename, sz); 
+  if (strcmp(mode,"w") == 0) AL_File_open_forward(filename, sz);
+  else                      AL_File_open(filename, sz);
   return NULL;
 #else
   if      (strcmp(mode,"w") == 0) fp = fopen(filename, "wb");
@@ -259,6 +264,35 @@ void FileWriteData (void *V, size_t dsize, int sz, FILE *fl, int istag)
 }
 
 
+/* ********************************************************************* */
+void FileWriteFloat (double ***Vdbl, double unit, int swap_endian, int sz,
+                     FILE *fl)
+/*!
+ * Write a cell-centered double precision 3D array in single precision.
+ * When the file is written by an I/O server the array is sent as it
+ * is and the conversion is done by the server; otherwise the array is
+ * converted with Convert_dbl2flt() and written by FileWriteData().
+ *
+ * \param [in] Vdbl         pointer to a 3D double precision array
+ * \param [in] unit         a multiplicative constant (e.g. c.g.s. units)
+ * \param [in] swap_endian  when set to 1, swap endianity
+ * \param [in] sz           the single precision distributed array
+ *                          descriptor (SZ_float)
+ * \param [in] fl           a valid FILE pointer (serial mode only)
+ *********************************************************************** */
+{
+  float ***Vflt;
+
+#ifdef PARALLEL
+  if (AL_File_is_forward(sz) == AL_TRUE){
+    AL_Write_array_convert (Vdbl[0][0], sz, unit, swap_endian);
+    return;
+  }
+#endif
+  Vflt = Convert_dbl2flt(Vdbl, unit, swap_endian);
+  FileWriteData ((void *)Vflt[0][0], sizeof(float), sz, fl, -1);
+}
+
 /* ********************************************************************* */
 int FileDelete (char *fname)
 /*!
@@ -112,7 +112,11 @@ void Boundary (const Data *d, int idim, Grid *grid)
    
 #ifdef PARALLEL
   MPI_Barrier (MPI_COMM_WORLD);
+  #if MIXED_PRECISION == YES
+  NVAR_LOOP(nv) AL_Exchange_dim ((char *)d->Vc[nv][0][0], par_dim, SZ_float);
+  #else
   NVAR_LOOP(nv) AL_Exchange_dim ((char *)d->Vc[nv][0][0], par_dim, SZ);
+  #endif
   #ifdef STAGGERED_MHD 
   DIM_EXPAND(
     AL_Exchange_dim ((char *)(d->Vs[BX1s][0][0] - 1), par_dim, SZ_stagx);  ,
@@ -345,14 +349,16 @@ void Boundary (const Data *d, int idim, Grid *grid)
         printLog ("! Boundary(): polaraxis can only be assigned at an X2 boundary\n");
         QUIT_PLUTO(1);
       }
-      if (grid->nproc[KDIR] != 1){
-        printLog ("! Boundary(): polaraxis b.c. does not allow ");
-        printLog ("parallelization in phi dir");
+      if (   grid->nproc[KDIR] > 1
+          && (   grid->nproc[KDIR]%2 != 0
+              || grid->np_int_glob[KDIR]%grid->nproc[KDIR] != 0)){
+        printLog ("! Boundary(): polaraxis b.c. requires an even number ");
+        printLog ("of equal blocks in phi dir\n");
         QUIT_PLUTO(1);
       }
       #endif
 
-      PolarAxisBoundary(d, &center_box, side[is]);
+      PolarAxisBoundary(d, &center_box, side[is], grid);
 
     }else if (type[is] == SHEARING) {
 
@@ -580,7 +586,7 @@ void FlipSign (int side, int type, int *vsign)
 }
 
 /* ********************************************************************* */
-void OutflowBoundary (double ***q, RBox *box, int side)
+void OutflowBoundary (Data_Type ***q, RBox *box, int side)
 /*! 
  * Impose zero-gradient boundary conditions on 'q' on 
  * the boundary side specified by 'side'.
@@ -623,7 +629,7 @@ void OutflowBoundary (double ***q, RBox *box, int side)
 }
 
 /* ********************************************************************* */
-void PeriodicBoundary (double ***q, RBox *box, int side)
+void PeriodicBoundary (Data_Type ***q, RBox *box, int side)
 /*!
  * Implements periodic boundary conditions in serial mode or when 
  * one processor only handle the periodic direction.
@@ -664,7 +670,7 @@ void PeriodicBoundary (double ***q, RBox *box, int side)
 }
 
 /* ********************************************************************* */
-void ReflectiveBoundary (double ***q, int s, int stag, RBox *box, int side)
+void ReflectiveBoundary (Data_Type ***q, int s, int stag, RBox *box, int side)
 /*!
  * Make symmetric (s = 1) or anti-symmetric (s = -1) profiles 
  * with respect to the boundary plane specified by box->side.
@@ -718,14 +724,19 @@ void ReflectiveBoundary (double ***q, int s, int stag, RBox *box, int side)
 }
 
 /* ********************************************************************* */
-void PolarAxisBoundary(const Data *d, RBox *box, int side)
+void PolarAxisBoundary(const Data *d, RBox *box, int side, Grid *grid)
 /*!
  * Boundary conditions on singular axis.
+ * In spherical geometry the phi direction may be split among an even
+ * number of processes: ghost zones are then filled with the data of
+ * the process holding the opposite side of the axis (phi + pi).
  *
  *********************************************************************** */
 {
   int i,j,k, nv;
   int j1,i1,k1;
+  int n, par = 0;
+  static double *rcv_buf;
 
 #ifdef STAGGERED_MHD
   print ("! PolarAxisBoundary(): not implemented for STAGGERED_MHD\n");
@@ -765,12 +776,52 @@ void PolarAxisBoundary(const Data *d, RBox *box, int side)
 #if GEOMETRY == SPHERICAL
   if (side == X2_BEG || side == X2_END){  /* -- X1_BEG boundary -- */
     if (box->vpos == CENTER) {
+
+    /* -- With phi split among processes, zones of the process
+          nproc/2 blocks away map one-to-one onto the local ones.
+          Exchange the rows next to the axis -- */
+
+      #ifdef PARALLEL
+      if (grid->nproc[KDIR] > 1){
+        int dst, coords[3];
+        static double *snd_buf;
+        static MPI_Comm cartcomm;
+
+        if (snd_buf == NULL){
+          n = NX3_TOT*grid->nghost[JDIR]*NX1_TOT*NVAR;
+          snd_buf = ARRAY_1D(n, double);
+          rcv_buf = ARRAY_1D(n, double);
+          AL_Get_cart_comm(SZ, &cartcomm);
+        }
+
+        n = 0;
+        BOX_LOOP(box,k,j,i){
+          if (side == X2_BEG) j1 = 2*JBEG - j - 1;
+          if (side == X2_END) j1 = 2*JEND - j + 1;
+          NVAR_LOOP(nv) snd_buf[n++] = d->Vc[nv][k][j1][i];
+        }
+
+        DIM_LOOP(i) coords[i] = grid->rank_coord[i];
+        coords[KDIR] = (coords[KDIR] + grid->nproc[KDIR]/2)%grid->nproc[KDIR];
+        MPI_Cart_rank (cartcomm, coords, &dst);
+        MPI_Sendrecv (snd_buf, n, MPI_DOUBLE, dst, 0,
+                      rcv_buf, n, MPI_DOUBLE, dst, 0,
+                      cartcomm, MPI_STATUS_IGNORE);
+        par = 1;
+      }
+      #endif
+
+      n = 0;
       BOX_LOOP(box,k,j,i){
         k1 = k + NX3/2;
         if (k1 > KEND) k1 -= NX3;
         if (side == X2_BEG) j1 = 2*JBEG - j - 1; /* Mirror point on other side of ring */
         if (side == X2_END) j1 = 2*JEND - j + 1; /* Mirror point on other side of ring */
-        NVAR_LOOP(nv) d->Vc[nv][k][j][i] = d->Vc[nv][k1][j1][i];
+        if (par) {
+          NVAR_LOOP(nv) d->Vc[nv][k][j][i] = rcv_buf[n++];
+        }else{
+          NVAR_LOOP(nv) d->Vc[nv][k][j][i] = d->Vc[nv][k1][j1][i];
+        }
         d->Vc[VX2][k][j][i] *= -1.0;
         d->Vc[VX3][k][j][i] *= -1.0;
         #if PHYSICS == MHD
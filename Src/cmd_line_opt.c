@@ -43,6 +43,7 @@ void ParseCmdLineArgs (int argc, char *argv[], char *ini_file, cmdLine *cmd)
   cmd->makegrid  = NO; 
   cmd->jet       = -1; /* -- means option is not used -- */
   cmd->xres      = -1; /* -- means no grid resizing   -- */
+  cmd->ioranks   = 0;  /* -- means no I/O servers     -- */
 
   cmd->nproc[IDIR] = -1; /* means autodecomp will be used */
   cmd->nproc[JDIR] = -1;
@@ -98,6 +99,19 @@ void ParseCmdLineArgs (int argc, char *argv[], char *ini_file, cmdLine *cmd)
 
       sprintf (ini_file,"%s",argv[++i]);
     
+    }else if (!strcmp(argv[i],"-ioranks")) {
+
+      if ((++i) >= argc){
+        if (prank == 0) printf ("! You must specify -ioranks nn\n");
+        QUIT_PLUTO(1);
+      }else{
+        cmd->ioranks = atoi(argv[i]);
+        if (cmd->ioranks < 0) {
+          if (prank == 0) printf ("! You must specify -ioranks nn, with nn >= 0 \n");
+          QUIT_PLUTO(1);
+        }
+      }
+
     }else if (!strcmp(argv[i],"-makegrid")) {
 
       cmd->makegrid = YES;
@@ -245,6 +259,12 @@ void PrintUsage()
   printf ("    Restart computations from the n-th output file in HDF5\n");
   printf ("    double precision format (.dbl.h5).\n\n");
 
+  printf (" -ioranks n\n");
+  printf ("    Spawn n I/O server processes per node (parallel mode only).\n");
+  printf ("    Binary output files (.dbl, .flt, .vtk) are sent to the servers\n");
+  printf ("    with non-blocking communications and written while\n");
+  printf ("    computations proceed.\n\n");
+
   printf (" -makegrid\n");
   printf ("    Generate grid only, do not start computations.\n\n");
 
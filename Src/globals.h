@@ -135,6 +135,13 @@ double   g_maxMach;     /**< The maximum Mach number computed during integration
 #if ROTATING_FRAME
  double g_OmegaZ;  /**< The angular rotation frequency when rotation is
                         included. */
+ double g_OmegaZout;  /**< Angular frequency of the computational frame
+                           relative to the frame used for VTK outputs and
+                           probes (zero: same frame). */
+ double g_tOmegaZout; /**< Time at which the two frames coincide. */
+ double g_OmegaZsteady; /**< Angular frequency at which a steady pattern
+                             (e.g. the ambient wind) moves on the grid,
+                             see SteadyMonitor(). */
 #endif
 
 double g_domBeg[3];  /**< Lower limits of the computational domain. */
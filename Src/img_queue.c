@@ -0,0 +1,199 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Encode and write images on a background thread.
+
+  ImageQueuePush() hands a finished RGB image (8 bits per channel, rows
+  from top to bottom) to an encoder thread and returns immediately;
+  the thread writes it as PNG (when \c USE_PNG is defined and the file
+  name ends with \c .png) or as binary PPM.
+  Images are first written to <tt> fname.tmp </tt> and then renamed,
+  so a file never appears half written.
+  Optionally, once the image is in place a line of text is appended to
+  a list file (e.g. the \c .out file of a slice), so that anything
+  listed there already exists.
+
+  Jobs are processed in the order they were pushed.
+  The thread is started on the first push; ImageQueueFinalize() waits
+  for the pending jobs and stops it.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include "pluto.h"
+#include <pthread.h>
+#ifdef USE_PNG
+ #include <png.h>
+#endif
+
+typedef struct ImageJob_{
+  char   fname[512];
+  char   list_file[512];
+  char   *list_line;       /**< Line appended to list_file, or NULL */
+  int    ncol, nrow;
+  unsigned char *rgb;
+  struct ImageJob_ *next;
+} ImageJob;
+
+static ImageJob *queue_head = NULL, *queue_tail = NULL;
+static int       queue_stop = 0, queue_running = 0;
+static pthread_t       queue_thread;
+static pthread_mutex_t queue_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  queue_cond = PTHREAD_COND_INITIALIZER;
+
+static void *ImageQueueThread (void *);
+static void  ImageEncode (ImageJob *);
+
+/* ********************************************************************* */
+void ImageQueuePush (char *fname, unsigned char *rgb, int ncol, int nrow,
+                     char *list_file, char *list_line)
+/*!
+ * Queue an image for writing. The queue takes ownership of \c rgb,
+ * which must have been allocated with malloc() and is freed once the
+ * image has been written.
+ *
+ * \param [in] fname      name of the image file
+ * \param [in] rgb        ncol*nrow RGB triplets, first row on top
+ * \param [in] ncol       number of columns
+ * \param [in] nrow       number of rows
+ * \param [in] list_file  file to which list_line is appended (or NULL)
+ * \param [in] list_line  line appended after the image has been written
+ *********************************************************************** */
+{
+  ImageJob *job;
+
+  job = (ImageJob *) malloc(sizeof(ImageJob));
+  strcpy (job->fname, fname);
+  job->list_line = NULL;
+  if (list_file != NULL && list_line != NULL){
+    strcpy (job->list_file, list_file);
+    job->list_line = (char *) malloc(strlen(list_line) + 1);
+    strcpy (job->list_line, list_line);
+  }
+  job->ncol = ncol;
+  job->nrow = nrow;
+  job->rgb  = rgb;
+  job->next = NULL;
+
+  pthread_mutex_lock (&queue_lock);
+  if (!queue_running){
+    queue_stop = 0;
+    if (pthread_create (&queue_thread, NULL, ImageQueueThread, NULL) != 0){
+      printLog ("! ImageQueuePush(): cannot start encoder thread\n");
+      QUIT_PLUTO(1);
+    }
+    queue_running = 1;
+  }
+  if (queue_tail == NULL) queue_head = job;
+  else                    queue_tail->next = job;
+  queue_tail = job;
+  pthread_cond_signal (&queue_cond);
+  pthread_mutex_unlock (&queue_lock);
+}
+
+/* ********************************************************************* */
+void ImageQueueFinalize (void)
+/*!
+ * Write all pending images and stop the encoder thread.
+ *********************************************************************** */
+{
+  if (!queue_running) return;
+
+  pthread_mutex_lock (&queue_lock);
+  queue_stop = 1;
+  pthread_cond_signal (&queue_cond);
+  pthread_mutex_unlock (&queue_lock);
+
+  pthread_join (queue_thread, NULL);
+  queue_running = 0;
+}
+
+/* ********************************************************************* */
+void *ImageQueueThread (void *arg)
+/*!
+ * Encoder thread: pop jobs until the queue is empty and a stop has
+ * been requested.
+ *********************************************************************** */
+{
+  ImageJob *job;
+
+  for (;;){
+    pthread_mutex_lock (&queue_lock);
+    while (queue_head == NULL && !queue_stop){
+      pthread_cond_wait (&queue_cond, &queue_lock);
+    }
+    job = queue_head;
+    if (job != NULL){
+      queue_head = job->next;
+      if (queue_head == NULL) queue_tail = NULL;
+    }
+    pthread_mutex_unlock (&queue_lock);
+
+    if (job == NULL) break;   /* Empty queue and stop requested */
+
+    ImageEncode (job);
+    free (job->rgb);
+    free (job->list_line);
+    free (job);
+  }
+  return NULL;
+}
+
+/* ********************************************************************* */
+void ImageEncode (ImageJob *job)
+/*!
+ * Write one image (PNG or PPM) and update the list file.
+ *********************************************************************** */
+{
+  char   tmp_name[520];
+  FILE   *fp;
+  #ifdef USE_PNG
+  int    ir, len;
+  png_structp png_ptr;
+  png_infop   info_ptr;
+  #endif
+
+  sprintf (tmp_name, "%s.tmp", job->fname);
+  fp = fopen (tmp_name, "wb");
+  if (fp == NULL){
+    printLog ("! ImageEncode(): cannot open %s\n", tmp_name);
+    return;
+  }
+
+  #ifdef USE_PNG
+  len = strlen(job->fname);
+  if (len > 4 && !strcmp(job->fname + len - 4, ".png")){
+    png_ptr  = png_create_write_struct (PNG_LIBPNG_VER_STRING,
+                                        NULL, NULL, NULL);
+    info_ptr = png_create_info_struct (png_ptr);
+    png_init_io (png_ptr, fp);
+    png_set_compression_level (png_ptr, 6);
+    png_set_IHDR (png_ptr, info_ptr, job->ncol, job->nrow, 8,
+                  PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE,
+                  PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    png_write_info (png_ptr, info_ptr);
+    for (ir = 0; ir < job->nrow; ir++){
+      png_write_row (png_ptr, job->rgb + 3L*job->ncol*ir);
+    }
+    png_write_end (png_ptr, info_ptr);
+    png_destroy_write_struct (&png_ptr, &info_ptr);
+  }else
+  #endif
+  {
+    fprintf (fp, "P6\n%d %d\n255\n", job->ncol, job->nrow);
+    fwrite (job->rgb, 3, (size_t)job->ncol*job->nrow, fp);
+  }
+  fclose (fp);
+  rename (tmp_name, job->fname);
+
+  if (job->list_line != NULL){
+    fp = fopen (job->list_file, "a");
+    if (fp == NULL){
+      printLog ("! ImageEncode(): cannot open %s\n", job->list_file);
+      return;
+    }
+    fprintf (fp, "%s", job->list_line);
+    fclose (fp);
+  }
+}
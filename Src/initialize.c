@@ -439,8 +439,8 @@ void Initialize(Data *data, Runtime *runtime, Grid *grid, cmdLine *cmd_line)
    ---------------------------------------------- */
 
   print ("\n> Memory allocation\n");
-  data->Vc = ARRAY_4D(NVAR, NX3_TOT, NX2_TOT, NX1_TOT, double);
-  data->Uc = ARRAY_4D(NX3_TOT, NX2_TOT, NX1_TOT, NVAR, double); 
+  data->Vc = ARRAY_4D(NVAR, NX3_TOT, NX2_TOT, NX1_TOT, Data_Type);
+  data->Uc = ARRAY_4D(NX3_TOT, NX2_TOT, NX1_TOT, NVAR, Data_Type);
 
 #ifdef STAGGERED_MHD
   data->Vs = ARRAY_1D(6, double ***);
@@ -505,6 +505,9 @@ void Initialize(Data *data, Runtime *runtime, Grid *grid, cmdLine *cmd_line)
 #endif
 
   data->flag = ARRAY_3D(NX3_TOT, NX2_TOT, NX1_TOT, uint16_t);
+#if TIME_STEPPING == MUSCL_HANCOCK
+  data->dVh  = ARRAY_4D(NX3_TOT, NX2_TOT, NX1_TOT, NVAR, double);
+#endif
 
 /* ----------------------------------------------
    7b. Riemann solver pointer
@@ -27,6 +27,12 @@
   input coordinates to the desired coordinate location using bi- or
   tri-linear interpolation to fill the data array.
 
+  InputDataProlong() fills the local zones of a grid with volume
+  averages of a limited linear reconstruction of the (cell-centered)
+  input field, thus conserving its volume integral.
+  This is used to start a run from the result of a coarser one (e.g.
+  ProlongFromFile()).
+
   The input data is stored in a buffer by reading ::ID_NZ_MAX planes at
   a time to save computational memory.
   The value of ::ID_NZ_MAX can be changed from your personal \c definitions.h.
@@ -57,6 +63,7 @@ typedef struct inputData_{
   double *x1;
   double *x2;
   double *x3;
+  double *xf[3];    /**< Zone interfaces (cell-centered data only) */
   double ***Vin;    /**< Input buffer array (containing at most ::ID_NZ_MAX
                          planes at a time */
   long int offset;
@@ -64,6 +71,14 @@ typedef struct inputData_{
 
 static inputData id_stack[ID_NVAR_MAX];
 
+#define ID_NOV_MAX  8   /* Max number of input zones overlapping a zone
+                           in one direction (InputDataProlong()) */
+
+static double IDCentroid (int, double, double);
+static double IDMeasure  (int, double, double);
+static double IDSlope    (double, double, double, double, double, double);
+static void   IDReadPlane (inputData *, int, double **);
+
 /* ********************************************************************* */
 int InputDataOpen(char *data_fname, char *grid_fname, char *endianity,
                   long int offset, int vpos)
@@ -188,10 +203,13 @@ int InputDataOpen(char *data_fname, char *grid_fname, char *endianity,
     id->x1[i] = xr;
   }else {
     id->x1 = ARRAY_1D(id->nx1, double);
+    id->xf[0] = ARRAY_1D(id->nx1 + 1, double);
     for (i = 0; i < id->nx1; i++){
       fscanf(fp,"%d  %lf %lf\n", &ip, &xl, &xr);
       id->x1[i] = 0.5*(xl + xr);
+      id->xf[0][i] = xl;
     }
+    id->xf[0][i] = xr;
   }  
   
 /* -- x2 direction -- */   
@@ -207,10 +225,13 @@ int InputDataOpen(char *data_fname, char *grid_fname, char *endianity,
     id->x2[i] = xr;
   }else{
     id->x2 = ARRAY_1D(id->nx2, double);
+    id->xf[1] = ARRAY_1D(id->nx2 + 1, double);
     for (i = 0; i < id->nx2; i++){
       fscanf(fp,"%d  %lf %lf\n", &ip, &xl, &xr);
       id->x2[i] = 0.5*(xl + xr);
+      id->xf[1][i] = xl;
     }
+    id->xf[1][i] = xr;
   }  
 
 /* -- x3 direction -- */   
@@ -226,10 +247,13 @@ int InputDataOpen(char *data_fname, char *grid_fname, char *endianity,
     id->x3[i] = xr;
   }else{
     id->x3 = ARRAY_1D(id->nx3, double);
+    id->xf[2] = ARRAY_1D(id->nx3 + 1, double);
     for (i = 0; i < id->nx3; i++){
       fscanf(fp,"%d  %lf %lf\n", &ip, &xl, &xr);
       id->x3[i] = 0.5*(xl + xr);
+      id->xf[2][i] = xl;
     }
+    id->xf[2][i] = xr;
   }  
 
   id->vpos = vpos;  
@@ -327,11 +351,16 @@ void InputDataClose(int indx)
  * Free memory and reset structure.
  *********************************************************************** */
 {
+  int i;
   printLog ("  Freeing struct #%d\n",indx);
   inputData *id = id_stack + indx;
   FreeArray1D((void *)id->x1);
   FreeArray1D((void *)id->x2);
   FreeArray1D((void *)id->x3);
+  for (i = 0; i < 3; i++){
+    if (id->xf[i] != NULL) FreeArray1D((void *)id->xf[i]);
+    id->xf[i] = NULL;
+  }
   FreeArray3D((void *)id->Vin);
   id->Vin = NULL;
 }
@@ -709,3 +738,303 @@ for (i = 0; i < id->nx1; i++){
 }
 
 
+
+/* ********************************************************************* */
+void InputDataProlong (int indx, int iw, Data_Type ***V, Grid *grid)
+/*!
+ * Fill the interior zones of the local grid with the volume average,
+ * over each zone, of a piecewise linear reconstruction of the input
+ * data. Slopes are taken with respect to the volume centroids of the
+ * input zones and limited with the MC limiter, so that the integral
+ * over any region made of whole input zones is preserved.
+ * The two grids may be arbitrary (e.g. one 2 or 4 times finer than
+ * the other), but must have the same geometry.
+ * Each process only reads the planes of the input file it needs.
+ *
+ * \param [in]  indx   input data handle (cell-centered data)
+ * \param [in]  iw     handle of a weight (e.g. density), or -1. When
+ *                     given, the product of the two fields is
+ *                     reconstructed and divided by the average weight,
+ *                     so that e.g. momentum is conserved for velocity.
+ * \param [out] V      the 3D array to be filled
+ * \param [in]  grid   pointer to an array of Grid structures
+ *********************************************************************** */
+{
+  int    i, j, k, l, n, dir, c, ks, nl, a, b, e, wrap;
+  int    ic, jc, kc, kcm, kcp, kc0, kc1, periodic;
+  int    lbeg[3], lend[3], nx[3];
+  int    *nov[3], **iov[3];
+  double **mov[3], **cov[3], *xc[3];
+  double period, xl, xr, cl, cr, lo, hi, m, val, xkc, xkm, xkp;
+  double s[3], wval, num, den;
+  double ***Q, ***W = NULL, ***F;
+  inputData *id = id_stack + indx, *idw = NULL;
+
+  if (id->geom != GEOMETRY || id->xf[0] == NULL){
+    printLog ("! InputDataProlong(): input data must be cell-centered\n");
+    printLog ("                      and have the same geometry\n");
+    QUIT_PLUTO(1);
+  }
+  if (iw >= 0){
+    idw = id_stack + iw;
+    if (idw->nx1 != id->nx1 || idw->nx2 != id->nx2 || idw->nx3 != id->nx3){
+      printLog ("! InputDataProlong(): weight has a different grid\n");
+      QUIT_PLUTO(1);
+    }
+  }
+
+  nx[IDIR] = id->nx1; lbeg[IDIR] = IBEG; lend[IDIR] = IEND;
+  nx[JDIR] = id->nx2; lbeg[JDIR] = JBEG; lend[JDIR] = JEND;
+  nx[KDIR] = id->nx3; lbeg[KDIR] = KBEG; lend[KDIR] = KEND;
+  periodic = RuntimeGet()->left_bound[KDIR] == PERIODIC && nx[KDIR] > 1;
+  period   = id->xf[KDIR][nx[KDIR]] - id->xf[KDIR][0];
+
+/* --------------------------------------------------------
+   1. Volume centroids of the input zones
+   -------------------------------------------------------- */
+
+  for (dir = 0; dir < 3; dir++){
+    xc[dir] = ARRAY_1D(nx[dir], double);
+    for (c = 0; c < nx[dir]; c++){
+      xc[dir][c] = IDCentroid(dir, id->xf[dir][c], id->xf[dir][c+1]);
+    }
+  }
+
+/* --------------------------------------------------------
+   2. For every local zone and direction, list the input
+      zones it overlaps, with measure and centroid of the
+      overlap. Beyond the input grid, the first and last
+      zones are extended or, if x3 is periodic, wrapped:
+      x3 indices c then run past [0, nx3-1], zone c lying
+      at xf[c mod nx3] + floor(c/nx3)*period.
+   -------------------------------------------------------- */
+
+  kc0 = kc1 = 0;
+  for (dir = 0; dir < 3; dir++){
+    nl = lend[dir] - lbeg[dir] + 1;
+    nov[dir] = ARRAY_1D(nl, int);
+    iov[dir] = ARRAY_2D(nl, ID_NOV_MAX, int);
+    mov[dir] = ARRAY_2D(nl, ID_NOV_MAX, double);
+    cov[dir] = ARRAY_2D(nl, ID_NOV_MAX, double);
+    for (l = 0; l < nl; l++){
+      xl = grid->xl[dir][lbeg[dir] + l];
+      xr = grid->xr[dir][lbeg[dir] + l];
+      ks = 0;
+      if (dir == KDIR && periodic){
+        ks  = (int)floor((xl - id->xf[dir][0])/period);
+        xl -= ks*period;
+        xr -= ks*period;
+      }
+      for (c = 0; c < nx[dir] - 1 && id->xf[dir][c+1] <= xl; c++);
+
+      for (n = 0; ; c++){
+        if (dir == KDIR && periodic){
+          wrap = (c >= nx[dir]);   /* At most once */
+          cl = id->xf[dir][c - wrap*nx[dir]]     + wrap*period;
+          cr = id->xf[dir][c - wrap*nx[dir] + 1] + wrap*period;
+        }else{
+          cl = (c == 0           ? -1.e38:id->xf[dir][c]);
+          cr = (c == nx[dir] - 1 ?  1.e38:id->xf[dir][c+1]);
+        }
+        lo = MAX(xl, cl);
+        hi = MIN(xr, cr);
+        if (hi > lo || nx[dir] == 1){
+          if (n == ID_NOV_MAX){
+            printLog ("! InputDataProlong(): input grid too fine\n");
+            QUIT_PLUTO(1);
+          }
+          iov[dir][l][n] = c + ks*nx[dir];
+          mov[dir][l][n] = (nx[dir] == 1 ? 1.0:IDMeasure(dir, lo, hi));
+          cov[dir][l][n] = (nx[dir] == 1 ? xc[dir][0]
+                                         :IDCentroid(dir, lo, hi) + ks*period);
+          n++;
+        }
+        if (cr >= xr || nx[dir] == 1) break;
+        if (c == nx[dir] - 1 && !(dir == KDIR && periodic)) break;
+      }
+      nov[dir][l] = n;
+      if (dir == KDIR){
+        if (l == 0) kc0 = iov[dir][l][0];
+        kc1 = iov[dir][l][n-1];
+      }
+    }
+  }
+
+/* --------------------------------------------------------
+   3. Read the x3 planes needed (one more on each side,
+      for slopes), as product with the weight if given
+   -------------------------------------------------------- */
+
+  kc0--; kc1++;
+  Q = ARRAY_3D(kc1 - kc0 + 1, nx[JDIR], nx[IDIR], double);
+  if (idw != NULL) W = ARRAY_3D(kc1 - kc0 + 1, nx[JDIR], nx[IDIR], double);
+  for (kc = kc0; kc <= kc1; kc++){
+    if (periodic) k = ((kc % nx[KDIR]) + nx[KDIR]) % nx[KDIR];
+    else          k = MAX(0, MIN(kc, nx[KDIR] - 1));
+    IDReadPlane (id, k, Q[kc - kc0]);
+    if (idw == NULL) continue;
+    IDReadPlane (idw, k, W[kc - kc0]);
+    for (jc = 0; jc < nx[JDIR]; jc++){
+    for (ic = 0; ic < nx[IDIR]; ic++){
+      Q[kc - kc0][jc][ic] *= W[kc - kc0][jc][ic];
+    }}
+  }
+
+/* --------------------------------------------------------
+   4. Average the reconstruction over the overlaps
+   -------------------------------------------------------- */
+
+  for (k = KBEG; k <= KEND; k++){
+  for (j = JBEG; j <= JEND; j++){
+  for (i = IBEG; i <= IEND; i++){
+    num = den = 0.0;
+    for (e = 0; e < nov[KDIR][k-KBEG]; e++){
+      kc  = iov[KDIR][k-KBEG][e];
+      kcm = kc - 1; kcp = kc + 1;
+      ks  = (int)floor((double)kc/nx[KDIR]);
+      xkc = xc[KDIR][kc - ks*nx[KDIR]] + ks*period;
+      ks  = (int)floor((double)kcm/nx[KDIR]);
+      xkm = xc[KDIR][kcm - ks*nx[KDIR]] + ks*period;
+      ks  = (int)floor((double)kcp/nx[KDIR]);
+      xkp = xc[KDIR][kcp - ks*nx[KDIR]] + ks*period;
+      if (!periodic && (kc <= 0 || kc >= nx[KDIR] - 1)) xkm = xkp = xkc;
+      kc  -= kc0; kcm -= kc0; kcp -= kc0;
+
+      for (b = 0; b < nov[JDIR][j-JBEG]; b++){
+        jc = iov[JDIR][j-JBEG][b];
+        for (a = 0; a < nov[IDIR][i-IBEG]; a++){
+          ic = iov[IDIR][i-IBEG][a];
+          m  =   mov[IDIR][i-IBEG][a]*mov[JDIR][j-JBEG][b]
+                *mov[KDIR][k-KBEG][e];
+
+          for (n = 0; n < (W == NULL ? 1:2); n++){
+            F = (n == 0 ? Q:W);
+            s[IDIR] = s[JDIR] = s[KDIR] = 0.0;
+            if (ic > 0 && ic < nx[IDIR] - 1){
+              s[IDIR] = IDSlope(F[kc][jc][ic-1], F[kc][jc][ic], F[kc][jc][ic+1],
+                                xc[IDIR][ic-1], xc[IDIR][ic], xc[IDIR][ic+1]);
+            }
+            if (jc > 0 && jc < nx[JDIR] - 1){
+              s[JDIR] = IDSlope(F[kc][jc-1][ic], F[kc][jc][ic], F[kc][jc+1][ic],
+                                xc[JDIR][jc-1], xc[JDIR][jc], xc[JDIR][jc+1]);
+            }
+            if (xkp > xkm){
+              s[KDIR] = IDSlope(F[kcm][jc][ic], F[kc][jc][ic], F[kcp][jc][ic],
+                                xkm, xkc, xkp);
+            }
+            val =   F[kc][jc][ic]
+                  + s[IDIR]*(cov[IDIR][i-IBEG][a] - xc[IDIR][ic])
+                  + s[JDIR]*(cov[JDIR][j-JBEG][b] - xc[JDIR][jc])
+                  + s[KDIR]*(cov[KDIR][k-KBEG][e] - xkc);
+            if (n == 0) num += m*val;
+            else        wval  = val;
+          }
+          den += m*(W == NULL ? 1.0:wval);
+        }
+      }
+    }
+    V[k][j][i] = num/den;
+  }}}
+
+  for (dir = 0; dir < 3; dir++){
+    FreeArray1D((void *)xc[dir]);
+    FreeArray1D((void *)nov[dir]);
+    FreeArray2D((void *)iov[dir]);
+    FreeArray2D((void *)mov[dir]);
+    FreeArray2D((void *)cov[dir]);
+  }
+  FreeArray3D((void *)Q);
+  if (W != NULL) FreeArray3D((void *)W);
+}
+
+/* ********************************************************************* */
+void IDReadPlane (inputData *id, int k, double **plane)
+/*!
+ * Read the x3 plane \c k of an input data file.
+ *********************************************************************** */
+{
+  int    i, j;
+  long   n = (long)id->nx1*id->nx2;
+  char   *buf;
+  float  uflt;
+  double udbl;
+  FILE   *fp;
+
+  buf = (char *) malloc(n*id->dsize);
+  fp  = fopen(id->fname, "rb");
+  fseek (fp, id->offset + k*id->dsize*n, SEEK_SET);
+  if (fread (buf, id->dsize, n, fp) != (size_t)n){
+    printLog ("! IDReadPlane(): error reading %s\n", id->fname);
+    QUIT_PLUTO(1);
+  }
+  fclose(fp);
+
+  for (j = 0; j < id->nx2; j++){
+  for (i = 0; i < id->nx1; i++){
+    if (id->dsize == sizeof(double)){
+      memcpy (&udbl, buf + (j*id->nx1 + i)*id->dsize, id->dsize);
+      if (id->swap_endian) SWAP_VAR(udbl);
+      plane[j][i] = udbl;
+    }else{
+      memcpy (&uflt, buf + (j*id->nx1 + i)*id->dsize, id->dsize);
+      if (id->swap_endian) SWAP_VAR(uflt);
+      plane[j][i] = (double)uflt;
+    }
+  }}
+  free (buf);
+}
+
+/* ********************************************************************* */
+double IDMeasure (int dir, double xl, double xr)
+/*!
+ * Return the factor contributed by direction \c dir to the volume of
+ * the zone <tt> [xl, xr] </tt>.
+ *********************************************************************** */
+{
+  #if GEOMETRY == SPHERICAL
+  if (dir == IDIR) return (xr*xr*xr - xl*xl*xl)/3.0;
+  if (dir == JDIR) return cos(xl) - cos(xr);
+  #elif GEOMETRY == CYLINDRICAL || GEOMETRY == POLAR
+  if (dir == IDIR) return 0.5*(xr*xr - xl*xl);
+  #endif
+  return xr - xl;
+}
+
+/* ********************************************************************* */
+double IDCentroid (int dir, double xl, double xr)
+/*!
+ * Return the volume centroid, in direction \c dir, of the zone
+ * <tt> [xl, xr] </tt>.
+ *********************************************************************** */
+{
+  #if GEOMETRY == SPHERICAL
+  if (dir == IDIR){
+    return 0.75*(xr*xr*xr*xr - xl*xl*xl*xl)/(xr*xr*xr - xl*xl*xl);
+  }
+  if (dir == JDIR){
+    return   (sin(xr) - sin(xl) - xr*cos(xr) + xl*cos(xl))
+           / (cos(xl) - cos(xr));
+  }
+  #elif GEOMETRY == CYLINDRICAL || GEOMETRY == POLAR
+  if (dir == IDIR){
+    return 2.0/3.0*(xr*xr*xr - xl*xl*xl)/(xr*xr - xl*xl);
+  }
+  #endif
+  return 0.5*(xl + xr);
+}
+
+/* ********************************************************************* */
+double IDSlope (double qm, double q0, double qp,
+                double xm, double x0, double xp)
+/*!
+ * Return the MC-limited slope of q at x0 on a non-uniform grid.
+ *********************************************************************** */
+{
+  double dl = (q0 - qm)/(x0 - xm);
+  double dr = (qp - q0)/(xp - x0);
+  double dc = 0.5*(dl + dr);
+
+  if (dl*dr <= 0.0) return 0.0;
+  if (dc > 0.0) return MIN(dc, 2.0*MIN(dl, dr));
+  return MAX(dc, 2.0*MAX(dl, dr));
+}
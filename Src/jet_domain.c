@@ -23,7 +23,7 @@
 #include "pluto.h"
 
 static int jd_nbeg, jd_nend, jd_npt, jd_ntot, rbound;
-static int GetRightmostIndex(int, double ***);
+static int GetRightmostIndex(int, Data_Type ***);
 
 /* ********************************************************************* */
 void SetJetDomain (const Data *d, int dir, int log_freq, Grid *grid)
@@ -42,7 +42,8 @@ void SetJetDomain (const Data *d, int dir, int log_freq, Grid *grid)
   int i, j, k, ngh;
   int n, n_glob;
   static int first_call = 1;
-  double ***pr, ***dn, dp;
+  Data_Type ***pr, ***dn;
+  double dp;
 
   dn = d->Vc[RHO];
   #if HAVE_ENERGY
@@ -161,7 +162,7 @@ void UnsetJetDomain (const Data *d, int dir, Grid *grid)
 }
 
 /* ********************************************************************* */
-int GetRightmostIndex (int dir, double ***q)
+int GetRightmostIndex (int dir, Data_Type ***q)
 /*!
  *
  * Find the local index j where grad(p) exceeds
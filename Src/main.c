@@ -75,6 +75,10 @@ int main (int argc, char *argv[])
 
 #ifdef PARALLEL
   AL_Init (&argc, &argv);
+  if (AL_Io_server_run() == AL_TRUE){  /* Spawned I/O server: done */
+    AL_Finalize ();
+    return 0;
+  }
   MPI_Comm_rank (MPI_COMM_WORLD, &prank);
 #endif
 
@@ -102,6 +106,17 @@ int main (int argc, char *argv[])
   }
   ShowConfig  (argc, argv, input_file);
 
+#ifdef PARALLEL
+  if (cmd_line.ioranks > 0){
+    nv = AL_Io_server_start (argv[0], cmd_line.ioranks);
+    if (nv < 0){
+      printLog ("! main(): cannot spawn I/O server processes\n");
+      QUIT_PLUTO(1);
+    }
+    print ("> I/O servers: %d (%d per node)\n\n", nv, cmd_line.ioranks);
+  }
+#endif
+
 /* --------------------------------------------------------
    0c. Initialize parallel environment, grid, memory
        allocation.
@@ -134,6 +149,15 @@ int main (int argc, char *argv[])
 #endif
 
   g_stepNumber = 0;
+  ProbesInit (&runtime, &cmd_line, grd);
+  SlicesInit (&runtime, &cmd_line, grd);
+  if (   cmd_line.restart == NO && cmd_line.h5restart == NO
+      && runtime.march_tol > 0.0){
+    MarchSteadyState (&data, &Dts, &runtime, grd);
+  }else if (   cmd_line.restart == NO && cmd_line.h5restart == NO
+            && runtime.prolong_nfile >= 0){
+    ProlongFromFile (&data, &runtime, grd);
+  }
   
 /* --------------------------------------------------------
    0e. Check if restart is necessary. 
@@ -152,6 +176,8 @@ int main (int argc, char *argv[])
   }else if (cmd_line.write){
     CheckForOutput   (&data, &runtime, tbeg, grd);
     CheckForAnalysis (&data, &runtime, grd);
+    ProbesSample     (&data, grd);
+    SlicesWrite      (&data, grd);
   }
 
   if (cmd_line.maxsteps == 0) last_step = 1;
@@ -197,6 +223,8 @@ int main (int argc, char *argv[])
     if (!first_step && cmd_line.write) {
       if (!last_step) CheckForOutput  (&data, &runtime, tbeg, grd);
       CheckForAnalysis(&data, &runtime, grd);
+      ProbesSample    (&data, grd);
+      SlicesWrite     (&data, grd);
     }
 
   /* ----------------------------------------------------
@@ -204,22 +232,23 @@ int main (int argc, char *argv[])
          g_dt = dt(n). After this step U^n -> U^{n+1}
      ---------------------------------------------------- */
 
+    if (runtime.cfl_max > 0.0) AdaptCFLSave (&data, grd);
     if (cmd_line.jet != -1) SetJetDomain (&data, cmd_line.jet, runtime.log_freq, grd); 
     err = Integrate (&data, &Dts, grd);
     if (cmd_line.jet != -1) UnsetJetDomain (&data, cmd_line.jet, grd); 
 
   /* ----------------------------------------------------
      1e. Integration didn't go through. Step must
-         be redone from previously saved solution.
+         be redone from previously saved solution
+         with a smaller time step (adapt_cfl.c).
      ---------------------------------------------------- */
-/*
-    if (err != 0){
-      printLog ("! Step failed. Re-trying\n");
-      zones with problems must be tagged with MINMOD_FLAG and HLL_FLAG
-      time step should be halved
-      GET_SOL(&data);
+
+    while (runtime.cfl_max > 0.0 && AdaptCFLCheck (&data, &Dts, &runtime, grd)){
+      if (g_stepNumber != cmd_line.maxsteps) last_step = 0;  /* dt is smaller */
+      if (cmd_line.jet != -1) SetJetDomain (&data, cmd_line.jet, runtime.log_freq, grd); 
+      err = Integrate (&data, &Dts, grd);
+      if (cmd_line.jet != -1) UnsetJetDomain (&data, cmd_line.jet, grd); 
     }
-*/
 
   /* ------------------------------------------------------
      1f. Global MPI reduction operations
@@ -275,6 +304,12 @@ int main (int argc, char *argv[])
 
     g_stepNumber++;
     first_step = 0;
+
+  /* ------------------------------------------------------
+     1i. Check convergence to a steady state (steady.c)
+     ------------------------------------------------------ */
+
+    if (runtime.steady_tol > 0.0) SteadyMonitor (&data, &runtime, grd);
   }
 
 /* =====================================================================
@@ -285,7 +320,11 @@ int main (int argc, char *argv[])
   if ((cmd_line.write) && !(cmd_line.maxsteps == 0)){
     CheckForOutput (&data, &runtime, tbeg, grd);
     CheckForAnalysis (&data, &runtime, grd);
+    ProbesSample (&data, grd);
+    SlicesWrite  (&data, grd);
   }
+  ProbesFlush();
+  ImageQueueFinalize();
 
   #ifdef PARALLEL
   MPI_Barrier (MPI_COMM_WORLD);
@@ -295,6 +334,7 @@ int main (int argc, char *argv[])
   #else
   print  ("\n> Total allocated memory  %6.2f Mb\n",(float)g_usedMemory/1.e6);
   #endif
+  ArrayMemoryReport();
 
   time(&tend);
   g_dt = difftime(tend, tbeg);
@@ -312,6 +352,7 @@ int main (int argc, char *argv[])
 
   FreeArray4D ((void *) data.Vc);
   #ifdef PARALLEL
+  AL_Io_server_stop ();
   LogFileClose();
   MPI_Barrier (MPI_COMM_WORLD);
   AL_Finalize ();
@@ -346,8 +387,8 @@ int Integrate (Data *d, timeStep *Dts, Grid *grid)
   static double ***Bss0[3], ***Ess0[3];
 
   if (Ucs0 == NULL){
-    Ucs0 = ARRAY_4D(NX3_TOT, NX2_TOT, NX1_TOT, NVAR, double);
-    Vcs0 = ARRAY_4D(NVAR, NX3_TOT, NX2_TOT, NX1_TOT, double);
+    Ucs0 = ARRAY_4D(NX3_TOT, NX2_TOT, NX1_TOT, NVAR, Data_Type);
+    Vcs0 = ARRAY_4D(NVAR, NX3_TOT, NX2_TOT, NX1_TOT, Data_Type);
     #ifdef STAGGERED_MHD
     DIM_EXPAND(
       Bss0[IDIR] = ARRAY_3D(NX3_TOT, NX2_TOT, NX1_TOT, double);  ,
@@ -628,6 +669,10 @@ double NextTimeStep (timeStep *Dts, Runtime *runtime, Grid *grid)
 #endif
 
   dt_hyp *= runtime->cfl;
+  #if MULTIRATE_LEVELS > 1
+  dt_hyp *= (double)(1 << (MULTIRATE_LEVELS-1));  /* Step of the outer
+                                                     shells (multirate.c) */
+  #endif
   dtnext  = dt_hyp;
 
 /* --------------------------------------------------------
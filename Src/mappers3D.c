@@ -68,7 +68,13 @@ int ConsToPrim3D (Data_Arr U, Data_Arr V, uint16_t ***flag, RBox *box)
       for (i = ibeg; i <= iend; i++)  NormalizeIons(U[k][j][i]);
     }  
 #endif  
+#if MIXED_PRECISION == YES
+    for (i = ibeg; i <= iend; i++) NVAR_LOOP(nv) u[i][nv] = U[k][j][i][nv];
+    err_loc = ConsToPrim (u, v, ibeg, iend, flag[k][j]);
+    for (i = ibeg; i <= iend; i++) NVAR_LOOP(nv) U[k][j][i][nv] = u[i][nv];
+#else
     err_loc = ConsToPrim (U[k][j], v, ibeg, iend, flag[k][j]);
+#endif
     err = MAX(err, err_loc);
     for (i = ibeg; i <= iend; i++) {
       NVAR_LOOP(nv) V[nv][k][j][i] = v[i][nv];
@@ -151,7 +157,12 @@ void PrimToCons3D (Data_Arr V, Data_Arr U, RBox *box)
     for (i = ibeg; i <= iend; i++) {
       NVAR_LOOP(nv) v[i][nv] = V[nv][k][j][i];
     }
+#if MIXED_PRECISION == YES
+    PrimToCons (v, u, ibeg, iend);
+    for (i = ibeg; i <= iend; i++) NVAR_LOOP(nv) U[k][j][i][nv] = u[i][nv];
+#else
     PrimToCons (v, U[k][j], ibeg, iend);
+#endif
   }}
   g_dir = current_dir; /* restore current direction */
 
@@ -0,0 +1,393 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Build a steady super-fast state by marching in the radial
+         direction.
+
+  Beyond the inner boundary the ambient solar wind is super-fast
+  magnetosonic, so that (in the corotating frame) the steady state in
+  a shell of zones only depends on the shells below it.
+  MarchSteadyState() exploits this to build the steady solution one
+  shell at a time, from the inner boundary outwards, instead of
+  integrating in time until the wind has crossed the domain.
+
+  For each radial index \c i the shell is first set equal to shell
+  <tt> i-1 </tt> and then relaxed in pseudo-time with the usual
+  integrator (UpdateStage(), i.e. the same Riemann solver, angular
+  sweeps, geometrical and body-force source terms used for time
+  integration) restricted to that shell:
+
+  - shells below \c i are fixed and act as inflow boundary;
+  - the ghost shells above \c i are linearly extrapolated from shells
+    <tt> i-1 </tt> and \c i, so that the slope of shell \c i (and
+    thus the upwind flux through its outer face) is the one of a smooth
+    profile. A zero gradient would halve the radial derivatives;
+  - angular ghost zones of the shell are exchanged with the
+    neighbouring processes after every iteration; physical boundaries
+    in x2 and x3 must be \c outflow, \c periodic or (in x2)
+    \c polaraxis. With \c RING_AVERAGE the shell is ring-averaged
+    after every iteration, as done by the time integrators.
+
+  Iterations stop when the largest relative change of density, radial
+  velocity and pressure over the shell falls below \c tol, or after
+  \c maxit iterations.
+  Processes sharing the same shells (same x1 range) relax them
+  together; along x1 the processes work as a pipeline, each one
+  starting when the previous one has sent its last shells, so a
+  decomposition with few processes in x1 (e.g. <tt> -dec 1 8 16 </tt>)
+  is preferable.
+
+  Marching is enabled by the optional \c march line in the
+  <tt> [Time] </tt> section of pluto.ini:
+  \verbatim
+   march   1.e-5   200   9.0
+  \endverbatim
+  giving \c tol, \c maxit and the time at which the boundary
+  conditions are taken and from which the integration then starts.
+  It is done only for a new run (not on restart) and the result is the
+  initial condition; a short time integration afterwards removes the
+  remaining discretization differences.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include "pluto.h"
+
+static int  MarchConsToPrim (const Data *, int);
+static void MarchShellBoundary (const Data *, int, Grid *);
+static void MarchLayer (const Data *, int, int, int, int, double *, int);
+
+/* ********************************************************************* */
+void MarchSteadyState (Data *d, timeStep *Dts, Runtime *runtime, Grid *grid)
+/*!
+ * Replace the initial condition by the steady state obtained by
+ * marching outwards in x1. Must be called by all processes.
+ *
+ * \param [in,out] d        pointer to the PLUTO Data structure
+ * \param [in,out] Dts      pointer to the timeStep structure
+ * \param [in]     runtime  pointer to a Runtime structure
+ * \param [in]     grid     pointer to an array of Grid structures
+ *********************************************************************** */
+{
+  int    i, j, k, nv, n, it, ng = grid->nghost[IDIR];
+  int    ibeg = IBEG, iend = IEND, itmax = 0, nfail = 0;
+  long   nshell, nbuf;
+  double dt, q, res[2], tol = runtime->march_tol;
+  double *buf, *vold[3];
+  int    vq[3] = {RHO, VX1, PRS};
+  RBox   box;
+  #ifdef PARALLEL
+  int    left, right;
+  MPI_Comm cart, shell_comm;
+  #endif
+  clock_t clock_beg = clock();
+
+  #if (TIME_STEPPING == MUSCL_HANCOCK) || (defined STAGGERED_MHD) \
+      || (GEOMETRY != SPHERICAL) || (DIMENSIONS != 3)
+  printLog ("! MarchSteadyState(): requires a 3D spherical grid, cell-centered\n");
+  printLog ("                      fields and a method-of-lines integrator\n");
+  QUIT_PLUTO(1);
+  #endif
+  for (n = JDIR; n <= KDIR; n++){
+    int axis = (n == JDIR ? POLARAXIS:OUTFLOW);
+    if (   (grid->lbound[n] && grid->lbound[n] != OUTFLOW
+                            && grid->lbound[n] != PERIODIC
+                            && grid->lbound[n] != axis)
+        || (grid->rbound[n] && grid->rbound[n] != OUTFLOW
+                            && grid->rbound[n] != PERIODIC
+                            && grid->rbound[n] != axis)){
+      printLog ("! MarchSteadyState(): x2/x3 boundaries must be outflow, periodic\n");
+      printLog ("                      or polaraxis (x2)\n");
+      QUIT_PLUTO(1);
+    }
+  }
+
+  print ("> Marching steady state in x1 (tol = %8.2e, maxit = %d)\n",
+         tol, runtime->march_maxit);
+  g_time = runtime->march_t0;
+
+  nshell = (long)NX2_TOT*NX3_TOT;
+  nbuf   = NVAR*ng*nshell;
+  buf    = ARRAY_1D(nbuf, double);
+  for (n = 0; n < 3; n++) vold[n] = ARRAY_1D(nshell, double);
+
+/* --------------------------------------------------------
+   1. Fill ghost zones everywhere (inner boundary
+      included), then wait for the inflow shells from the
+      process below
+   -------------------------------------------------------- */
+
+  Boundary (d, ALL_DIR, grid);
+  TOT_LOOP(k,j,i) d->flag[k][j][i] = 0;
+
+  #ifdef PARALLEL
+  AL_Get_cart_comm (SZ, &cart);
+  MPI_Cart_shift (cart, IDIR, 1, &left, &right);
+  MPI_Comm_split (MPI_COMM_WORLD, grid->rank_coord[IDIR], prank, &shell_comm);
+  if (grid->lbound[IDIR] == 0){
+    MPI_Recv (buf, nbuf, MPI_DOUBLE, left, 0, cart, MPI_STATUS_IGNORE);
+    MarchLayer (d, IDIR, IBEG - ng, ng, 1, buf, 1);
+  }
+  #endif
+
+/* --------------------------------------------------------
+   2. March shell by shell
+   -------------------------------------------------------- */
+
+  for (i = ibeg; i <= iend; i++){
+    NVAR_LOOP(nv) KTOT_LOOP(k) JTOT_LOOP(j){
+      d->Vc[nv][k][j][i] = d->Vc[nv][k][j][i-1];
+    }
+
+    IBEG = IEND = i;
+    RBoxDefine (i, i, JBEG, JEND, KBEG, KEND, CENTER, &box);
+    dt = 0.0;   /* The first iteration only gives the time step */
+
+  /* -- Start from a ring-averaged shell; this also gives the
+        chunks shared with other processes to the first
+        iteration -- */
+
+    #if RING_AVERAGE > 1
+    PrimToCons3D (d->Vc, d->Uc, &box);
+    RingAverageCons (d, grid);
+    nfail += MarchConsToPrim (d, i);
+    #endif
+
+    for (it = 1; it <= runtime->march_maxit; it++){
+
+    /* -- Extrapolate above the shell, angular ghosts -- */
+
+      for (n = 1; n <= ng; n++){
+        NVAR_LOOP(nv) KTOT_LOOP(k) JTOT_LOOP(j){
+          q = d->Vc[nv][k][j][i];
+          q = q + n*(q - d->Vc[nv][k][j][i-1]);
+          if ((nv == RHO || nv == PRS) && q <= 0.0) q = d->Vc[nv][k][j][i];
+          d->Vc[nv][k][j][i+n] = q;
+        }
+      }
+      MarchShellBoundary (d, i, grid);
+
+      n = 0;
+      KDOM_LOOP(k) JDOM_LOOP(j) {
+        vold[0][n] = d->Vc[vq[0]][k][j][i];
+        vold[1][n] = d->Vc[vq[1]][k][j][i];
+        vold[2][n] = d->Vc[vq[2]][k][j][i];
+        n++;
+      }
+
+    /* -- One pseudo-time step -- */
+
+      KTOT_LOOP(k) JTOT_LOOP(j) d->flag[k][j][i] = 0;
+      PrimToCons3D (d->Vc, d->Uc, &box);
+      g_intStage     = 1;
+      Dts->invDt_hyp = 0.0;
+      UpdateStage (d, d->Uc, d->Vs, NULL, dt, Dts, grid);
+      #if RING_AVERAGE > 1
+      RingAverageCons (d, grid);
+      #endif
+      nfail += MarchConsToPrim (d, i);
+
+    /* -- Relative change over the shell -- */
+
+      res[0] = 0.0;
+      n = 0;
+      KDOM_LOOP(k) JDOM_LOOP(j) {
+        for (nv = 0; nv < 3; nv++){
+          q = fabs(d->Vc[vq[nv]][k][j][i] - vold[nv][n]);
+          res[0] = MAX(res[0], q/(fabs(vold[nv][n]) + 1.e-30));
+        }
+        n++;
+      }
+      res[1] = Dts->invDt_hyp;
+      #ifdef PARALLEL
+      MPI_Allreduce (MPI_IN_PLACE, res, 2, MPI_DOUBLE, MPI_MAX, shell_comm);
+      #endif
+      if (dt > 0.0 && res[0] < tol) break;
+
+    /* -- Every zone of the shell is close to its own stability
+          limit, so the sum over directions is not averaged as
+          done by UpdateStage() for the global time step -- */
+
+      dt = Dts->cfl/(res[1]*DIMENSIONS);
+    }
+    itmax = MAX(itmax, MIN(it, runtime->march_maxit));
+  }
+  IBEG = ibeg;
+  IEND = iend;
+
+/* --------------------------------------------------------
+   3. Hand the last shells to the process above and
+      restore all ghost zones
+   -------------------------------------------------------- */
+
+  #ifdef PARALLEL
+  if (grid->rbound[IDIR] == 0){
+    MarchLayer (d, IDIR, IEND - ng + 1, ng, 1, buf, 0);
+    MPI_Send (buf, nbuf, MPI_DOUBLE, right, 0, cart);
+  }
+  MPI_Allreduce (MPI_IN_PLACE, &itmax, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  MPI_Allreduce (MPI_IN_PLACE, &nfail, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Comm_free (&shell_comm);
+  #endif
+  Boundary (d, ALL_DIR, grid);
+
+  print ("  done in %.1f s (cpu), at most %d iterations per shell",
+         (double)(clock() - clock_beg)/CLOCKS_PER_SEC, itmax);
+  if (nfail > 0) print (", %d failed inversions", nfail);
+  print ("\n\n");
+
+  FreeArray1D ((void *) buf);
+  for (n = 0; n < 3; n++) FreeArray1D ((void *) vold[n]);
+}
+
+/* ********************************************************************* */
+int MarchConsToPrim (const Data *d, int i)
+/*!
+ * Convert the active zones of shell i to primitive variables.
+ * Unlike ConsToPrim3D(), the error is not reduced over all processes
+ * (which would stall the pipeline).
+ *
+ * \return the number of zones where the conversion failed.
+ *********************************************************************** */
+{
+  int j, k, nv, err = 0;
+  static double **v;
+  #if MIXED_PRECISION == YES
+  static double **u;
+
+  if (u == NULL) u = ARRAY_2D(NMAX_POINT, NVAR, double);
+  #endif
+
+  if (v == NULL) v = ARRAY_2D(NMAX_POINT, NVAR, double);
+
+  g_dir = IDIR;
+  KDOM_LOOP(k) JDOM_LOOP(j){
+    g_j = j;
+    g_k = k;
+    #if MIXED_PRECISION == YES
+    NVAR_LOOP(nv) u[i][nv] = d->Uc[k][j][i][nv];
+    err += (ConsToPrim (u, v, i, i, d->flag[k][j]) != 0);
+    NVAR_LOOP(nv) d->Uc[k][j][i][nv] = u[i][nv];
+    #else
+    err += (ConsToPrim (d->Uc[k][j], v, i, i, d->flag[k][j]) != 0);
+    #endif
+    NVAR_LOOP(nv) d->Vc[nv][k][j][i] = v[i][nv];
+  }
+  return err;
+}
+
+/* ********************************************************************* */
+void MarchShellBoundary (const Data *d, int i, Grid *grid)
+/*!
+ * Fill the x2 and x3 ghost zones of the shell i: exchange with the
+ * neighbouring processes (periodic included), copy the outermost
+ * zone at outflow boundaries and the zones across the axis at
+ * polaraxis boundaries.
+ *********************************************************************** */
+{
+  int  dir, nv, j, k, l, n, ng, beg, end;
+  static double *sbuf, *rbuf;
+  RBox box;
+  #ifdef PARALLEL
+  int  left, right;
+  MPI_Comm cart;
+  #endif
+
+  if (sbuf == NULL){
+    n    = NVAR*GetNghost()*MAX(NX2_TOT, NX3_TOT);
+    sbuf = ARRAY_1D(n, double);
+    rbuf = ARRAY_1D(n, double);
+  }
+
+  for (dir = JDIR; dir <= KDIR; dir++){
+    ng  = grid->nghost[dir];
+    beg = (dir == JDIR ? JBEG:KBEG);
+    end = (dir == JDIR ? JEND:KEND);
+
+    #ifdef PARALLEL
+    AL_Get_cart_comm (SZ, &cart);
+    MPI_Cart_shift (cart, dir, 1, &left, &right);
+    n = NVAR*ng*(dir == JDIR ? NX3_TOT:NX2_TOT);
+
+    MarchLayer (d, dir, beg, ng, i, sbuf, 0);
+    MPI_Sendrecv (sbuf, n, MPI_DOUBLE, left, 1, rbuf, n, MPI_DOUBLE, right, 1,
+                  cart, MPI_STATUS_IGNORE);
+    if (right != MPI_PROC_NULL) MarchLayer (d, dir, end + 1, ng, i, rbuf, 1);
+
+    MarchLayer (d, dir, end - ng + 1, ng, i, sbuf, 0);
+    MPI_Sendrecv (sbuf, n, MPI_DOUBLE, right, 2, rbuf, n, MPI_DOUBLE, left, 2,
+                  cart, MPI_STATUS_IGNORE);
+    if (left != MPI_PROC_NULL) MarchLayer (d, dir, beg - ng, ng, i, rbuf, 1);
+    #else
+    if (grid->lbound[dir] == PERIODIC){
+      MarchLayer (d, dir, beg, ng, i, sbuf, 0);
+      MarchLayer (d, dir, end + 1, ng, i, sbuf, 1);
+      MarchLayer (d, dir, end - ng + 1, ng, i, sbuf, 0);
+      MarchLayer (d, dir, beg - ng, ng, i, sbuf, 1);
+    }
+    #endif
+
+  /* -- Zero gradient at outflow boundaries -- */
+
+    for (l = 1; l <= ng; l++){
+      NVAR_LOOP(nv){
+        if (dir == JDIR){
+          KTOT_LOOP(k){
+            if (grid->lbound[JDIR] == OUTFLOW) d->Vc[nv][k][beg-l][i] = d->Vc[nv][k][beg][i];
+            if (grid->rbound[JDIR] == OUTFLOW) d->Vc[nv][k][end+l][i] = d->Vc[nv][k][end][i];
+          }
+        }else{
+          JTOT_LOOP(j){
+            if (grid->lbound[KDIR] == OUTFLOW) d->Vc[nv][beg-l][j][i] = d->Vc[nv][beg][j][i];
+            if (grid->rbound[KDIR] == OUTFLOW) d->Vc[nv][end+l][j][i] = d->Vc[nv][end][j][i];
+          }
+        }
+      }
+    }
+  }
+
+/* -- Singular axis, once the x3 ghost zones are set -- */
+
+  if (grid->lbound[JDIR] == POLARAXIS){
+    RBoxDefine (i, i, 0, JBEG-1, 0, NX3_TOT-1, CENTER, &box);
+    PolarAxisBoundary (d, &box, X2_BEG, grid);
+  }
+  if (grid->rbound[JDIR] == POLARAXIS){
+    RBoxDefine (i, i, JEND+1, NX2_TOT-1, 0, NX3_TOT-1, CENTER, &box);
+    PolarAxisBoundary (d, &box, X2_END, grid);
+  }
+}
+
+/* ********************************************************************* */
+void MarchLayer (const Data *d, int dir, int l0, int nl, int i,
+                 double *buf, int unpack)
+/*!
+ * Copy nl layers of zones, starting at index l0 in direction dir,
+ * to buf (unpack = 0) or from buf (unpack = 1).
+ * For dir = IDIR the layers are whole shells; for JDIR and KDIR only
+ * the zones of shell i are copied.
+ *********************************************************************** */
+{
+  int  nv, j, k, l;
+  long n = 0;
+
+  NVAR_LOOP(nv) for (l = l0; l < l0 + nl; l++){
+    if (dir == IDIR){
+      KTOT_LOOP(k) JTOT_LOOP(j){
+        if (unpack) d->Vc[nv][k][j][l] = buf[n++];
+        else        buf[n++] = d->Vc[nv][k][j][l];
+      }
+    }else if (dir == JDIR){
+      KTOT_LOOP(k){
+        if (unpack) d->Vc[nv][k][l][i] = buf[n++];
+        else        buf[n++] = d->Vc[nv][k][l][i];
+      }
+    }else{
+      JTOT_LOOP(j){
+        if (unpack) d->Vc[nv][l][j][i] = buf[n++];
+        else        buf[n++] = d->Vc[nv][l][j][i];
+      }
+    }
+  }
+}
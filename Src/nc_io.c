@@ -0,0 +1,372 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief NetCDF-4 output driver for static grid.
+
+  WriteNetCDF() appends one snapshot of all cell-centered output
+  variables to a single file \c data.nc along an unlimited \c time
+  dimension.
+  Arrays are stored as <tt> var(time, x3, x2, x1) </tt> together with the
+  coordinate variables \c x1, \c x2, \c x3 (zone centers) and \c time.
+
+  In parallel, the file is created through the HDF5-based parallel
+  NetCDF-4 interface and every variable is written collectively by
+  all processors, each one providing its own interior block.
+  When the NetCDF library has no parallel support
+  (\c NC_HAS_PARALLEL4 is 0 in netcdf_meta.h), processors open the
+  file and write their block in turn, which is slower but gives the
+  same file.
+  Chunks span one record, the whole radial (\c x1) extent and the
+  largest angular block owned by a single processor, so that time series
+  at a point or along a radial ray touch one chunk per record and
+  chunk boundaries follow the domain decomposition.
+  When the \c deflate keyword is given in pluto.ini, chunks are
+  compressed with shuffle + deflate (level \c NETCDF_DEFLATE_LEVEL);
+  this requires NetCDF >= 4.7.4 in parallel.
+
+  Precision (\c float or \c double) is selected by the third field of
+  the \c nc output line in pluto.ini:
+  \verbatim
+   nc   0.04166666666666666  -1   float   deflate
+  \endverbatim
+  When restarting, records at or beyond the restart time are
+  overwritten.
+  A record left over from the interrupted run (past the last one
+  written after the restart) cannot be removed from the file: its time
+  is set to the fill value, and the global attribute \c valid_records,
+  updated after every write, gives the number of records that belong
+  to the current run.
+
+  Variables listed in the optional \c nc_bits line (see set_output.c)
+  are rounded to nearest, keeping the given number of mantissa bits,
+  before being written.
+  The trailing zero bits make shuffle + deflate much more effective,
+  while the relative error stays below \f$ 2^{-(n+1)} \f$ for \f$ n \f$
+  bits kept.
+  Restart (.dbl) files are not affected.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include "pluto.h"
+#include <errno.h>
+#include <netcdf.h>
+#include <netcdf_meta.h>
+
+#if defined(PARALLEL) && defined(NC_HAS_PARALLEL4) && NC_HAS_PARALLEL4
+ #include <netcdf_par.h>
+ #define NETCDF_PARALLEL  YES
+#else
+ #define NETCDF_PARALLEL  NO
+#endif
+
+#ifndef NETCDF_DEFLATE_LEVEL
+ #define NETCDF_DEFLATE_LEVEL  1
+#endif
+
+#define NC_CHECK(f)  {int nc_err_ = (f); if (nc_err_ != NC_NOERR) { \
+                       printLog ("! WriteNetCDF(): %s (line %d)\n", \
+                                 nc_strerror(nc_err_), __LINE__);  \
+                       QUIT_PLUTO(1);}}
+
+static void   NetCDF_Append (Output *, char *, Grid *, size_t);
+static void   NetCDF_Define (Output *, char *, Grid *, int *);
+static size_t NetCDF_Start  (Output *, char *, Grid *);
+static double RoundMantissa (double, int);
+static float  RoundMantissaFloat (float, int);
+
+/* ********************************************************************* */
+void WriteNetCDF (Output *output, Grid *grid)
+/*!
+ * Append the current snapshot to the NetCDF file.
+ *
+ * \param [in] output the output structure associated with NetCDF format
+ * \param [in] grid   a pointer to an array of Grid structures
+ *********************************************************************** */
+{
+  char   filename[512];
+  static size_t rec = 0;
+  static int    first_call = 1;
+#if defined(PARALLEL) && NETCDF_PARALLEL == NO
+  int    p;
+#endif
+
+  sprintf (filename, "%s/data.%s", output->dir, output->ext);
+
+/* --------------------------------------------------------
+   1. Create the file (or reopen it on restart) and find
+      the first record being written.
+   -------------------------------------------------------- */
+
+  if (first_call){
+    #if defined(PARALLEL) && NETCDF_PARALLEL == NO
+    if (prank == 0) rec = NetCDF_Start (output, filename, grid);
+    MPI_Bcast (&rec, sizeof(size_t), MPI_BYTE, 0, MPI_COMM_WORLD);
+    #else
+    rec = NetCDF_Start (output, filename, grid);
+    #endif
+    first_call = 0;
+  }
+
+/* --------------------------------------------------------
+   2. Write the record, all processors together or,
+      with a serial library, one after the other.
+   -------------------------------------------------------- */
+
+#if defined(PARALLEL) && NETCDF_PARALLEL == NO
+  for (p = 0; p < g_nprocs; p++){
+    if (p == prank) NetCDF_Append (output, filename, grid, rec);
+    MPI_Barrier (MPI_COMM_WORLD);
+  }
+#else
+  NetCDF_Append (output, filename, grid, rec);
+#endif
+  rec++;
+}
+
+/* ********************************************************************* */
+size_t NetCDF_Start (Output *output, char *filename, Grid *grid)
+/*!
+ * Create the file or, on restart, reopen it and return the first record
+ * to be written.
+ * Records of the interrupted run at or beyond the restart time are
+ * marked stale by setting their time to the fill value.
+ * With a serial library in parallel, only rank 0 calls this function.
+ *********************************************************************** */
+{
+  int    ncid, varid, err;
+  size_t rec = 0, start, count, nrec;
+  double t, tfill = NC_FILL_DOUBLE;
+
+  if (output->nfile == 0) {
+    NetCDF_Define (output, filename, grid, &ncid);
+    NC_CHECK(nc_close(ncid));
+    return 0;
+  }
+
+  #if NETCDF_PARALLEL == YES
+  err = nc_open_par(filename, NC_WRITE, MPI_COMM_WORLD, MPI_INFO_NULL, &ncid);
+  #else
+  err = nc_open(filename, NC_WRITE, &ncid);
+  #endif
+  if (err == ENOENT) {
+    NetCDF_Define (output, filename, grid, &ncid);
+    NC_CHECK(nc_close(ncid));
+    return 0;
+  }
+  NC_CHECK(err);
+
+  NC_CHECK(nc_inq_dimid (ncid, "time", &varid));
+  NC_CHECK(nc_inq_dimlen(ncid, varid, &nrec));
+  NC_CHECK(nc_inq_varid (ncid, "time", &varid));
+  for (rec = 0; rec < nrec; rec++){
+    NC_CHECK(nc_get_var1_double(ncid, varid, &rec, &t));
+    if (t >= g_time*(1.0 - 1.e-12)) break;
+  }
+  #if NETCDF_PARALLEL == YES
+  NC_CHECK(nc_var_par_access(ncid, varid, NC_COLLECTIVE));
+  #endif
+  for (start = rec; start < nrec; start++){  /* Mark them stale */
+    count = (prank == 0);
+    NC_CHECK(nc_put_vara_double(ncid, varid, &start, &count, &tfill));
+  }
+  NC_CHECK(nc_close(ncid));
+  return rec;
+}
+
+/* ********************************************************************* */
+void NetCDF_Append (Output *output, char *filename, Grid *grid, size_t rec)
+/*!
+ * Open the file, write record \c rec and update \c valid_records.
+ *********************************************************************** */
+{
+  int    nv, ncid, varid, i, j, k, n, bits, nvalid;
+  int    single = strcmp(output->mode, "double");
+  size_t start[4], count[4];
+  double units[MAX_OUTPUT_VARS];
+  static float  *fbuf;
+  static double *dbuf;
+
+  if (single && fbuf == NULL)  fbuf = ARRAY_1D(NX1*NX2*NX3, float);
+  if (!single && dbuf == NULL) dbuf = ARRAY_1D(NX1*NX2*NX3, double);
+
+  for (nv = 0; nv < MAX_OUTPUT_VARS; nv++) units[nv] = 1.0;
+  if (output->cgs) GetCGSUnits(units);
+
+  #if NETCDF_PARALLEL == YES
+  NC_CHECK(nc_open_par(filename, NC_WRITE, MPI_COMM_WORLD, MPI_INFO_NULL, &ncid));
+  #else
+  NC_CHECK(nc_open(filename, NC_WRITE, &ncid));
+  #endif
+
+/* --------------------------------------------------------
+   1. Write time (rank 0 only, but collectively)
+   -------------------------------------------------------- */
+
+  NC_CHECK(nc_inq_varid (ncid, "time", &varid));
+  #if NETCDF_PARALLEL == YES
+  NC_CHECK(nc_var_par_access(ncid, varid, NC_COLLECTIVE));
+  #endif
+  start[0] = rec;
+  count[0] = (prank == 0);
+  NC_CHECK(nc_put_vara_double(ncid, varid, start, count, &g_time));
+
+/* --------------------------------------------------------
+   2. Write cell-centered variables, one interior block
+      per processor.
+   -------------------------------------------------------- */
+
+  start[0] = rec;
+  start[1] = grid->beg[KDIR] - grid->gbeg[KDIR];
+  start[2] = grid->beg[JDIR] - grid->gbeg[JDIR];
+  start[3] = grid->beg[IDIR] - grid->gbeg[IDIR];
+  count[0] = 1;
+  count[1] = NX3;
+  count[2] = NX2;
+  count[3] = NX1;
+
+  for (nv = 0; nv < output->nvar; nv++){
+    if (!output->dump_var[nv] || output->stag_var[nv] != -1) continue;
+
+    NC_CHECK(nc_inq_varid (ncid, output->var_name[nv], &varid));
+    #if NETCDF_PARALLEL == YES
+    NC_CHECK(nc_var_par_access(ncid, varid, NC_COLLECTIVE));
+    #endif
+
+    n    = 0;
+    bits = output->nbits[nv];
+    if (single){
+      DOM_LOOP(k,j,i) fbuf[n++] = (float)(output->V[nv][k][j][i]*units[nv]);
+      if (bits > 0) for (n = 0; n < NX1*NX2*NX3; n++){
+        fbuf[n] = RoundMantissaFloat (fbuf[n], bits);
+      }
+      NC_CHECK(nc_put_vara_float (ncid, varid, start, count, fbuf));
+    }else{
+      DOM_LOOP(k,j,i) dbuf[n++] = output->V[nv][k][j][i]*units[nv];
+      if (bits > 0) for (n = 0; n < NX1*NX2*NX3; n++){
+        dbuf[n] = RoundMantissa (dbuf[n], bits);
+      }
+      NC_CHECK(nc_put_vara_double (ncid, varid, start, count, dbuf));
+    }
+  }
+
+/* --------------------------------------------------------
+   3. Number of valid records (later ones are stale)
+   -------------------------------------------------------- */
+
+  nvalid = (int)rec + 1;
+  NC_CHECK(nc_put_att_int(ncid, NC_GLOBAL, "valid_records", NC_INT, 1, &nvalid));
+  NC_CHECK(nc_close(ncid));
+}
+
+/* ********************************************************************* */
+void NetCDF_Define (Output *output, char *filename, Grid *grid, int *ncid)
+/*!
+ * Create the NetCDF file, define dimensions, variables and chunking,
+ * and write coordinates.
+ *********************************************************************** */
+{
+  int    nv, dir, ngl, varid, dimid[4], cdim[3];
+  char   *dname[] = {"x1", "x2", "x3"}, *geom;
+  size_t chunk[4], start, count;
+  nc_type xtype = (strcmp(output->mode, "double") ? NC_FLOAT:NC_DOUBLE);
+
+  #if NETCDF_PARALLEL == YES
+  NC_CHECK(nc_create_par(filename, NC_NETCDF4|NC_CLOBBER, MPI_COMM_WORLD,
+                         MPI_INFO_NULL, ncid));
+  #else
+  NC_CHECK(nc_create(filename, NC_NETCDF4|NC_CLOBBER, ncid));
+  #endif
+
+/* -- Dimensions and coordinate variables -- */
+
+  NC_CHECK(nc_def_dim(*ncid, "time", NC_UNLIMITED, dimid));
+  NC_CHECK(nc_def_var(*ncid, "time", NC_DOUBLE, 1, dimid, &varid));
+  for (dir = 0; dir < 3; dir++){
+    NC_CHECK(nc_def_dim(*ncid, dname[dir], grid->np_int_glob[dir],
+                        dimid + 3 - dir));
+    NC_CHECK(nc_def_var(*ncid, dname[dir], NC_DOUBLE, 1, dimid + 3 - dir,
+                        cdim + dir));
+  }
+  #if GEOMETRY == CARTESIAN
+  geom = "cartesian";
+  #elif GEOMETRY == CYLINDRICAL
+  geom = "cylindrical";
+  #elif GEOMETRY == POLAR
+  geom = "polar";
+  #elif GEOMETRY == SPHERICAL
+  geom = "spherical";
+  #endif
+  NC_CHECK(nc_put_att_text(*ncid, NC_GLOBAL, "geometry", strlen(geom), geom));
+  NC_CHECK(nc_put_att_text(*ncid, NC_GLOBAL, "units",
+           output->cgs ? 3:4, output->cgs ? "cgs":"code"));
+
+/* -- Chunks: one record, full x1 extent, largest angular block -- */
+
+  chunk[0] = 1;
+  chunk[1] = (grid->np_int_glob[KDIR] + grid->nproc[KDIR] - 1)/grid->nproc[KDIR];
+  chunk[2] = (grid->np_int_glob[JDIR] + grid->nproc[JDIR] - 1)/grid->nproc[JDIR];
+  chunk[3] = grid->np_int_glob[IDIR];
+
+  for (nv = 0; nv < output->nvar; nv++){
+    if (!output->dump_var[nv] || output->stag_var[nv] != -1) continue;
+    NC_CHECK(nc_def_var(*ncid, output->var_name[nv], xtype, 4, dimid, &varid));
+    NC_CHECK(nc_def_var_chunking(*ncid, varid, NC_CHUNKED, chunk));
+    if (output->deflate){
+      NC_CHECK(nc_def_var_deflate(*ncid, varid, NC_SHUFFLE, 1,
+                                  NETCDF_DEFLATE_LEVEL));
+    }
+  }
+  NC_CHECK(nc_enddef(*ncid));
+
+/* -- Coordinates are written by rank 0 -- */
+
+  for (dir = 0; dir < 3; dir++){
+    ngl   = grid->gbeg[dir];
+    start = 0;
+    count = (prank == 0 ? grid->np_int_glob[dir]:0);
+    #if NETCDF_PARALLEL == YES
+    NC_CHECK(nc_var_par_access(*ncid, cdim[dir], NC_COLLECTIVE));
+    #endif
+    NC_CHECK(nc_put_vara_double(*ncid, cdim[dir], &start, &count,
+                                grid->x_glob[dir] + ngl));
+  }
+}
+
+/* ********************************************************************* */
+double RoundMantissa (double x, int nbits)
+/*!
+ * Round x to nearest keeping nbits explicit mantissa bits
+ * (out of 52); the remaining bits are set to zero.
+ * A carry out of the mantissa correctly increments the exponent.
+ * Infinities and NaNs are returned unchanged.
+ *********************************************************************** */
+{
+  int      drop = 52 - nbits;
+  uint64_t u;
+
+  if (drop <= 0 || !isfinite(x)) return x;
+  memcpy (&u, &x, sizeof(u));
+  u += (uint64_t)1 << (drop - 1);
+  u &= ~(((uint64_t)1 << drop) - 1);
+  memcpy (&x, &u, sizeof(u));
+  return x;
+}
+
+/* ********************************************************************* */
+float RoundMantissaFloat (float x, int nbits)
+/*!
+ * Same as RoundMantissa() for single precision (23 mantissa bits).
+ *********************************************************************** */
+{
+  int      drop = 23 - nbits;
+  uint32_t u;
+
+  if (drop <= 0 || !isfinite(x)) return x;
+  memcpy (&u, &x, sizeof(u));
+  u += (uint32_t)1 << (drop - 1);
+  u &= ~(((uint32_t)1 << drop) - 1);
+  memcpy (&x, &u, sizeof(u));
+  return x;
+}
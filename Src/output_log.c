@@ -271,7 +271,11 @@ void printLog (const char *fmt, ...)
   #if MULTIPLE_LOG_FILES == NO
   if (g_flog == NULL)  g_flog = fopen(log_file_name, "a");
   #endif
-  vfprintf(g_flog, fmt, args);
+
+  /* -- log not opened yet (e.g. during RuntimeSetup()) -- */
+
+  if (g_flog == NULL) vprintf(fmt, args);
+  else                vfprintf(g_flog, fmt, args);
 #else
   vprintf(fmt, args);
 #endif
@@ -69,6 +69,8 @@
 #define SEMI_IMPLICIT             10  /* -- Used for dust time stepping -- */
 #define RK_MIDPOINT               11
 #define RK4                       12
+#define SSP_RK_LS                 13  /* -- Low-storage SSP Runge-Kutta -- */
+#define MUSCL_HANCOCK             14  /* -- Unsplit single-stage MUSCL-Hancock -- */
 
 #define EXPLICIT             1 /* -- just a number different from 0 !!!  -- */
 #define SUPER_TIME_STEPPING  2 /* -- just a number different from EXPLICIT -- */ 
@@ -87,6 +89,9 @@
 #define TAB_OUTPUT      6
 #define PPM_OUTPUT      7
 #define PNG_OUTPUT      8
+#define NETCDF_OUTPUT   14
+#define VTS_OUTPUT      15
+#define PYR_OUTPUT      16
 
 #define PARTICLES_DBL_OUTPUT  9
 #define PARTICLES_FLT_OUTPUT  10
@@ -545,6 +550,26 @@
   #define CTU      1    /* -- Corner Transport Upwind method of Colella -- */
 #endif
 
+/* -- Number of stages and order of low-storage SSP Runge-Kutta.
+      Supported combinations are (stages >= 2, order 2),
+      (3, 3) and (4, 3). See rk_step.c                          -- */
+
+#if TIME_STEPPING == SSP_RK_LS
+ #ifndef SSP_RK_LS_STAGES
+  #define SSP_RK_LS_STAGES   2
+ #endif
+ #ifndef SSP_RK_LS_ORDER
+  #define SSP_RK_LS_ORDER    2
+ #endif
+#endif
+
+/* -- Number of time-step levels of radial shells (multirate.c).
+      With 1, all zones are advanced with the same time step -- */
+
+#ifndef MULTIRATE_LEVELS
+ #define MULTIRATE_LEVELS    1
+#endif
+
 /* -- Select Primitive / Conservative form of Hancock scheme -- */
 
 #if TIME_STEPPING == HANCOCK 
@@ -582,6 +607,36 @@
  #define PARABOLIC_FLUX NO
 #endif
 
+/* ********************************************************
+    Storage precision of the solution arrays.
+    With MIXED_PRECISION == YES the zone-centered arrays
+    d->Vc and d->Uc, and every other Data_Arr (e.g. the
+    U0 register of the RK integrators), are held in single
+    precision.
+    They are widened to double when copied into the 1D
+    sweep arrays, so that reconstruction, Riemann solvers
+    and source terms are still computed in double, and are
+    rounded once when the update is written back.
+   ******************************************************** */
+
+#ifndef MIXED_PRECISION
+ #define MIXED_PRECISION  NO
+#endif
+
+#if MIXED_PRECISION == YES
+ #if (DIVB_CONTROL == CONSTRAINED_TRANSPORT) || PARTICLES || RADIATION \
+     || (PARABOLIC_FLUX != NO) || (COOLING != NO) || (defined FARGO)   \
+     || (defined SHEARINGBOX) || (defined CTU)                         \
+     || (TIME_STEPPING == MUSCL_HANCOCK)
+  #error MIXED_PRECISION: only for cell-centered MHD/HD without diffusion, \
+         cooling, particles or FARGO and with RK time stepping
+ #endif
+ typedef float  Data_Type;
+#else
+ typedef double Data_Type;
+#endif
+typedef Data_Type ****Data_Arr;
+
 /* ********************************************************
     Include more header files
    ******************************************************** */
@@ -605,7 +660,6 @@
 typedef void Riemann_Solver (const Sweep *, int, int, double *, Grid *);
 typedef void Limiter        (double *, double *, double *, int, int, Grid *);
 typedef double Reconstruct  (double *, double, int);
-typedef double ****Data_Arr;
 
 /* ********************************************************
     Include physics module header files
@@ -869,7 +923,7 @@ extern double g_smallDensity, g_smallPressure;
 extern double g_time, g_dt;
 extern double g_maxMach;
 #if ROTATING_FRAME
- extern double g_OmegaZ;
+ extern double g_OmegaZ, g_OmegaZout, g_tOmegaZout, g_OmegaZsteady;
 #endif
 
 extern double g_domBeg[3], g_domEnd[3];
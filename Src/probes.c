@@ -0,0 +1,504 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Virtual spacecraft probes.
+
+  Sample primitive variables at a set of fixed or moving points and
+  write one ascii time series per probe.
+  Probes are defined in the optional <tt> [Probes] </tt> section of
+  pluto.ini:
+  \verbatim
+   probes       -1.0   1   cgs      # dt  dn  [cgs]
+   probe_buffer  64                 # samples kept in memory
+   probe_phi0    0.0                # longitude of the HEEQ x-axis (deg)
+   probe1  earth    fixed   1.0  0.0  0.0
+   probe2  stereoa  table   ./ephem/stereoa.txt
+  \endverbatim
+  The first line gives the sampling cadence in the same way as
+  \c analysis: a time interval \c dt and/or a step interval \c dn
+  (\c dn = 1 samples every step).
+  Each probe is given a name and either a \c fixed position or a
+  \c table file with (at least) four columns <tt> t  x1  x2  x3 </tt>;
+  positions are linearly interpolated in time and clamped at the ends
+  of the table.
+  In spherical geometry positions are HEEQ \f$(r,\,{\rm lat},\,{\rm lon})\f$
+  with angles in degrees and they are mapped to
+  \f$\theta = 90 - {\rm lat}\f$,
+  \f$\phi = {\rm lon} + \phi_0 - \Delta\phi(t)\f$, where
+  \f$\Delta\phi\f$ is the angle between the computational frame and
+  HEEQ (see OutputFrameAngle());
+  otherwise they are taken as grid coordinates \f$(x_1,x_2,x_3)\f$.
+  Time and radius are in code units.
+
+  At each sample, variables are linearly interpolated in each
+  coordinate direction from the eight surrounding zone centers.
+  Since ghost zones are not up to date between steps, every process
+  adds the contribution of the corners lying in its own interior and
+  the result is summed on rank 0, which buffers it and appends it
+  to <tt> output_dir/probe.<name>.dat </tt> every \c probe_buffer samples.
+  On restart, samples at or after the restart time are first removed
+  from the files.
+  Velocities are given in the output frame (HEEQ), i.e. the rotation
+  velocity \f$\Omega_{\rm out} r\sin\theta\f$ of the computational
+  frame and, with FARGO, the mean orbital velocity are added to
+  \f$v_\phi\f$; the \c x3 column is the grid longitude of the sample.
+  Temperature is given in Kelvin; the remaining quantities are in
+  code units or, if \c cgs is given, in c.g.s units.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include "pluto.h"
+
+#define MAX_PROBES   32
+#define PROBE_NCOL   (4 + NVAR)   /* t, x1, x2, x3, v[NVAR] */
+
+typedef struct Probe_{
+  char   name[64];
+  int    ntab;       /**< Number of table rows (0 for a fixed probe) */
+  double x[3];       /**< Fixed position */
+  double *t, *xt[3]; /**< Ephemeris table */
+} Probe;
+
+static Probe  probe[MAX_PROBES];
+static int    nprobes = 0;
+static int    probe_dn, nbuf, nsample = 0, cgs, append;
+static double probe_dt, probe_tstop, phi0;
+static double ***buf;
+static char   probe_dir[256];
+static int    periodic[3];
+
+static void ProbeReadTable (Probe *, char *);
+static void ProbeRestart   (Probe *);
+static void ProbePosition  (Probe *, double, double *);
+static void ProbeLocate    (double, int, int, Grid *, int *, double *);
+
+/* ********************************************************************* */
+void ProbesInit (Runtime *runtime, cmdLine *cmd_line, Grid *grid)
+/*!
+ * Read the <tt> [Probes] </tt> section of the initialization file
+ * (already parsed on rank 0) and broadcast the probe settings.
+ *
+ * \param [in] runtime   pointer to a Runtime structure
+ * \param [in] cmd_line  pointer to a cmdLine structure
+ * \param [in] grid      pointer to an array of Grid structures
+ *********************************************************************** */
+{
+  int  n, dir;
+  char label[32], *str;
+
+  if (prank == 0 && ParamExist("probes")){
+    probe_dt = atof(ParamFileGet("probes", 1));
+    probe_dn = atoi(ParamFileGet("probes", 2));
+    cgs      = ParamFileHasBoth ("probes", "cgs");
+    nbuf     = 64;
+    phi0     = 0.0;
+    if (ParamExist("probe_buffer")) nbuf = atoi(ParamFileGet("probe_buffer",1));
+    if (ParamExist("probe_phi0"))   phi0 = atof(ParamFileGet("probe_phi0",1));
+    nbuf = MAX(nbuf, 1);
+    phi0 *= CONST_PI/180.0;
+
+    for (n = 0; n < MAX_PROBES; n++){
+      sprintf (label, "probe%d", n + 1);
+      if (!ParamExist(label)) break;
+      strcpy (probe[n].name, ParamFileGet(label, 1));
+      str = ParamFileGet(label, 2);
+      if (strcmp(str, "fixed") == 0){
+        probe[n].ntab = 0;
+        for (dir = 0; dir < 3; dir++){
+          probe[n].x[dir] = atof(ParamFileGet(label, 3 + dir));
+        }
+      }else if (strcmp(str, "table") == 0){
+        ProbeReadTable (probe + n, ParamFileGet(label, 3));
+      }else{
+        printLog ("! ProbesInit(): expecting 'fixed' or 'table' for %s\n",
+                  label);
+        QUIT_PLUTO(1);
+      }
+    }
+    nprobes = n;
+  }
+
+  #ifdef PARALLEL
+  MPI_Bcast (&nprobes,  1, MPI_INT,    0, MPI_COMM_WORLD);
+  MPI_Bcast (&probe_dn, 1, MPI_INT,    0, MPI_COMM_WORLD);
+  MPI_Bcast (&probe_dt, 1, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  #endif
+  if (nprobes == 0) return;
+
+  probe_tstop = runtime->tstop;
+  for (dir = 0; dir < 3; dir++) {
+    periodic[dir] = (runtime->left_bound[dir] == PERIODIC);
+  }
+
+  if (prank == 0){
+    buf    = ARRAY_3D(nprobes, nbuf, PROBE_NCOL, double);
+    append = cmd_line->restart || cmd_line->h5restart;
+    strcpy (probe_dir, runtime->output_dir);
+    print ("> Probes:\n");
+    for (n = 0; n < nprobes; n++){
+      if (probe[n].ntab > 0) {
+        print ("  %-12s table (%d rows)\n", probe[n].name, probe[n].ntab);
+      }else{
+        print ("  %-12s (%g, %g, %g)\n", probe[n].name,
+               probe[n].x[0], probe[n].x[1], probe[n].x[2]);
+      }
+    }
+    print ("\n");
+  }
+}
+
+/* ********************************************************************* */
+void ProbesSample (const Data *d, Grid *grid)
+/*!
+ * Interpolate primitive variables at the current probe positions if
+ * the sampling cadence has been reached.
+ * Must be called by all processes.
+ *
+ * \param [in] d     pointer to the PLUTO Data structure
+ * \param [in] grid  pointer to an array of Grid structures
+ *********************************************************************** */
+{
+  int    n, nv, dir, c, check_dt, check_dn;
+  int    ind[3][2], i, j, k;
+  double w[3][2], wc, tnext;
+  static double **x, **v, **vsum;
+  static int first_call = 1;
+  #ifdef FARGO
+  double **wA = FARGO_Velocity();
+  #endif
+
+  if (nprobes == 0) return;
+
+  if (first_call){
+    if (prank == 0 && append) for (n = 0; n < nprobes; n++) ProbeRestart (probe + n);
+    first_call = 0;
+  }
+
+/* --------------------------------------------------------
+   0. Check cadence (same as Analysis())
+   -------------------------------------------------------- */
+
+  tnext    = g_time + g_dt;
+  check_dt = (int)(tnext/probe_dt) - (int)(g_time/probe_dt);
+  check_dt = check_dt || g_stepNumber == 0
+                      || fabs(g_time - probe_tstop) < 1.e-9;
+  check_dt = check_dt && (probe_dt > 0.0);
+
+  check_dn = (probe_dn > 0) && (g_stepNumber%probe_dn) == 0;
+
+  if (!(check_dt || check_dn)) return;
+
+  if (x == NULL){
+    x    = ARRAY_2D(nprobes, 3, double);
+    v    = ARRAY_2D(nprobes, NVAR, double);
+    vsum = ARRAY_2D(nprobes, NVAR, double);
+  }
+
+/* --------------------------------------------------------
+   1. Get probe positions in grid coordinates
+   -------------------------------------------------------- */
+
+  if (prank == 0){
+    for (n = 0; n < nprobes; n++) ProbePosition (probe + n, g_time, x[n]);
+  }
+  #ifdef PARALLEL
+  MPI_Bcast (x[0], 3*nprobes, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+  #endif
+
+/* --------------------------------------------------------
+   2. Add contributions from corners owned by this process
+   -------------------------------------------------------- */
+
+  for (n = 0; n < nprobes; n++){
+    for (dir = 0; dir < 3; dir++){
+      ProbeLocate (x[n][dir], dir, periodic[dir], grid, ind[dir], w[dir]);
+    }
+
+    NVAR_LOOP(nv) v[n][nv] = 0.0;
+    for (c = 0; c < 8; c++){
+      i  = ind[IDIR][c & 1];
+      j  = ind[JDIR][(c >> 1) & 1];
+      k  = ind[KDIR][(c >> 2) & 1];
+      wc = w[IDIR][c & 1]*w[JDIR][(c >> 1) & 1]*w[KDIR][(c >> 2) & 1];
+      if (wc == 0.0) continue;
+
+      if (   i < grid->beg[IDIR] || i > grid->end[IDIR]
+          || j < grid->beg[JDIR] || j > grid->end[JDIR]
+          || k < grid->beg[KDIR] || k > grid->end[KDIR]) continue;
+
+      i += grid->lbeg[IDIR] - grid->beg[IDIR];
+      j += grid->lbeg[JDIR] - grid->beg[JDIR];
+      k += grid->lbeg[KDIR] - grid->beg[KDIR];
+      NVAR_LOOP(nv) v[n][nv] += wc*d->Vc[nv][k][j][i];
+      #ifdef FARGO
+      v[n][VX1+SDIR] += wc*FARGO_VELOCITY3D(wA,i,j,k);
+      #endif
+    }
+  }
+
+  #ifdef PARALLEL
+  MPI_Reduce (v[0], vsum[0], nprobes*NVAR, MPI_DOUBLE, MPI_SUM,
+              0, MPI_COMM_WORLD);
+  #else
+  for (n = 0; n < nprobes; n++) NVAR_LOOP(nv) vsum[n][nv] = v[n][nv];
+  #endif
+
+/* --------------------------------------------------------
+   3. Store in buffer and flush if full
+   -------------------------------------------------------- */
+
+  if (prank != 0) return;
+
+  for (n = 0; n < nprobes; n++){
+    buf[n][nsample][0] = g_time;
+    for (dir = 0; dir < 3; dir++) buf[n][nsample][1 + dir] = x[n][dir];
+    NVAR_LOOP(nv) buf[n][nsample][4 + nv] = vsum[n][nv];
+    #if (ROTATING_FRAME == YES) && (GEOMETRY == SPHERICAL)
+    buf[n][nsample][4 + VX3] += g_OmegaZout*x[n][0]*sin(x[n][1]);
+    #endif
+  }
+  nsample++;
+  if (nsample == nbuf) ProbesFlush();
+}
+
+/* ********************************************************************* */
+void ProbesFlush (void)
+/*!
+ * Append buffered samples to the probe files.
+ * Only rank 0 holds data; it is safe to call from any process.
+ *********************************************************************** */
+{
+  int    n, s, nv, dir;
+  char   fname[512];
+  double *b, T, u[NVAR];
+  FILE  *fp;
+
+  if (prank != 0 || nprobes == 0) return;
+
+  NVAR_LOOP(nv) u[nv] = 1.0;
+  if (cgs) GetCGSUnits(u);
+
+  for (n = 0; n < nprobes; n++){
+    sprintf (fname, "%.256s/probe.%.63s.dat", probe_dir, probe[n].name);
+    fp = fopen (fname, append ? "a":"w");
+    if (fp == NULL){
+      printLog ("! ProbesFlush(): cannot open %s\n", fname);
+      QUIT_PLUTO(1);
+    }
+
+    if (!append){
+      fprintf (fp, "# probe %s [%s units, T in K]\n", probe[n].name,
+                   cgs ? "cgs":"code");
+      fprintf (fp, "# %-12s %-12s %-12s %-12s %-12s",
+                   "t", "x1", "x2", "x3", "rho");
+      fprintf (fp, " %-12s %-12s %-12s", "vx1", "vx2", "vx3");
+      #if HAVE_ENERGY
+      fprintf (fp, " %-12s", "T");
+      #endif
+      #if PHYSICS == MHD
+      fprintf (fp, " %-12s %-12s %-12s", "Bx1", "Bx2", "Bx3");
+      #endif
+      fprintf (fp, "\n");
+    }
+
+    for (s = 0; s < nsample; s++){
+      b = buf[n][s];
+      fprintf (fp, "  %12.6e", b[0]);
+      for (dir = 0; dir < 3; dir++) fprintf (fp, " %12.6e", b[1 + dir]);
+      fprintf (fp, " %12.6e", b[4 + RHO]*u[RHO]);
+      fprintf (fp, " %12.6e %12.6e %12.6e", b[4 + VX1]*u[VX1],
+                   b[4 + VX2]*u[VX2], b[4 + VX3]*u[VX3]);
+      #if HAVE_ENERGY
+      T = b[4 + PRS]/b[4 + RHO]*KELVIN*MeanMolecularWeight(b + 4);
+      fprintf (fp, " %12.6e", T);
+      #endif
+      #if PHYSICS == MHD
+      fprintf (fp, " %12.6e %12.6e %12.6e", b[4 + BX1]*u[BX1],
+                   b[4 + BX2]*u[BX2], b[4 + BX3]*u[BX3]);
+      #endif
+      fprintf (fp, "\n");
+    }
+    fclose (fp);
+  }
+
+  nsample = 0;
+  append  = 1;
+}
+
+/* ********************************************************************* */
+void ProbeRestart (Probe *p)
+/*!
+ * On restart, drop samples of the probe file at or after the current
+ * time, so that the time series has no duplicates when it is appended
+ * again (as for slices, see SliceRestart()).
+ *********************************************************************** */
+{
+  int    n, nkeep = 0, nlines = 0;
+  char   fname[512], line[1024], **kept = NULL;
+  double t;
+  FILE   *fp;
+
+  sprintf (fname, "%.256s/probe.%.63s.dat", probe_dir, p->name);
+  fp = fopen (fname, "r");
+  if (fp == NULL) return;
+
+  while (fgets(line, 1024, fp) != NULL) nlines++;
+  rewind (fp);
+  if (nlines > 0) kept = ARRAY_2D(nlines, 1024, char);
+  while (fgets(line, 1024, fp) != NULL){
+    if (line[0] != '#'){
+      if (sscanf (line, "%lf", &t) != 1) continue;
+      if (t >= g_time*(1.0 - 1.e-6)) break;   /* t has 7 digits */
+    }
+    strcpy (kept[nkeep++], line);
+  }
+  fclose (fp);
+
+  fp = fopen (fname, "w");
+  if (fp == NULL){
+    printLog ("! ProbeRestart(): cannot open %s\n", fname);
+    QUIT_PLUTO(1);
+  }
+  for (n = 0; n < nkeep; n++) fprintf (fp, "%s", kept[n]);
+  fclose (fp);
+  if (kept != NULL) FreeArray2D ((void *) kept);
+}
+
+/* ********************************************************************* */
+void ProbeReadTable (Probe *p, char *fname)
+/*!
+ * Read an ephemeris table with columns <tt> t x1 x2 x3 </tt>.
+ * Lines starting with '#' are skipped.
+ *********************************************************************** */
+{
+  int   n, nmax = 0;
+  char  line[512];
+  double t, x1, x2, x3;
+  FILE *fp;
+
+  fp = fopen (fname, "r");
+  if (fp == NULL){
+    printLog ("! ProbeReadTable(): cannot open %s\n", fname);
+    QUIT_PLUTO(1);
+  }
+  while (fgets(line, 512, fp) != NULL) nmax++;
+  rewind (fp);
+
+  p->t = ARRAY_1D(nmax, double);
+  for (n = 0; n < 3; n++) p->xt[n] = ARRAY_1D(nmax, double);
+
+  n = 0;
+  while (fgets(line, 512, fp) != NULL){
+    if (line[0] == '#') continue;
+    if (sscanf (line, "%lf %lf %lf %lf", &t, &x1, &x2, &x3) != 4) continue;
+    if (n > 0 && t <= p->t[n-1]){
+      printLog ("! ProbeReadTable(): time must increase in %s\n", fname);
+      QUIT_PLUTO(1);
+    }
+    p->t[n] = t;
+    p->xt[0][n] = x1; p->xt[1][n] = x2; p->xt[2][n] = x3;
+    n++;
+  }
+  fclose (fp);
+
+  if (n == 0){
+    printLog ("! ProbeReadTable(): no data in %s\n", fname);
+    QUIT_PLUTO(1);
+  }
+  p->ntab = n;
+}
+
+/* ********************************************************************* */
+void ProbePosition (Probe *p, double t, double *x)
+/*!
+ * Compute the probe position at time t in grid coordinates.
+ *********************************************************************** */
+{
+  int    n, dir;
+  double s, dlon, xp[3];
+
+/* -- Fixed position or linear interpolation in time -- */
+
+  if (p->ntab == 0){
+    for (dir = 0; dir < 3; dir++) xp[dir] = p->x[dir];
+  }else if (t <= p->t[0] || p->ntab == 1){
+    for (dir = 0; dir < 3; dir++) xp[dir] = p->xt[dir][0];
+  }else if (t >= p->t[p->ntab-1]){
+    for (dir = 0; dir < 3; dir++) xp[dir] = p->xt[dir][p->ntab-1];
+  }else{
+    n = 0;
+    while (p->t[n+1] < t) n++;
+    s = (t - p->t[n])/(p->t[n+1] - p->t[n]);
+    for (dir = 0; dir < 3; dir++) {
+      xp[dir] = p->xt[dir][n] + s*(p->xt[dir][n+1] - p->xt[dir][n]);
+    }
+    #if GEOMETRY == SPHERICAL     /* -- Longitude may wrap around -- */
+    dlon  = p->xt[2][n+1] - p->xt[2][n];
+    dlon -= 360.0*floor((dlon + 180.0)/360.0);
+    xp[2] = p->xt[2][n] + s*dlon;
+    #endif
+  }
+
+/* -- Convert HEEQ (r, lat, lon) to (r, theta, phi) -- */
+
+  #if GEOMETRY == SPHERICAL
+  x[0] = xp[0];
+  x[1] = (90.0 - xp[1])*CONST_PI/180.0;
+  x[2] = xp[2]*CONST_PI/180.0 + phi0 - OutputFrameAngle(t);
+  #else
+  for (dir = 0; dir < 3; dir++) x[dir] = xp[dir];
+  #endif
+}
+
+/* ********************************************************************* */
+void ProbeLocate (double x, int dir, int is_periodic, Grid *grid,
+                  int *ind, double *w)
+/*!
+ * Find the global indices of the two zone centers bracketing x in
+ * direction dir and the corresponding linear weights.
+ * Outside the range of zone centers the nearest value is used or,
+ * in periodic directions, the domain wraps around.
+ *********************************************************************** */
+{
+  int    il, ir, ic;
+  int    gbeg = grid->gbeg[dir], gend = grid->gend[dir];
+  double *xg = grid->x_glob[dir];
+  double L, xl, xr;
+
+  if (gbeg == gend){           /* -- Direction not included -- */
+    ind[0] = ind[1] = gbeg;
+    w[0] = 1.0; w[1] = 0.0;
+    return;
+  }
+
+  if (is_periodic){
+    L  = grid->xend_glob[dir] - grid->xbeg_glob[dir];
+    x -= L*floor((x - grid->xbeg_glob[dir])/L);
+    if (x < xg[gbeg] || x >= xg[gend]){
+      xl = (x < xg[gbeg] ? xg[gend] - L:xg[gend]);
+      xr = (x < xg[gbeg] ? xg[gbeg]:xg[gbeg] + L);
+      ind[0] = gend; ind[1] = gbeg;
+      w[1] = (x - xl)/(xr - xl);
+      w[0] = 1.0 - w[1];
+      return;
+    }
+  }else if (x <= xg[gbeg] || x >= xg[gend]){
+    ind[0] = ind[1] = (x <= xg[gbeg] ? gbeg:gend);
+    w[0] = 1.0; w[1] = 0.0;
+    return;
+  }
+
+/* -- Bisection on zone centers -- */
+
+  il = gbeg; ir = gend;
+  while (ir - il > 1){
+    ic = (il + ir)/2;
+    if (x < xg[ic]) ir = ic;
+    else            il = ic;
+  }
+  ind[0] = il; ind[1] = ir;
+  w[1] = (x - xg[il])/(xg[ir] - xg[il]);
+  w[0] = 1.0 - w[1];
+}
@@ -0,0 +1,161 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Start a run from the result of a run on a coarser grid.
+
+  ProlongFromFile() replaces the initial condition by the content of a
+  \c .dbl file written by another run, usually on a grid 2 or 4 times
+  coarser, so that most of the spin-up can be done at a fraction of the
+  cost and only a short relaxation is left at full resolution.
+  It is enabled by the optional \c prolong line in the
+  <tt> [Time] </tt> section of pluto.ini:
+  \verbatim
+   prolong   ./out_c   9
+  \endverbatim
+  giving the output directory of the coarse run and the number of the
+  \c .dbl file. The file is located through \c dbl.out (which gives
+  time, variable names, endianity and file mode) and \c grid.out of that
+  directory.
+
+  Every variable is prolonged with InputDataProlong(): the volume
+  average over each zone of a limited linear reconstruction, which
+  conserves mass, magnetic flux and thermal energy. Velocities are
+  weighted with density, so that momentum is conserved too.
+  Each process reads only the x3 planes it needs.
+
+  The run then starts at the time of the file and output numbers are
+  those of a run started at <tt> t = 0 </tt>, so that files are
+  numbered as in a single run on the fine grid.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include "pluto.h"
+
+#define PROLONG_NVAR_MAX  64
+
+/* ********************************************************************* */
+void ProlongFromFile (Data *d, Runtime *runtime, Grid *grid)
+/*!
+ * Replace the primitive variables with those of a \c .dbl file of a
+ * (coarser) run and set the initial time. Must be called by all
+ * processes.
+ *
+ * \param [in,out] d        pointer to the PLUTO Data structure
+ * \param [in,out] runtime  pointer to a Runtime structure
+ * \param [in]     grid     pointer to an array of Grid structures
+ *********************************************************************** */
+{
+  int    nv, n, nin = 0, nfile, nstep, found = 0, size[3];
+  int    hv[NVAR], hrho;
+  char   fname[512], gname[512], line[4096], mode[64], endianity[64];
+  char   vname[PROLONG_NVAR_MAX][64], *tok;
+  double t, dt;
+  long   offset, nz;
+  Output *output;
+  FILE   *fp;
+
+  #ifdef STAGGERED_MHD
+  printLog ("! ProlongFromFile(): staggered fields are not supported\n");
+  QUIT_PLUTO(1);
+  #endif
+
+/* --------------------------------------------------------
+   1. Find the file in dbl.out and read time, mode,
+      endianity and variable names
+   -------------------------------------------------------- */
+
+  sprintf (fname, "%s/dbl.out", runtime->prolong_dir);
+  fp = fopen (fname, "r");
+  if (fp == NULL){
+    printLog ("! ProlongFromFile(): cannot open %s\n", fname);
+    QUIT_PLUTO(1);
+  }
+  while (fgets(line, sizeof(line), fp) != NULL){
+    if (atoi(line) == runtime->prolong_nfile) {found = 1; break;}
+  }
+  fclose (fp);
+  if (!found){
+    printLog ("! ProlongFromFile(): output #%d not found in %s\n",
+              runtime->prolong_nfile, fname);
+    QUIT_PLUTO(1);
+  }
+  sscanf (line, "%d %lf %lf %d %63s %63s", &nfile, &t, &dt, &nstep,
+          mode, endianity);
+  tok = strtok (line, " \t\r\n");
+  for (n = 0; tok != NULL; n++){
+    if (n >= 6 && nin < PROLONG_NVAR_MAX) strcpy (vname[nin++], tok);
+    tok = strtok (NULL, " \t\r\n");
+  }
+
+  sprintf (gname, "%s/grid.out", runtime->prolong_dir);
+  print ("> Prolonging initial condition from %s/data.%04d.dbl (t = %f)\n",
+          runtime->prolong_dir, nfile, t);
+
+/* --------------------------------------------------------
+   2. Open one handle per variable (the size of the input
+      grid gives the offset of variables in a single file)
+   -------------------------------------------------------- */
+
+  output = runtime->output;
+  nz = 0;
+  if (!strcmp(mode, "single_file")){
+    sprintf (fname, "%s/data.%04d.dbl", runtime->prolong_dir, nfile);
+    n = InputDataOpen (fname, gname, endianity, 0, CENTER);
+    InputDataGridSize (n, size);
+    InputDataClose (n);
+    nz = (long)size[0]*size[1]*size[2];
+  }
+
+  NVAR_LOOP(nv){
+    hv[nv] = -1;
+    for (n = 0; n < nin; n++){
+      if (!strcmp(vname[n], output->var_name[nv])) break;
+    }
+    if (n == nin){
+      print ("! ProlongFromFile(): %s not found, kept from Init()\n",
+             output->var_name[nv]);
+      continue;
+    }
+    offset = n*nz;
+    if (nz == 0){
+      sprintf (fname, "%s/%s.%04d.dbl", runtime->prolong_dir, vname[n], nfile);
+    }
+    hv[nv] = InputDataOpen (fname, gname, endianity, offset, CENTER);
+  }
+
+/* --------------------------------------------------------
+   3. Prolong, with density as the weight of velocities
+   -------------------------------------------------------- */
+
+  hrho = hv[RHO];
+  NVAR_LOOP(nv){
+    if (hv[nv] < 0) continue;
+    if (nv >= VX1 && nv <= VX3 && hrho >= 0){
+      InputDataProlong (hv[nv], hrho, d->Vc[nv], grid);
+    }else{
+      InputDataProlong (hv[nv], -1, d->Vc[nv], grid);
+    }
+  }
+  NVAR_LOOP(nv) if (hv[nv] >= 0) InputDataClose (hv[nv]);
+
+/* --------------------------------------------------------
+   4. Set time and the numbers of the next outputs. Their
+      .out files are started empty, since WriteData() only
+      creates them for output #0.
+   -------------------------------------------------------- */
+
+  g_time = t;
+  for (n = 0; n < MAX_OUTPUT_TYPES; n++){
+    output = runtime->output + n;
+    if (output->dt > 0.0){
+      output->nfile = (int)floor(t/output->dt + 1.e-6) - 1;
+      if (prank == 0 && output->nfile >= 0){
+        sprintf (fname, "%s/%s.out", output->dir, output->ext);
+        fp = fopen (fname, "w");
+        if (fp != NULL) fclose (fp);
+      }
+    }
+  }
+}
@@ -2,6 +2,8 @@
    PLUTO function prototypes
    ********************************************************************* */
 
+int    AdaptCFLCheck (Data *, timeStep *, Runtime *, Grid *);
+void   AdaptCFLSave (const Data *, Grid *);
 int    AdvanceStep(Data *, timeStep *, Grid *);
 void   AdvectFlux (const Sweep *, int, int, Grid *);
 void   AMR_StoreFlux (double **, double **, int, int, int, int, int, Grid *);
@@ -13,6 +15,8 @@ char  ****Array4D (int, int, int, int, size_t);
 char  ***ArrayBox(long int, long int, long int, long int, long int, long int, size_t);
 double ***ArrayBoxMap (int, int, int, int, int, int, double *);
 double ***ArrayMap (int, int, int, double *);
+void     ArrayMemoryReport (void);
+void     ArraySetSource (const char *);
 uint16_t ***ArrayUint16_tMap (int, int, int, uint16_t *);
 void   ArrayReconstruct(double ***, uint16_t *, int, int, int, int,
                         double *, double *, int, Grid *);
@@ -47,6 +51,7 @@ int   FileDelete (char *);
 FILE  *FileOpen  (char *, int, char *);
 void  FileReadData  (void *, size_t, int, FILE *, int, int);
 void  FileWriteData (void *, size_t, int, FILE *, int);
+void  FileWriteFloat (double ***, double, int, int, FILE *);
 void  FileWriteHeader(char *buffer, char fname[], int mode);
 void  FileWriteArray(void *, long int, long int, size_t, char *);
 void  FreeArray1D (void *);
@@ -99,6 +104,7 @@ void   InternalBoundaryReset (const Sweep *, timeStep *, int, int, Grid *);
 void   InputDataClose(int);
 void   InputDataGridSize (int, int *);
 double InputDataInterpolate (int, double, double, double);
+void   InputDataProlong (int, int, Data_Type ***, Grid *);
 int    InputDataOpen(char *, char *, char *, long int, int);
 void   InputDataReadSlice(int, int);
 int    IsLittleEndian (void);
@@ -112,10 +118,17 @@ double StaggeredRemap_RHS(double ***, double ***, double ***, RBox *, Grid *);
 void   StaggeredRemapBoundary(double ***phi, Data_Arr Bs, RBox *, Grid *grid);
 
 void   MakeState (Sweep *);
+void   MarchSteadyState (Data *, timeStep *, Runtime *, Grid *);
+void   MUSCLHancockPredictor (Data *, Grid *);
+void   MUSCLHancockStates (const Sweep *, int, int);
+int    MultirateAdvanceStep (Data *, timeStep *, Grid *);
+void   MultirateStoreFlux (const Sweep *, int);
+void   MultirateStoreInvDt (double ***);
 double MeanMolecularWeight(double *);
 double Median (double a, double b, double c);
 
-void   OutflowBoundary(double ***, RBox *, int);
+void   OutflowBoundary(Data_Type ***, RBox *, int);
+double OutputFrameAngle (double);
 void   OutputLogPre  (Data *, timeStep *, Runtime *, Grid *);
 void   OutputLogPost (Data *, timeStep *, Runtime *, Grid *);
 
@@ -129,16 +142,25 @@ int    ParamFileRead    (char *);
 char  *ParamFileGet     (const char *, int );
 int    ParamExist       (const char *);
 int    ParamFileHasBoth (const char *, const char *);
-void   PeriodicBoundary (double ***, RBox *, int);
+void   PeriodicBoundary (Data_Type ***, RBox *, int);
 void   PointValue (Data *, Data_Arr, Data_Arr, Grid *);
 
-void   PolarAxisBoundary(const Data *, RBox *, int);
+void   PolarAxisBoundary(const Data *, RBox *, int, Grid *);
 
 void   PrimToChar (double **, double *, double *); 
 void   PrimToCons3D(Data_Arr, Data_Arr, RBox *);
 void   PrimToConsLoc (double *vprim, double *ucons);
 
 void   PrintColumnLegend(char *legend[], int, FILE *);
+void   ProbesInit   (Runtime *, cmdLine *, Grid *);
+void   ProbesSample (const Data *, Grid *);
+void   ProbesFlush  (void);
+void   ProlongFromFile (Data *, Runtime *, Grid *);
+void   SlicesInit   (Runtime *, cmdLine *, Grid *);
+void   SlicesWrite  (const Data *, Grid *);
+void   SteadyMonitor (Data *, Runtime *, Grid *);
+void   ImageQueuePush (char *, unsigned char *, int, int, char *, char *);
+void   ImageQueueFinalize (void);
 
 void   RBoxCopy (RBox *, Data_Arr, Data_Arr, int, char);
 void   RBoxDefine(int, int, int, int, int, int, int, RBox *);
@@ -146,7 +168,7 @@ void   RBoxEnlarge(RBox *, int, int, int);
 void   RBoxSetDirections(RBox *, int);
 void   RBoxShow(RBox *);
 void   ReadHDF5 (Output *output, Grid *grid);
-void   ReflectiveBoundary(double ***, int, int, RBox *, int);
+void   ReflectiveBoundary(Data_Type ***, int, int, RBox *, int);
 void   ResetState (const Data *, Sweep *, Grid *);
 void   RestartFromFile (const Data *, Runtime *, int, int, Grid *);
 void   RestartDump     (Runtime *);
@@ -200,7 +222,8 @@ void   SwapEndian (void *, const int);
 
 
 void UnsetJetDomain (const Data *, int, Grid *);
-void UpdateStage(Data *, Data_Arr, Data_Arr, double **, double, timeStep *, Grid *);
+void UpdateStage(Data *, Data_Arr, double ****, double **, double, timeStep *, Grid *);
+void UpdateStageWeights(Data_Arr, double, double);
 void UserDefBoundary (const Data *, RBox *, int,  Grid *); 
 
 void VectorPotentialDiff (double *, Data *, int, int, int, Grid *);
@@ -209,20 +232,28 @@ void  Where (int, Grid *);
 void  WriteAsciiFile (char *, double *, int);
 void  WriteData (const Data *, Output *, Grid *);
 void  WriteHDF5        (Output *output, Grid *grid);
+void  WriteNetCDF      (Output *output, Grid *grid);
 void  WriteVTK_Header (FILE *, Grid *);
-void  WriteVTK_Vector (FILE *, Data_Arr, double, char *, Grid *);
+void  WriteVTK_Vector (FILE *, double ****, double, char *, Grid *);
 void  WriteVTK_Scalar (FILE *, double ***, double, char *, Grid *);
 void  WriteVTKProcFile (double ***, int, int, int, char *);
+void  WriteVTS (Output *, Grid *);
+void  WritePyramid (Output *, Grid *);
 void  WriteTabArray (Output *, char *, Grid *);
 void  WritePPM (double ***, char *, char *, Grid *);
 void  WritePNG (double ***, char *, char *, Grid *);
 
-#define ARRAY_1D(nx,type)          (type    *)Array1D(nx,sizeof(type))
-#define ARRAY_2D(nx,ny,type)       (type   **)Array2D(nx,ny,sizeof(type))
-#define ARRAY_3D(nx,ny,nz,type)    (type  ***)Array3D(nx,ny,nz,sizeof(type))
-#define ARRAY_4D(nx,ny,nz,nv,type) (type ****)Array4D(nx,ny,nz,nv,sizeof(type))
+#define ARRAY_1D(nx,type)          \
+        (ArraySetSource(__FILE__), (type    *)Array1D(nx,sizeof(type)))
+#define ARRAY_2D(nx,ny,type)       \
+        (ArraySetSource(__FILE__), (type   **)Array2D(nx,ny,sizeof(type)))
+#define ARRAY_3D(nx,ny,nz,type)    \
+        (ArraySetSource(__FILE__), (type  ***)Array3D(nx,ny,nz,sizeof(type)))
+#define ARRAY_4D(nx,ny,nz,nv,type) \
+        (ArraySetSource(__FILE__), (type ****)Array4D(nx,ny,nz,nv,sizeof(type)))
 #define ARRAY_BOX(i0,i1, j0,j1, k0,k1,type)  \
-        (type ***)ArrayBox(i0,i1,j0,j1,k0,k1,sizeof(type))
+        (ArraySetSource(__FILE__), \
+         (type ***)ArrayBox(i0,i1,j0,j1,k0,k1,sizeof(type)))
 /*
 #define ARRAY_BOX(i0,i1, j0,j1, k0,k1,type)  \
          ArrayBox_Old(i0,i1,j0,j1,k0,k1)
@@ -41,12 +41,12 @@ void RBoxCopy (RBox *box, Data_Arr Q_dst, Data_Arr Q_src, int nvar, char order)
   if (box == NULL){
 
     if (order == CONS_ARRAY){
-      size_t nbytes = NX3_TOT*NX2_TOT*NX1_TOT*nvar*sizeof(double);
+      size_t nbytes = NX3_TOT*NX2_TOT*NX1_TOT*nvar*sizeof(Data_Type);
       memcpy ((void *)Q_dst[0][0][0], Q_src[0][0][0], nbytes);
     }
 
     if (order == PRIM_ARRAY){
-      size_t nbytes = NX3_TOT*NX2_TOT*NX1_TOT*nvar*sizeof(double);
+      size_t nbytes = NX3_TOT*NX2_TOT*NX1_TOT*nvar*sizeof(Data_Type);
       for (nv = 0; nv < nvar; nv++){
         KBOX_LOOP(box, k) JBOX_LOOP(box, j) { 
           memcpy ((void *)Q_dst[0][0][0], Q_src[0][0][0], nbytes);
@@ -57,14 +57,14 @@ void RBoxCopy (RBox *box, Data_Arr Q_dst, Data_Arr Q_src, int nvar, char order)
   } else {
 
     if (order == CONS_ARRAY){
-      size_t nbytes = (iend - ibeg + 1)*nvar*sizeof(double);
+      size_t nbytes = (iend - ibeg + 1)*nvar*sizeof(Data_Type);
       KBOX_LOOP(box, k) JBOX_LOOP(box, j) { 
        memcpy ((void *)Q_dst[k][j][ibeg], Q_src[k][j][ibeg], nbytes);
       }
     }
 
     if (order == PRIM_ARRAY){
-      size_t nbytes = (iend - ibeg + 1)*sizeof(double);
+      size_t nbytes = (iend - ibeg + 1)*sizeof(Data_Type);
       for (nv = 0; nv < nvar; nv++){
         KBOX_LOOP(box, k) JBOX_LOOP(box, j) { 
           memcpy ((void *)Q_dst[nv][k][j] + ibeg, Q_src[nv][k][j] + ibeg, nbytes);
@@ -33,6 +33,10 @@ void RestartFromFile (const Data *d, Runtime *ini, int nrestart, int type, Grid
   void   *Vpt;
   Output *output;
   FILE   *fbin;
+  #if MIXED_PRECISION == YES
+  int     i, j, k;
+  double ****Vin;
+  #endif
 
 /* --------------------------------------------------------
    1. Get the pointer to the output format specified by
@@ -64,14 +68,19 @@ void RestartFromFile (const Data *d, Runtime *ini, int nrestart, int type, Grid
       QUIT_PLUTO(1);
     }
 
-    while (fgets(str, 512, fbin) != 0) nlines++;  /* -- count lines in dbl.out -- */
+    origin = -1;
+    while (fgets(str, 512, fbin) != 0) {  /* -- count lines in dbl.out -- */
+      if (atoi(str) == nrestart) origin = nlines; /* Numbers may have gaps,
+                                                     see SteadyMonitor() */
+      nlines++;
+    }
     rewind(fbin);
-    if (nrestart > nlines-1){
+    if (nrestart < 0) origin = nlines + nrestart;
+    if (origin < 0){
       print ("! RestartFromFile(): output #%d does not exist in file %s\n",
              nrestart, fout);
       QUIT_PLUTO(1);
     }
-    origin = (nrestart >= 0 ? nrestart:(nlines+nrestart));
     for (nv = origin; nv--;   ) while ( fgetc(fbin) != '\n'){}
     fscanf(fbin, "%d  %lf  %lf  %d  %s  %s\n",&nv, &dbl, &dbl, &nv, str, str);
     if ( (!strcmp(str,"big")    &&  IsLittleEndian()) ||
@@ -90,10 +99,21 @@ void RestartFromFile (const Data *d, Runtime *ini, int nrestart, int type, Grid
    -------------------------------------------------------- */
 
   RestartGet (ini, nrestart, type, swap_endian);
+
+  #if MIXED_PRECISION == YES  /* -- Data is read into double copies of d->Vc -- */
+  Vin = ARRAY_4D(NVAR, NX3_TOT, NX2_TOT, NX1_TOT, double);
+  NVAR_LOOP(nv) output->V[nv] = Vin[nv];
+  #endif
+
   if (type == DBL_H5_OUTPUT){
     #ifdef USE_HDF5
     ReadHDF5 (output, grid);
     #endif
+    #if MIXED_PRECISION == YES
+    NVAR_LOOP(nv) TOT_LOOP(k,j,i) d->Vc[nv][k][j][i] = Vin[nv][k][j][i];
+    FreeArray4D ((void *) Vin);
+    NVAR_LOOP(nv) output->V[nv] = NULL;
+    #endif
     return;
   }
 
@@ -172,6 +192,12 @@ void RestartFromFile (const Data *d, Runtime *ini, int nrestart, int type, Grid
     }
   }
 
+  #if MIXED_PRECISION == YES
+  NVAR_LOOP(nv) TOT_LOOP(k,j,i) d->Vc[nv][k][j][i] = Vin[nv][k][j][i];
+  FreeArray4D ((void *) Vin);
+  NVAR_LOOP(nv) output->V[nv] = NULL;
+  #endif
+
   #ifdef FARGO
   FARGO_Restart(d, output->dir, output->nfile, swap_endian, grid);
   #endif
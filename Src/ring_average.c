@@ -14,6 +14,12 @@
     - "Conservative averaging-reconstruction techniques (Ring Average)
        for 3-D finite-volume MHD solvers with axis singularity",
        Zhang et al, JCP (2019) 376, 276-294
+
+  In spherical geometry the x3 (phi) direction may be split among
+  processes. Chunks that straddle two or more of them are averaged
+  with a sum over the processes sharing the same x1 and x2 blocks,
+  which also provides the neighbour chunks needed by the
+  reconstruction.
        
   \authors A. Mignone (mignone@to.infn.it)
   \date    Jun 16, 2020
@@ -23,6 +29,20 @@
 
 #if RING_AVERAGE > 1
 
+#if GEOMETRY == SPHERICAL
+static int ra_koff;      /* Global x3 index of zone k is k + ra_koff */
+static int ra_nring;     /* Number of local rings being averaged */
+static int ra_width;     /* Shared chunks of all local rings, per x1 index */
+static int *ra_off;      /* Offset of ring j among them */
+static int **ra_slot;    /* Slot of chunk c for chunk size 2^n (-1: not shared) */
+static double **ra_sum;  /* Conserved sums and volume of shared chunks */
+static double **ra_u;    /* Conservative averages of shared chunks */
+static double **ra_v;    /* Primitive averages of shared chunks */
+static uint16_t *ra_flag;
+#ifdef PARALLEL
+static MPI_Comm ra_comm; /* Processes sharing the same x1 and x2 blocks */
+#endif
+#endif
 
 /* ********************************************************************* */
 void RingAverageCons(Data *d, Grid *grid)
@@ -44,8 +64,7 @@ void RingAverageCons(Data *d, Grid *grid)
   #if GEOMETRY == POLAR
   if (csize[IBEG] == 1) return;  /* Not a physical boundary */
   #elif GEOMETRY == SPHERICAL
-  if (   csize[JBEG] == 1
-      && csize[JEND] == 1) return;  /* Not a physical boundary */
+  if (ra_nring == 0) return;  /* No ring close to a pole */
   #else
     printLog ("! RING_AVERAGE cannot be used in this geometry \n");
     QUIT_PLUTO(1);
@@ -82,52 +101,81 @@ void RingAverageCons(Data *d, Grid *grid)
     i++;   /* Proceed to next ring */
   }
   #elif GEOMETRY == SPHERICAL
-  j = JBEG;    /* 1st ring, North pole */
-  while (csize[j] > 1){
-    int k1;
-    for (i = IBEG; i <= IEND; i++){
-    for (k = KBEG; k <= KEND; k += csize[j]){
-
-      dVav = 0.0;
-      NVAR_LOOP(nv) uav[nv] = 0.0;
-      for (k1 = k; k1 < k+csize[j]; k1++) {
-        dVav += dV[k1][j][i];
-        NVAR_LOOP(nv) uav[nv] += d->Uc[k1][j][i][nv]*dV[k1][j][i];
-      }
+  {
+  int k1, kb, ke, c, n, s, w = ra_width;
+  double *S;
 
-    /* ------------------------------------------
-       Replace all zones with average value
-       ------------------------------------------ */
+/* -- Rings are split into chunks starting from global index 0.
+      Chunks shared with other processes only give their partial
+      sums here -- */
 
-      for (k1 = k; k1 < k+csize[j]; k1++) {
-        NVAR_LOOP(nv) d->Uc[k1][j][i][nv] = uav[nv]/dVav;
-      }
-    }}
-    j++;   /* Proceed to next ring */
+  for (s = IBEG*w; s < (IEND+1)*w; s++){
+    for (nv = 0; nv <= NVAR; nv++) ra_sum[s][nv] = 0.0;
   }
 
-  j = JEND;    /* 1st ring, south pole */
-  while (csize[j] > 1){
-    int k1;
+  for (j = JBEG; j <= JEND; j++){
+    if (csize[j] == 1) continue;
+    for (n = 0; (1 << n) < csize[j]; n++);
     for (i = IBEG; i <= IEND; i++){
-    for (k = KBEG; k <= KEND; k += csize[j]){
+    for (c = (KBEG + ra_koff)/csize[j]; c <= (KEND + ra_koff)/csize[j]; c++){
+      kb = MAX(c*csize[j] - ra_koff, KBEG);
+      ke = MIN((c+1)*csize[j] - 1 - ra_koff, KEND);
 
       dVav = 0.0;
       NVAR_LOOP(nv) uav[nv] = 0.0;
-      for (k1 = k; k1 < k+csize[j]; k1++) {
+      for (k1 = kb; k1 <= ke; k1++) {
         dVav += dV[k1][j][i];
         NVAR_LOOP(nv) uav[nv] += d->Uc[k1][j][i][nv]*dV[k1][j][i];
       }
 
+      s = (w > 0 ? ra_slot[n][c] : -1);
+      if (s >= 0){
+        S = ra_sum[i*w + ra_off[j] + s];
+        NVAR_LOOP(nv) S[nv] = uav[nv];
+        S[NVAR] = dVav;
+      }
+
     /* ------------------------------------------
        Replace all zones with average value
        ------------------------------------------ */
 
-      for (k1 = k; k1 < k+csize[j]; k1++) {
-        NVAR_LOOP(nv) d->Uc[k1][j][i][nv] = uav[nv]/dVav;
+      if (ke - kb + 1 == csize[j]) {
+        for (k1 = kb; k1 <= ke; k1++) {
+          NVAR_LOOP(nv) d->Uc[k1][j][i][nv] = uav[nv]/dVav;
+        }
       }
     }}
-    j--;   /* Proceed to next ring */
+  }
+
+/* -- Sum shared chunks over the ring and complete the
+      average of those split among processes -- */
+
+  #ifdef PARALLEL
+  if (w > 0){
+    n = (IEND - IBEG + 1)*w;
+    MPI_Allreduce (MPI_IN_PLACE, ra_sum[IBEG*w], n*(NVAR + 1),
+                   MPI_DOUBLE, MPI_SUM, ra_comm);
+    for (s = IBEG*w; s < (IEND+1)*w; s++){
+      NVAR_LOOP(nv) ra_u[s][nv] = ra_sum[s][nv]/ra_sum[s][NVAR];
+    }
+    ConsToPrim (ra_u + IBEG*w, ra_v + IBEG*w, 0, n-1, ra_flag);
+
+    for (j = JBEG; j <= JEND; j++){
+      if (csize[j] == 1) continue;
+      for (n = 0; (1 << n) < csize[j]; n++);
+      for (i = IBEG; i <= IEND; i++){
+      for (c = (KBEG + ra_koff)/csize[j]; c <= (KEND + ra_koff)/csize[j]; c++){
+        kb = MAX(c*csize[j] - ra_koff, KBEG);
+        ke = MIN((c+1)*csize[j] - 1 - ra_koff, KEND);
+        if (ke - kb + 1 == csize[j]) continue;
+        S = ra_u[i*w + ra_off[j] + ra_slot[n][c]];
+        for (k1 = kb; k1 <= ke; k1++) {
+          NVAR_LOOP(nv) d->Uc[k1][j][i][nv] = S[nv];
+        }
+      }}
+    }
+  }
+  #endif
   }
   #endif
 
@@ -195,6 +243,10 @@ Qr := k -> P((k-1/2)/N);
   int cbeg, cend;   /* Initial and final active indices on chunked grid  */  
   int dbeg, dend;   /* Initial and final active indices on original grid */ 
   int nchunks;      /* Number of chunks (= grid size on reduced grid) */
+  int nchunks_g;    /* Number of chunks on the whole ring */
+  int cmin, cmax;   /* First and last (global) chunks of this process */
+  int kofs;         /* Global index of zone dbeg */
+  int c, kg;
   int ngh  = GetNghost();
   int imax;
   State *stateC = &(sweep->stateC);
@@ -232,18 +284,24 @@ Qr := k -> P((k-1/2)/N);
   dbeg = JBEG;
   dend = JEND;
   nphi = NX2;
+  kofs = 0;
   #elif GEOMETRY == SPHERICAL
   chunk_size = grid->ring_av_csize[g_j];
   dbeg = KBEG;
   dend = KEND;
-  nphi = NX3;
+  nphi = grid->np_int_glob[KDIR];
+  kofs = KBEG + ra_koff;
   #endif
-  nchunks = nphi/chunk_size; //  >> (NPHI_AVERAGE - (g_i-IBEG));
-  cbeg = dbeg;
-  cend = dbeg + nchunks - 1;
 
   if (chunk_size == 1) return; /* No need to reconstruct */
 
+  nchunks_g = nphi/chunk_size;
+  cmin = kofs/chunk_size;
+  cmax = (kofs + dend - dbeg)/chunk_size;
+  nchunks = cmax - cmin + 1;
+  cbeg = dbeg;
+  cend = dbeg + nchunks - 1;
+
 /*
 print (">> AverageReconstruct: i = %d, chunk_size = %d, nphi = %d, abeg, aend = %d, %d\n",
          g_i, chunk_size, nphi, abeg, aend);
@@ -257,20 +315,21 @@ print (">> AverageReconstruct: i = %d, chunk_size = %d, nphi = %d, abeg, aend =
   ConvertTo4vel (v, beg-1, end+1);
 #endif
 
-  for (j = dbeg; j <= dend; j += chunk_size){
-    ja = (j - dbeg)/chunk_size + dbeg;
-    NVAR_LOOP(nv) va[ja][nv] = v[j][nv];    
-  }
-
-/* ----------------------------------------------
-   1c. Set periodic b.c.
-   ---------------------------------------------- */
-
-  for (j = 0; j < cbeg; j++){
-    NVAR_LOOP(nv) va[j][nv] = va[j+nchunks][nv];
-  }
-  for (j = cend+1; j <= cend + ngh; j++){
-    NVAR_LOOP(nv) va[j][nv] = va[j-nchunks][nv];
+  for (ja = 0; ja <= cend + ngh; ja++){
+    c = cmin + ja - cbeg;
+    c = (c%nchunks_g + nchunks_g)%nchunks_g;  /* Periodic b.c. */
+    j = c*chunk_size - kofs + dbeg;           /* 1st zone of chunk */
+    if (j >= dbeg && j + chunk_size - 1 <= dend){
+      NVAR_LOOP(nv) va[ja][nv] = v[j][nv];
+    }
+    #if GEOMETRY == SPHERICAL
+    else {  /* Chunk (partly) owned by other processes */
+      double *vc;
+      for (i = 0; (1 << i) < chunk_size; i++);
+      vc = ra_v[g_i*ra_width + ra_off[g_j] + ra_slot[i][c]];
+      NVAR_LOOP(nv) va[ja][nv] = vc[nv];
+    }
+    #endif
   }
 
 /* ----------------------------------------------
@@ -310,9 +369,9 @@ print (">> AverageReconstruct: i = %d, chunk_size = %d, nphi = %d, abeg, aend =
       qbck[j] = va[nphi_tot-j-1][nv];
     }
 
-    for (j = cbeg-1; j <= cend; j++){
+    for (j = cbeg-1; j <= cend+1; j++){
       int jp = j;
-      int jm = cend - (j-cbeg);
+      int jm = nphi_tot - 1 - j;
       vap[j][nv] = MP5_Reconstruct (qfwd, 0.0, jp);
       vam[j][nv] = MP5_Reconstruct (qbck, 0.0, jm);
     }
@@ -327,10 +386,12 @@ print (">> AverageReconstruct: i = %d, chunk_size = %d, nphi = %d, abeg, aend =
    ---------------------------------------------- */
 
   double A, B, C;
-  for (j = dbeg; j <= dend; j++){
+  for (j = beg; j <= end; j++){
     
-    ja = (j - dbeg)/chunk_size + dbeg;
-    k  = (j - dbeg)%chunk_size + 1;  /* Local grid index inside chunk,  1 <= k <= chunk_size */
+    kg = kofs + j - dbeg;                   /* Global index, -1 <= kg <= nphi */
+    c  = (kg + nphi)/chunk_size - nchunks_g;  /* Chunk (may be -1 or nchunks_g) */
+    ja = c - cmin + cbeg;
+    k  = kg - c*chunk_size + 1;  /* Local grid index inside chunk,  1 <= k <= chunk_size */
 //printf ("j = %d, ja = %d, k = %d\n",j, ja, k);
 
 
@@ -353,23 +414,6 @@ if (k > chunk_size || k < 1){
     #endif
   }
 
-/* ----------------------------------------------
-   3b. Set periodic b.c. on original grid
-   ---------------------------------------------- */
-
-  for (j = 0; j < dbeg; j++){
-    NVAR_LOOP(nv) {
-      vp[j][nv] = vp[j + nphi][nv];
-      vm[j][nv] = vm[j + nphi][nv];
-    }
-  }
-  for (j = dend+1; j <= dend+ngh; j++){
-    NVAR_LOOP(nv) {
-      vp[j][nv] = vp[j - nphi][nv];
-      vm[j][nv] = vm[j - nphi][nv];
-    }  
-  }
-
 /*
 FILE *fp;
 fp = fopen("average.dat","w");
@@ -673,59 +717,111 @@ void RingAverageSize(Grid *grid)
 
 /* --------------------------------------------------------
    2a. Check requirements:
-       - NX3 must be a power of 2
-       - NX3 must be divisible by RING_AVERAGE
-       - phi direction cannot be parallel
+       - the global NX3 must be divisible by RING_AVERAGE
    -------------------------------------------------------- */
 
-  //k = NX3;
-  //while (k != 1) {
-  //  if (k%2 != 0) {
-  //    print ("! RingAverageCons(): NX3 is not a power of 2\n");
-  //    QUIT_PLUTO(1);
-  //  }
-  //  k /= 2;  
-  //}
+  int    n, c, nc, r, nlev, np = 1;
+  int    nk   = grid->np_int_glob[KDIR];
+  int    kbeg = grid->beg[KDIR] - grid->gbeg[KDIR];
+  int    kend = kbeg + NX3 - 1;
+  int   *kb = &kbeg, *ke = &kend, *slot;
+  double s0 = 2.0, *th = grid->x_glob[JDIR];
+  Runtime *runtime = RuntimeGet();
 
-  if (NX3%RING_AVERAGE != 0){
-    print ("! RingAverageCons(): NX3 not divisible by RING_AVERAGE\n");
+  if (nk%RING_AVERAGE != 0){
+    print ("! RingAverageSize(): NX3 not divisible by RING_AVERAGE\n");
     QUIT_PLUTO(1);
   }
+  ra_koff = kbeg - KBEG;
 
-  if (grid->nproc[KDIR] > 1){
-    print ("! RING_AVERAGE requires nprocs(phi) = 1\n");
-    QUIT_PLUTO(1);
+/* --------------------------------------------------------
+   2b. Determine chunk size.
+       A chunk holds the smallest number of zones (a power
+       of 2) that makes it at least as wide as the chunks of
+       the ring next to the pole, which hold RING_AVERAGE
+       zones. This is computed from the global grid, so that
+       it does not depend on the domain decomposition.
+   -------------------------------------------------------- */
+
+  if (runtime->left_bound[JDIR] == POLARAXIS){
+    s0 = MIN(s0, sin(th[grid->gbeg[JDIR]]));
+  }
+  if (runtime->right_bound[JDIR] == POLARAXIS){
+    s0 = MIN(s0, sin(th[grid->gend[JDIR]]));
+  }
+
+  ra_nring = 0;
+  for (j = JBEG; j <= JEND; j++){
+    double sj = sin(grid->x[JDIR][j]);
+    csize = (s0 <= 1.0 ? RING_AVERAGE : 1);   /* 1 if no pole */
+    while (csize > 1 && 0.5*csize*sj >= RING_AVERAGE*s0*(1.0 - 1.e-9)) csize >>= 1;
+    grid->ring_av_csize[j] = csize;
+    ra_nring += (csize > 1);
   }
 
 /* --------------------------------------------------------
-   2b. Determine chunk size
+   2c. With phi split among processes, find the chunks that
+       must be summed over the ring: those lying partly on
+       a process, or needed by the reconstruction on another
+       one. Every process of the ring finds the same list.
    -------------------------------------------------------- */
 
-  /* -- Are close to the north pole ? -- */
+  ra_width = 0;
+  #ifdef PARALLEL
+  MPI_Comm_split (MPI_COMM_WORLD,
+                  grid->rank_coord[JDIR]*grid->nproc[IDIR] + grid->rank_coord[IDIR],
+                  grid->rank_coord[KDIR], &ra_comm);
+  MPI_Comm_size (ra_comm, &np);
+  if (np > 1){
+    kb = ARRAY_1D(np, int);
+    ke = ARRAY_1D(np, int);
+    MPI_Allgather (&kbeg, 1, MPI_INT, kb, 1, MPI_INT, ra_comm);
+    MPI_Allgather (&kend, 1, MPI_INT, ke, 1, MPI_INT, ra_comm);
+  }
+  #endif
 
-  if (grid->lbound[JDIR] == POLARAXIS){
-    csize = RING_AVERAGE;
-    for (j = JBEG; j <= JEND; j++){    
-      grid->ring_av_csize[j] = csize;
-      if (csize > 1) csize >>= 1;   /* Same as csizeN /= 2 */
+  for (nlev = 0; (1 << nlev) < RING_AVERAGE; nlev++);
+  ra_slot = ARRAY_2D(nlev + 1, nk, int);
+  ra_off  = ARRAY_1D(grid->np_tot[JDIR], int);
+  slot    = ARRAY_1D(nlev + 1, int);   /* Shared chunks per chunk size */
+
+  for (n = 1; n <= nlev; n++){
+    int ngh = GetNghost();
+
+    csize = 1 << n;
+    nc    = nk/csize;
+    for (c = 0; c < nc; c++) ra_slot[n][c] = -1;
+    if (np == 1) continue;
+    for (r = 0; r < np; r++){
+      for (k = kb[r]/csize - ngh; k <= ke[r]/csize + ngh; k++){
+        c = (k%nc + nc)%nc;
+        if (c*csize < kb[r] || (c+1)*csize - 1 > ke[r]) ra_slot[n][c] = 0;
+      }
+    }
+    slot[n] = 0;
+    for (c = 0; c < nc; c++) {
+      if (ra_slot[n][c] == 0) ra_slot[n][c] = slot[n]++;
     }
-  }else{
-    for (j = JBEG; j <= JEND; j++) grid->ring_av_csize[j] = 1;
   }
 
-  /* -- Are close to the south pole ? -- */
+  for (j = JBEG; j <= JEND; j++){
+    ra_off[j] = ra_width;
+    if (grid->ring_av_csize[j] == 1 || np == 1) continue;
+    for (n = 0; (1 << n) < grid->ring_av_csize[j]; n++);
+    ra_width += slot[n];
+  }
 
-  if (grid->rbound[JDIR] == POLARAXIS){
-    csize = RING_AVERAGE;
-    for (j = JEND; j >= JBEG; j--){    
-      grid->ring_av_csize[j] = MAX(grid->ring_av_csize[j], csize);
-      if (csize > 1) csize >>= 1;   /* Same as csizeS /= 2 */
-    }
-  }else{
-    for (j = JEND; j >= JBEG; j--) {
-      grid->ring_av_csize[j] = MAX(grid->ring_av_csize[j], 1);
-    }
+  if (ra_width > 0){
+    ra_sum  = ARRAY_2D(grid->np_tot[IDIR]*ra_width, NVAR + 1, double);
+    ra_u    = ARRAY_2D(grid->np_tot[IDIR]*ra_width, NVAR, double);
+    ra_v    = ARRAY_2D(grid->np_tot[IDIR]*ra_width, NVAR, double);
+    ra_flag = ARRAY_1D(grid->np_tot[IDIR]*ra_width, uint16_t);
+  }
+  if (np > 1){
+    FreeArray1D((void *)kb);
+    FreeArray1D((void *)ke);
   }
+  FreeArray1D((void *)slot);
 
 //for (j = JBEG; j <= JEND; j++) printf ("j = %d, csize = %d\n", j, grid->ring_av_csize[j]);
 //exit(1);
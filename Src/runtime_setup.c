@@ -159,6 +159,42 @@ printf ("%f  %d %s\n",runtime->patch_left_node[idim][ip],runtime->patch_npoint[i
   else                        runtime->tfreeze = runtime->tstop+1;
   runtime->first_dt    = atof(ParamFileGet("first_dt", 1));
 
+  runtime->cfl_max = -1.0;     /* Adaptive CFL number (adapt_cfl.c) */
+  if (ParamExist ("CFL_adapt")){
+    runtime->cfl_min      = atof(ParamFileGet("CFL_adapt", 1));
+    runtime->cfl_max      = atof(ParamFileGet("CFL_adapt", 2));
+    runtime->cfl_mach_var = atof(ParamFileGet("CFL_adapt", 3));
+    if (runtime->cfl_min <= 0.0 || runtime->cfl_min > runtime->cfl_max) {
+      printLog ("! RuntimeSetup(): CFL_adapt needs 0 < cfl_min <= cfl_max\n");
+      QUIT_PLUTO(1);
+    }
+    if (runtime->cfl_max_var <= 1.0) {
+      printLog ("! RuntimeSetup(): CFL_adapt needs CFL_max_var > 1\n");
+      QUIT_PLUTO(1);
+    }
+    runtime->cfl = MIN(MAX(runtime->cfl, runtime->cfl_min), runtime->cfl_max);
+  }
+
+  runtime->march_tol = -1.0;   /* Initial state marched in x1 (march.c) */
+  if (ParamExist ("march")){
+    runtime->march_tol   = atof(ParamFileGet("march", 1));
+    runtime->march_maxit = atoi(ParamFileGet("march", 2));
+    runtime->march_t0    = atof(ParamFileGet("march", 3));
+  }
+
+  runtime->steady_tol = -1.0;  /* Early stop of the spin-up (steady.c) */
+  if (ParamExist ("steady")){
+    runtime->steady_dt     = atof(ParamFileGet("steady", 1));
+    runtime->steady_tol    = atof(ParamFileGet("steady", 2));
+    runtime->steady_nstall = atoi(ParamFileGet("steady", 3));
+  }
+
+  runtime->prolong_nfile = -1;  /* Start from a coarser run (prolong.c) */
+  if (ParamExist ("prolong")){
+    strcpy (runtime->prolong_dir, ParamFileGet("prolong", 1));
+    runtime->prolong_nfile = atoi(ParamFileGet("prolong", 2));
+  }
+
 /* ------------------------------------------------------------
    [Solver] Section 
    ------------------------------------------------------------ */
@@ -283,6 +319,23 @@ printf ("%f  %d %s\n",runtime->patch_left_node[idim][ip],runtime->patch_npoint[i
     GetOutputFrequency(output, "flt.h5");
   }
 
+ /* -- NetCDF-4 output -- */
+
+  if (ParamExist("nc")){
+    output = runtime->output + (ipos++);
+    output->type  = NETCDF_OUTPUT;
+    GetOutputFrequency(output, "nc");
+
+    strcpy (output->mode, ParamFileGet("nc",3));
+    if (   strcmp(output->mode,"float")
+        && strcmp(output->mode,"double")){
+      printf ("! RuntimeSetup(): expecting 'float' or 'double' in nc output\n");
+      QUIT_PLUTO(1);
+    }
+    output->cgs     = ParamFileHasBoth ("nc","cgs");
+    output->deflate = ParamFileHasBoth ("nc","deflate");
+  }
+
  /* -- vtk output -- */
 
   if (ParamExist ("vtk")){
@@ -305,6 +358,24 @@ printf ("%f  %d %s\n",runtime->patch_left_node[idim][ip],runtime->patch_npoint[i
     else                                output->cgs = 0;
   }
 
+ /* -- XML vtk output (one piece per processor) -- */
+
+  if (ParamExist ("vts")){
+    output = runtime->output + (ipos++);
+    output->type  = VTS_OUTPUT;
+    GetOutputFrequency(output, "vts");
+    output->cgs   = ParamFileHasBoth ("vts","cgs");
+  }
+
+ /* -- coarsened vtk output for quick-look (see write_pyramid.c) -- */
+
+  if (ParamExist ("pyr")){
+    output = runtime->output + (ipos++);
+    output->type  = PYR_OUTPUT;
+    GetOutputFrequency(output, "pyr");
+    output->cgs   = ParamFileHasBoth ("pyr","cgs");
+  }
+
  /* -- tab output -- */
 
   if (ParamExist ("tab")){
@@ -32,6 +32,7 @@ void SetGrid (Runtime *rtime, int *procs, Grid *grid)
   int include_dir[] = {INCLUDE_IDIR, INCLUDE_JDIR, INCLUDE_KDIR};
   int *gsize = rtime->npoint;
   int lsize[3];
+  double q;
 
   print ("\n> Generating grid...\n\n");
 
@@ -127,7 +128,33 @@ printf ("[GridCreateGlobal()] dim = %d; array gsize = %d; gbeg, gend = %d, %d\n"
     }
 
   /* --------------------------------------------
-     2c. Define cell center
+     2c. Next to a logarithmic or stretched
+         segment, ghost zones continue its
+         geometric progression instead, so that
+         boundary zones have the same shape
+         as the adjacent ones.
+     -------------------------------------------- */
+
+    if (iend > ibeg && rtime->patch_type[idim][1] != UNIFORM_GRID){
+      q = dx[ibeg]/dx[ibeg+1];
+      for (i = ibeg-1; i >= ibeg-ngh; i--){
+        dx[i] = dx[i+1]*q;
+        xr[i] = xl[i+1];
+        xl[i] = xr[i] - dx[i];
+      }
+    }
+    if (iend > ibeg && 
+        rtime->patch_type[idim][rtime->npatch[idim]] != UNIFORM_GRID){
+      q = dx[iend]/dx[iend-1];
+      for (i = iend+1; i <= iend+ngh; i++){
+        dx[i] = dx[i-1]*q;
+        xl[i] = xr[i-1];
+        xr[i] = xl[i] + dx[i];
+      }
+    }
+
+  /* --------------------------------------------
+     2d. Define cell center
      -------------------------------------------- */
 
     grid->xbeg_glob[idim] = g_domBeg[idim] = xl[ibeg];
@@ -22,6 +22,13 @@
         fields (VTK VECTOR attribute), set VTK_VECTOR_DUMP to YES
         in your definitions.h.        
   
+  The number of mantissa bits kept in NetCDF output is read from the
+  optional \c nc_bits line of pluto.ini, a comma-separated list of
+  <tt> name:bits </tt> pairs where \c name can also be \c all, e.g.
+  \verbatim
+   nc_bits   all:12,vx1:16
+  \endverbatim
+
   \authors A. Mignone (mignone@to.infn.it)
   \date    June 24, 2019
 */
@@ -33,6 +40,8 @@
 #endif
 
 static Output *all_outputs;
+static void SetOutputBits (Output *);
+
 /* ********************************************************************* */
 void SetOutput (Data *d, Runtime *runtime)
 /*!
@@ -86,11 +95,18 @@ void SetOutput (Data *d, Runtime *runtime)
     SetDefaultVarNames(output);
 
   /* --------------------------------------------
-     1c. Set output array pointers (cell-centered)
+     1c. Set output array pointers (cell-centered).
+         With MIXED_PRECISION they are set to double
+         copies of d->Vc by WriteData() and
+         RestartFromFile().
      -------------------------------------------- */
 
     NVAR_LOOP(nv){
+      #if MIXED_PRECISION == YES
+      output->V[nv]        = NULL;
+      #else
       output->V[nv]        = d->Vc[nv];
+      #endif
       output->stag_var[nv] = -1; /* -- means cell centered -- */ 
     }
     
@@ -186,7 +202,8 @@ void SetOutput (Data *d, Runtime *runtime)
         strcpy (output->ext,"flt.h5");
         break;
       case VTK_OUTPUT:   /* -- do not dump staggered fields (below) -- */
-        strcpy (output->ext,"vtk");
+      case VTS_OUTPUT:
+        strcpy (output->ext, output->type == VTK_OUTPUT ? "vtk":"vts");
         #if VTK_VECTOR_DUMP == YES
          DIM_EXPAND(output->dump_var[VX1] = VTK_VECTOR;  ,
                   output->dump_var[VX2] = NO;          ,
@@ -209,6 +226,12 @@ void SetOutput (Data *d, Runtime *runtime)
         strcpy (output->ext,"png");
         for (nv = output->nvar; nv--; ) output->dump_var[nv] = NO;
         break;
+      case NETCDF_OUTPUT:   /* -- do not dump staggered fields -- */
+        strcpy (output->ext,"nc");
+        break;
+      case PYR_OUTPUT:   /* -- cell-centered scalars only -- */
+        strcpy (output->ext,"pyr");
+        break;
     }
     
   /* ---------------------------------------------------------------
@@ -231,12 +254,25 @@ void SetOutput (Data *d, Runtime *runtime)
     #endif
   }
  
+/* -- Mantissa bits kept in NetCDF output -- */
+
+  for (k = 0; k < MAX_OUTPUT_TYPES; k++){
+    output = runtime->output + k;
+    if (output->type == NETCDF_OUTPUT) SetOutputBits (output);
+  }
+
 /* -- Exclude staggered components from all output except .dbl and .h5.dbl -- */
 
   #ifdef STAGGERED_MHD
   DIM_EXPAND(SetOutputVar ("Bx1s", VTK_OUTPUT, NO);  ,
              SetOutputVar ("Bx2s", VTK_OUTPUT, NO);  ,
              SetOutputVar ("Bx3s", VTK_OUTPUT, NO);)
+  DIM_EXPAND(SetOutputVar ("Bx1s", VTS_OUTPUT, NO);  ,
+             SetOutputVar ("Bx2s", VTS_OUTPUT, NO);  ,
+             SetOutputVar ("Bx3s", VTS_OUTPUT, NO);)
+  DIM_EXPAND(SetOutputVar ("Bx1s", PYR_OUTPUT, NO);  ,
+             SetOutputVar ("Bx2s", PYR_OUTPUT, NO);  ,
+             SetOutputVar ("Bx3s", PYR_OUTPUT, NO);)
   DIM_EXPAND(SetOutputVar ("Bx1s", FLT_OUTPUT, NO);  ,
              SetOutputVar ("Bx2s", FLT_OUTPUT, NO);  ,
              SetOutputVar ("Bx3s", FLT_OUTPUT, NO);)
@@ -356,3 +392,48 @@ double ***GetUserVar (char *var_name)
   }
   return (all_outputs->V[indx]);
 }
+
+/* ********************************************************************* */
+void SetOutputBits (Output *output)
+/*!
+ * Read the number of mantissa bits kept for each variable from the
+ * \c nc_bits line (rank 0, where the input file has been parsed) and
+ * broadcast it.
+ * Later entries override earlier ones, so that \c all can be given
+ * first as a default.
+ *
+ * \param [in,out] output  the NetCDF output structure
+ *********************************************************************** */
+{
+  int  nv, nbits;
+  char list[512], *tok, *sep;
+
+  for (nv = 0; nv < MAX_OUTPUT_VARS; nv++) output->nbits[nv] = 0;
+
+  if (prank == 0 && ParamExist("nc_bits")){
+    strcpy (list, ParamFileGet("nc_bits", 1));
+    for (tok = strtok(list, ","); tok != NULL; tok = strtok(NULL, ",")){
+      sep = strchr(tok, ':');
+      nbits = (sep == NULL ? 0:atoi(sep + 1));
+      if (sep != NULL) *sep = '\0';
+      if (nbits < 1 || nbits > 52){
+        printf ("! SetOutputBits(): invalid number of bits for '%s'\n", tok);
+        QUIT_PLUTO(1);
+      }
+      for (nv = 0; nv < output->nvar; nv++){
+        if (!strcmp(tok, "all") || !strcmp(tok, output->var_name[nv])){
+          output->nbits[nv] = nbits;
+          if (strcmp(tok, "all")) break;
+        }
+      }
+      if (strcmp(tok, "all") && nv == output->nvar){
+        printf ("! SetOutputBits(): unknown variable '%s' in nc_bits\n", tok);
+        QUIT_PLUTO(1);
+      }
+    }
+  }
+
+  #ifdef PARALLEL
+  MPI_Bcast (output->nbits, MAX_OUTPUT_VARS, MPI_CHAR, 0, MPI_COMM_WORLD);
+  #endif
+}
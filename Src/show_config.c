@@ -203,12 +203,23 @@ void ShowConfig (int argc, char *argv[], char *ini_file)
   if (TIME_STEPPING == EULER)            print ("Euler\n");
   if (TIME_STEPPING == RK2)              print ("Runga-Kutta II\n");
   if (TIME_STEPPING == RK3)              print ("Runga_Kutta III\n");
+#if TIME_STEPPING == SSP_RK_LS
+  print ("Low-storage SSP Runge-Kutta (%d stages, order %d)\n",
+          SSP_RK_LS_STAGES, SSP_RK_LS_ORDER);
+#endif
   if (TIME_STEPPING == CHARACTERISTIC_TRACING)
                                          print ("Characteristic Tracing\n");
 #if TIME_STEPPING == HANCOCK
   if (PRIMITIVE_HANCOCK == YES) print ("Hancock [Primitive]\n");
   else                          print ("Hancock [Conservative]\n");
 #endif
+  if (TIME_STEPPING == MUSCL_HANCOCK)    print ("MUSCL-Hancock [Unsplit]\n");
+#if MULTIRATE_LEVELS > 1
+  print ("  MULTIRATE:        %d radial levels\n", MULTIRATE_LEVELS);
+#endif
+#if MIXED_PRECISION == YES
+  print ("  MIXED_PRECISION:  solution arrays in single precision\n");
+#endif
 
   print ("  TRACERS:          %d\n", NTRACER);
   print ("  VARIABLES:        %d\n", NVAR);
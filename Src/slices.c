@@ -0,0 +1,636 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Region-of-interest and slice outputs.
+
+  Write selected primitive variables on a sub-volume of the grid at a
+  cadence independent of the full-domain outputs.
+  Slices are defined in the optional <tt> [Slices] </tt> section of
+  pluto.ini, one line per slice:
+  \verbatim
+   slice1  ecliptic  theta  90.0                 0.00694  -1  flt  rho,vx1,Bx1
+   slice2  earth     shell  1.0                  0.04167  -1  dbl  all   cgs
+   slice3  cone      box    0 255 40 55 170 200  0.00694  -1  flt  rho,prs
+  slice4  eclip_img theta  90.0                 0.00694  -1  png  rho,vx1:3e7:9e7  jet log
+  \endverbatim
+  The fields are: name, kind and its parameters, time interval \c dt,
+  step interval \c dn (as for the \c analysis entry), precision
+  (\c dbl, \c flt, or \c ppm / \c png for images), a comma-separated
+  list of primitive variables (or \c all) and, optionally, \c cgs.
+  Slice kinds are:
+
+  - <tt> x1 | x2 | x3  value </tt>: the layer of zones closest to the
+    given coordinate (code units) in the given direction;
+  - <tt> shell r </tt>: same as \c x1;
+  - <tt> theta deg </tt>, <tt> phi deg </tt>: same as \c x2 and \c x3
+    with the angle given in degrees (spherical geometry);
+  - <tt> box i0 i1 j0 j1 k0 k1 </tt>: a box of zones given by global,
+    0-based interior indices (inclusive).
+
+  Zone-centered values are written without interpolation.
+  Only the processes owning part of a slice take part in writing it:
+  each one writes its own block into <tt> output_dir/name.nnnn.dbl </tt>
+  (or \c .flt) using MPI-IO on a communicator restricted to the owners,
+  so the full domain is never gathered.
+  As for .dbl files, variables are stored one after the other, each as
+  a 3D array with the x1 index running fastest.
+  Rank 0 keeps the list of written files in <tt> output_dir/name.out </tt>
+  (file number, time, step, index box, endianity and variable names).
+  On restart, entries at or after the restart time are discarded and
+  numbering continues from there.
+
+  Plane slices can instead be rendered in-situ as colour images
+  <tt> name.var.nnnn.png </tt> (or \c .ppm), one per variable, with
+  the colour tables of colortable.c: add the table name (\c br by
+  default) and \c log for a logarithmic scale to the line.
+  The colour range is the min/max over the slice unless given as
+  <tt> var:min:max </tt>.
+  No data is gathered: each owner colours its own pixels and the
+  disjoint partial images are composited on the first owner by a
+  reduction. Encoding and writing run on a background thread, so the
+  solver does not wait for the file system; the entry in
+  <tt> name.out </tt> (with the image format in place of the byte
+  order) is added once the images of the frame are on disk.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include "pluto.h"
+
+#define MAX_SLICES   16
+#define SLICE_PPM    1
+#define SLICE_PNG    2
+
+typedef struct Slice_{
+  char   name[64];
+  int    box[3][2];    /**< Global 0-based interior index range */
+  int    dn;           /**< Step interval */
+  int    single;       /**< 1 for single precision */
+  int    cgs;
+  int    nvar;
+  int    var[NVAR];    /**< Indices of variables being written */
+  int    nfile;        /**< Number of the last file written */
+  int    image;        /**< 0 for data, SLICE_PPM or SLICE_PNG */
+  int    plane[2];     /**< Image column and row directions */
+  int    logscale;     /**< 1 for logarithmic colour scale */
+  char   colormap[8];  /**< Colour table (see colortable.c) */
+  double vmin[NVAR];   /**< Colour range of each variable; */
+  double vmax[NVAR];   /**< automatic if vmin >= vmax */
+  double dt;           /**< Time interval */
+  #ifdef PARALLEL
+  MPI_Comm comm;       /**< Owners of the slice */
+  #endif
+} Slice;
+
+static Slice  slice[MAX_SLICES];
+static int    nslices = 0;
+static int    restart;
+static double slice_tstop;
+static char   slice_dir[256];
+static char   var_names[NVAR][16];
+
+static void SliceIndex (double, int, Grid *, int *);
+static void SliceWriteData (Slice *, const Data *, char *, Grid *);
+static void SliceRender (Slice *, const Data *, Grid *);
+static void SliceRestart (Slice *);
+
+/* ********************************************************************* */
+void SlicesInit (Runtime *runtime, cmdLine *cmd_line, Grid *grid)
+/*!
+ * Read the <tt> [Slices] </tt> section of the initialization file
+ * (already parsed on rank 0), broadcast slice settings and build the
+ * communicator of the owners of each slice.
+ *
+ * \param [in] runtime   pointer to a Runtime structure
+ * \param [in] cmd_line  pointer to a cmdLine structure
+ * \param [in] grid      pointer to an array of Grid structures
+ *********************************************************************** */
+{
+  int    n, nv, dir, ipar, own, m, nplane;
+  char   label[32], *kind, *str, *tok, vlist[512], vname[64];
+  char  *cmaps[] = {"bw", "red", "br", "blue", "green", "jet"};
+  double x, vmin, vmax;
+  Slice  *s;
+
+  for (nv = 0; nv < NVAR; nv++) {
+    strcpy (var_names[nv], runtime->output[0].var_name[nv]);
+  }
+
+  if (prank == 0){
+    for (n = 0; n < MAX_SLICES; n++){
+      sprintf (label, "slice%d", n + 1);
+      if (!ParamExist(label)) break;
+      s = slice + n;
+      strcpy (s->name, ParamFileGet(label, 1));
+      kind = ParamFileGet(label, 2);
+
+    /* -- Index box: whole domain unless restricted below -- */
+
+      for (dir = 0; dir < 3; dir++){
+        s->box[dir][0] = 0;
+        s->box[dir][1] = grid->np_int_glob[dir] - 1;
+      }
+
+      ipar = 4;
+      dir  = -1;
+      if      (!strcmp(kind,"x1") || !strcmp(kind,"shell")) dir = IDIR;
+      else if (!strcmp(kind,"x2") || !strcmp(kind,"theta")) dir = JDIR;
+      else if (!strcmp(kind,"x3") || !strcmp(kind,"phi"))   dir = KDIR;
+      else if (!strcmp(kind,"box")){
+        for (dir = 0; dir < 3; dir++){
+          s->box[dir][0] = MAX(atoi(ParamFileGet(label, 3 + 2*dir)), 0);
+          s->box[dir][1] = MIN(atoi(ParamFileGet(label, 4 + 2*dir)),
+                               grid->np_int_glob[dir] - 1);
+          if (s->box[dir][0] > s->box[dir][1]){
+            printLog ("! SlicesInit(): empty box for %s\n", label);
+            QUIT_PLUTO(1);
+          }
+        }
+        ipar = 9;
+        dir  = -1;
+      }else{
+        printLog ("! SlicesInit(): unknown slice kind '%s'\n", kind);
+        QUIT_PLUTO(1);
+      }
+
+      if (dir >= 0){
+        x = atof(ParamFileGet(label, 3));
+        if (!strcmp(kind,"theta") || !strcmp(kind,"phi")) x *= CONST_PI/180.0;
+        SliceIndex (x, dir, grid, s->box[dir]);
+      }
+
+    /* -- Cadence, precision, variables -- */
+
+      s->dt     = atof(ParamFileGet(label, ipar));
+      s->dn     = atoi(ParamFileGet(label, ipar + 1));
+      str       = ParamFileGet(label, ipar + 2);
+      s->single = !strcmp(str, "flt");
+      s->image  = 0;
+      if      (!strcmp(str, "ppm")) s->image = SLICE_PPM;
+      else if (!strcmp(str, "png")) s->image = SLICE_PNG;
+      else if (!s->single && strcmp(str, "dbl")){
+        printLog ("! SlicesInit(): expecting 'dbl', 'flt', 'ppm' or 'png' "
+                  "for %s\n", label);
+        QUIT_PLUTO(1);
+      }
+      #ifndef USE_PNG
+      if (s->image == SLICE_PNG){
+        printLog ("! SlicesInit(): PNG support not available for %s, "
+                  "use 'ppm'\n", label);
+        QUIT_PLUTO(1);
+      }
+      #endif
+      s->cgs  = ParamFileHasBoth (label, "cgs");
+      s->nvar = 0;
+      strcpy (vlist, ParamFileGet(label, ipar + 3));
+      for (tok = strtok(vlist, ","); tok != NULL; tok = strtok(NULL, ",")){
+        vmin = vmax = 0.0;
+        vname[0] = '\0';
+        sscanf (tok, "%63[^:]:%lf:%lf", vname, &vmin, &vmax);
+        m = s->nvar;
+        for (nv = 0; nv < NVAR; nv++){
+          if (!strcmp(vname, "all") || !strcmp(vname, var_names[nv])){
+            s->vmin[s->nvar]  = vmin;
+            s->vmax[s->nvar]  = vmax;
+            s->var[s->nvar++] = nv;
+            if (strcmp(vname, "all")) break;
+          }
+        }
+        if (s->nvar == m){
+          printLog ("! SlicesInit(): unknown variable '%s' in %s\n", tok, label);
+          QUIT_PLUTO(1);
+        }
+      }
+
+    /* -- Images: plane, colour table and scale -- */
+
+      if (s->image){
+        nplane = 0;
+        for (dir = 0; dir < 3; dir++){
+          if (s->box[dir][1] > s->box[dir][0] && nplane < 2){
+            s->plane[nplane] = dir;
+          }
+          if (s->box[dir][1] > s->box[dir][0]) nplane++;
+        }
+        if (nplane != 2){
+          printLog ("! SlicesInit(): %s must be a plane to be rendered\n",
+                    label);
+          QUIT_PLUTO(1);
+        }
+        strcpy (s->colormap, "br");
+        for (m = 0; m < 6; m++){
+          if (ParamFileHasBoth (label, cmaps[m])) strcpy (s->colormap, cmaps[m]);
+        }
+        s->logscale = ParamFileHasBoth (label, "log");
+      }
+      s->nfile = -1;
+    }
+    nslices = n;
+  }
+
+  #ifdef PARALLEL
+  MPI_Bcast (&nslices, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  MPI_Bcast (slice, nslices*sizeof(Slice), MPI_BYTE, 0, MPI_COMM_WORLD);
+  #endif
+  if (nslices == 0) return;
+
+  slice_tstop = runtime->tstop;
+  restart     = cmd_line->restart || cmd_line->h5restart;
+  strcpy (slice_dir, runtime->output_dir);
+
+/* -- Owners of a slice share a communicator -- */
+
+  #ifdef PARALLEL
+  for (n = 0; n < nslices; n++){
+    s   = slice + n;
+    own = 1;
+    for (dir = 0; dir < 3; dir++){
+      own = own && s->box[dir][0] <= grid->end[dir] - grid->gbeg[dir]
+                && s->box[dir][1] >= grid->beg[dir] - grid->gbeg[dir];
+    }
+    MPI_Comm_split (MPI_COMM_WORLD, own ? 0:MPI_UNDEFINED, prank, &s->comm);
+  }
+  #endif
+
+  print ("> Slices:\n");
+  for (n = 0; n < nslices; n++){
+    s = slice + n;
+    print ("  %-12s [%d:%d, %d:%d, %d:%d], %d var(s)\n", s->name,
+           s->box[IDIR][0], s->box[IDIR][1], s->box[JDIR][0], s->box[JDIR][1],
+           s->box[KDIR][0], s->box[KDIR][1], s->nvar);
+  }
+  print ("\n");
+}
+
+/* ********************************************************************* */
+void SlicesWrite (const Data *d, Grid *grid)
+/*!
+ * Write the slices whose cadence has been reached.
+ * Must be called by all processes.
+ *
+ * \param [in] d     pointer to the PLUTO Data structure
+ * \param [in] grid  pointer to an array of Grid structures
+ *********************************************************************** */
+{
+  int    n, m, check_dt, check_dn;
+  char   fname[512];
+  double tnext;
+  static int first_call = 1;
+  Slice  *s;
+  FILE   *fp;
+
+  if (nslices == 0) return;
+
+  if (first_call){
+    if (restart) for (n = 0; n < nslices; n++) SliceRestart (slice + n);
+    first_call = 0;
+  }
+
+  tnext = g_time + g_dt;
+  for (n = 0; n < nslices; n++){
+    s = slice + n;
+
+  /* --------------------------------------------------------
+     0. Check cadence (same as Analysis())
+     -------------------------------------------------------- */
+
+    check_dt = (int)(tnext/s->dt) - (int)(g_time/s->dt);
+    check_dt = check_dt || g_stepNumber == 0
+                        || fabs(g_time - slice_tstop) < 1.e-9;
+    check_dt = check_dt && (s->dt > 0.0);
+    check_dn = (s->dn > 0) && (g_stepNumber%s->dn) == 0;
+    if (!(check_dt || check_dn)) continue;
+
+    s->nfile++;
+    if (s->image){     /* -- images also update the list of files -- */
+      SliceRender (s, d, grid);
+      continue;
+    }
+    sprintf (fname, "%.256s/%.63s.%04d.%s", slice_dir, s->name, s->nfile,
+                                            s->single ? "flt":"dbl");
+
+  /* --------------------------------------------------------
+     1. Write data and update the list of files
+     -------------------------------------------------------- */
+
+    SliceWriteData (s, d, fname, grid);
+    if (prank != 0) continue;
+
+    sprintf (fname, "%.256s/%.63s.out", slice_dir, s->name);
+    fp = fopen (fname, s->nfile == 0 ? "w":"a");
+    fprintf (fp, "%d %12.6e %12.6e %ld  %d %d %d %d %d %d  %s ",
+             s->nfile, g_time, g_dt, g_stepNumber,
+             s->box[IDIR][0], s->box[IDIR][1], s->box[JDIR][0], s->box[JDIR][1],
+             s->box[KDIR][0], s->box[KDIR][1],
+             IsLittleEndian() ? "little":"big");
+    for (m = 0; m < s->nvar; m++) fprintf (fp, "%s ", var_names[s->var[m]]);
+    fprintf (fp, "\n");
+    fclose (fp);
+  }
+}
+
+/* ********************************************************************* */
+void SliceWriteData (Slice *s, const Data *d, char *fname, Grid *grid)
+/*!
+ * Write the part of the slice owned by this process.
+ * In parallel, only the owners of the slice take part.
+ *********************************************************************** */
+{
+  int    nv, m, dir, i, j, k;
+  int    b[3][2], nbox[3], nloc[3];
+  long int cnt;
+  double u[NVAR];
+  static double *dbuf;
+  static float  *fbuf;
+  #ifdef PARALLEL
+  int    sizes[3], subsizes[3], starts[3], rank;
+  MPI_File     fh;
+  MPI_Datatype etype, ftype;
+  MPI_Offset   offset = 0, nbytes;
+  #else
+  FILE   *fp;
+  #endif
+
+  #ifdef PARALLEL
+  if (s->comm == MPI_COMM_NULL) return;
+  #endif
+
+  if (dbuf == NULL){
+    dbuf = ARRAY_1D(NX1*NX2*NX3, double);
+    fbuf = ARRAY_1D(NX1*NX2*NX3, float);
+  }
+  NVAR_LOOP(nv) u[nv] = 1.0;
+  if (s->cgs) GetCGSUnits(u);
+
+/* --------------------------------------------------------
+   1. Intersect the slice with the local domain: b[][] are
+      local indices, nloc[] and nbox[] local and total sizes
+   -------------------------------------------------------- */
+
+  for (dir = 0; dir < 3; dir++){
+    b[dir][0] = MAX(s->box[dir][0] + grid->gbeg[dir], grid->beg[dir]);
+    b[dir][1] = MIN(s->box[dir][1] + grid->gbeg[dir], grid->end[dir]);
+    nbox[dir] = s->box[dir][1] - s->box[dir][0] + 1;
+    nloc[dir] = b[dir][1] - b[dir][0] + 1;
+    #ifdef PARALLEL
+    sizes[2-dir]    = nbox[dir];
+    subsizes[2-dir] = nloc[dir];
+    starts[2-dir]   = b[dir][0] - grid->gbeg[dir] - s->box[dir][0];
+    #endif
+    b[dir][0] += grid->lbeg[dir] - grid->beg[dir];
+    b[dir][1] += grid->lbeg[dir] - grid->beg[dir];
+  }
+
+/* --------------------------------------------------------
+   2. Open file (owners only)
+   -------------------------------------------------------- */
+
+  #ifdef PARALLEL
+  etype = (s->single ? MPI_FLOAT:MPI_DOUBLE);
+  MPI_Type_create_subarray (3, sizes, subsizes, starts, MPI_ORDER_C,
+                            etype, &ftype);
+  MPI_Type_commit (&ftype);
+
+  MPI_Comm_rank (s->comm, &rank);
+  if (rank == 0) MPI_File_delete (fname, MPI_INFO_NULL);
+  MPI_Barrier (s->comm);
+  MPI_File_open (s->comm, fname, MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                 MPI_INFO_NULL, &fh);
+  nbytes = (MPI_Offset)nbox[IDIR]*nbox[JDIR]*nbox[KDIR]
+           *(s->single ? sizeof(float):sizeof(double));
+  #else
+  fp = fopen (fname, "wb");
+  if (fp == NULL){
+    printLog ("! SliceWriteData(): cannot open %s\n", fname);
+    QUIT_PLUTO(1);
+  }
+  #endif
+
+/* --------------------------------------------------------
+   3. Pack and write variables one after the other
+   -------------------------------------------------------- */
+
+  for (m = 0; m < s->nvar; m++){
+    nv  = s->var[m];
+    cnt = 0;
+    for (k = b[KDIR][0]; k <= b[KDIR][1]; k++){
+    for (j = b[JDIR][0]; j <= b[JDIR][1]; j++){
+    for (i = b[IDIR][0]; i <= b[IDIR][1]; i++){
+      if (s->single) fbuf[cnt++] = (float)(d->Vc[nv][k][j][i]*u[nv]);
+      else           dbuf[cnt++] = d->Vc[nv][k][j][i]*u[nv];
+    }}}
+
+    #ifdef PARALLEL
+    MPI_File_set_view (fh, offset, etype, ftype, "native", MPI_INFO_NULL);
+    MPI_File_write_all (fh, s->single ? (void *)fbuf:(void *)dbuf, cnt,
+                        etype, MPI_STATUS_IGNORE);
+    offset += nbytes;
+    #else
+    if (s->single) fwrite (fbuf, sizeof(float),  cnt, fp);
+    else           fwrite (dbuf, sizeof(double), cnt, fp);
+    #endif
+  }
+
+  #ifdef PARALLEL
+  MPI_File_close (&fh);
+  MPI_Type_free (&ftype);
+  #else
+  fclose (fp);
+  #endif
+}
+
+/* ********************************************************************* */
+void SliceRender (Slice *s, const Data *d, Grid *grid)
+/*!
+ * Render each variable of a plane slice as a colour image.
+ * Every owner colours the pixels of its own zones; the partial images,
+ * which do not overlap, are composited on the first owner by a
+ * bitwise-or reduction (a tree reduction inside MPI_Reduce).
+ * The first owner then queues the image for encoding on a background
+ * thread (see img_queue.c), which also appends the entry to the list
+ * of files once all images of the frame have been written.
+ *********************************************************************** */
+{
+  int    nv, m, dir, i, j, k, ic, ir, indx, rank = 0;
+  int    da = s->plane[0], db = s->plane[1];
+  int    b[3][2], g[3], ncol, nrow;
+  char   fname[512], list[512], line[1024];
+  long   npix, n;
+  double u[NVAR], q, range[2], qmin, qmax;
+  char   *entry;
+  unsigned char  r[256], gr[256], bl[256], *img;
+  static unsigned char *local = NULL;
+  static long nlocal = 0;
+
+  #ifdef PARALLEL
+  if (s->comm == MPI_COMM_NULL) return;
+  MPI_Comm_rank (s->comm, &rank);
+  #endif
+
+  NVAR_LOOP(nv) u[nv] = 1.0;
+  if (s->cgs) GetCGSUnits(u);
+  SetColorMap (r, gr, bl, s->colormap);
+
+  ncol = s->box[da][1] - s->box[da][0] + 1;
+  nrow = s->box[db][1] - s->box[db][0] + 1;
+  npix = (long)ncol*nrow;
+  if (npix > nlocal){
+    if (local != NULL) free (local);
+    local  = (unsigned char *) malloc(3*npix);
+    nlocal = npix;
+  }
+
+/* -- Local part of the slice (local array indices) -- */
+
+  for (dir = 0; dir < 3; dir++){
+    b[dir][0] = MAX(s->box[dir][0] + grid->gbeg[dir], grid->beg[dir]);
+    b[dir][1] = MIN(s->box[dir][1] + grid->gbeg[dir], grid->end[dir]);
+    b[dir][0] += grid->lbeg[dir] - grid->beg[dir];
+    b[dir][1] += grid->lbeg[dir] - grid->beg[dir];
+  }
+
+  sprintf (list, "%.256s/%.63s.out", slice_dir, s->name);
+  if (rank == 0 && s->nfile == 0) fclose (fopen (list, "w"));
+
+  for (m = 0; m < s->nvar; m++){
+    nv = s->var[m];
+
+  /* --------------------------------------------------------
+     1. Colour range: given, or min/max over the slice
+     -------------------------------------------------------- */
+
+    range[0] = range[1] = -1.e38;   /* -min, max */
+    for (k = b[KDIR][0]; k <= b[KDIR][1]; k++){
+    for (j = b[JDIR][0]; j <= b[JDIR][1]; j++){
+    for (i = b[IDIR][0]; i <= b[IDIR][1]; i++){
+      q = d->Vc[nv][k][j][i]*u[nv];
+      if (s->logscale && q <= 0.0) continue;
+      range[0] = MAX(range[0], -q);
+      range[1] = MAX(range[1],  q);
+    }}}
+    #ifdef PARALLEL
+    MPI_Allreduce (MPI_IN_PLACE, range, 2, MPI_DOUBLE, MPI_MAX, s->comm);
+    #endif
+    qmin = -range[0];
+    qmax =  range[1];
+    if (s->vmin[m] < s->vmax[m]){
+      qmin = s->vmin[m];
+      qmax = s->vmax[m];
+    }
+    if (s->logscale){
+      qmin = log10(MAX(qmin, 1.e-300));
+      qmax = log10(MAX(qmax, 1.e-300));
+    }
+    if (qmax <= qmin) qmax = qmin + 1.0;
+
+  /* --------------------------------------------------------
+     2. Colour the local pixels (first row on top)
+     -------------------------------------------------------- */
+
+    memset (local, 0, 3*npix);
+    for (k = b[KDIR][0]; k <= b[KDIR][1]; k++){
+    for (j = b[JDIR][0]; j <= b[JDIR][1]; j++){
+    for (i = b[IDIR][0]; i <= b[IDIR][1]; i++){
+      q = d->Vc[nv][k][j][i]*u[nv];
+      if (s->logscale) q = log10(MAX(q, 1.e-300));
+      indx = (int)((q - qmin)/(qmax - qmin)*255.0);
+      indx = MAX(MIN(indx, 255), 0);
+
+      g[IDIR] = i - grid->lbeg[IDIR] + grid->beg[IDIR] - grid->gbeg[IDIR];
+      g[JDIR] = j - grid->lbeg[JDIR] + grid->beg[JDIR] - grid->gbeg[JDIR];
+      g[KDIR] = k - grid->lbeg[KDIR] + grid->beg[KDIR] - grid->gbeg[KDIR];
+      ic = g[da] - s->box[da][0];
+      ir = nrow - 1 - (g[db] - s->box[db][0]);
+      n  = 3*((long)ir*ncol + ic);
+      local[n]     = r[indx];
+      local[n + 1] = gr[indx];
+      local[n + 2] = bl[indx];
+    }}}
+
+  /* --------------------------------------------------------
+     3. Composite on the first owner and queue the image
+     -------------------------------------------------------- */
+
+    img = (rank == 0 ? (unsigned char *) malloc(3*npix):NULL);
+    #ifdef PARALLEL
+    MPI_Reduce (local, img, 3*npix, MPI_UNSIGNED_CHAR, MPI_BOR, 0, s->comm);
+    #else
+    memcpy (img, local, 3*npix);
+    #endif
+    if (rank != 0) continue;
+
+    sprintf (fname, "%.256s/%.63s.%s.%04d.%s", slice_dir, s->name,
+             var_names[nv], s->nfile, s->image == SLICE_PNG ? "png":"ppm");
+    entry = NULL;
+    if (m == s->nvar - 1){
+      sprintf (line, "%d %12.6e %12.6e %ld  %d %d %d %d %d %d  %s ",
+               s->nfile, g_time, g_dt, g_stepNumber,
+               s->box[IDIR][0], s->box[IDIR][1], s->box[JDIR][0],
+               s->box[JDIR][1], s->box[KDIR][0], s->box[KDIR][1],
+               s->image == SLICE_PNG ? "png":"ppm");
+      for (i = 0; i < s->nvar; i++){
+        strcat (line, var_names[s->var[i]]);
+        strcat (line, " ");
+      }
+      strcat (line, "\n");
+      entry = line;
+    }
+    ImageQueuePush (fname, img, ncol, nrow, list, entry);
+  }
+}
+
+/* ********************************************************************* */
+void SliceIndex (double x, int dir, Grid *grid, int *ind)
+/*!
+ * Find the global 0-based index of the zone center closest to x
+ * in direction dir.
+ *********************************************************************** */
+{
+  int    i, imin;
+  double *xg = grid->x_glob[dir];
+
+  imin = grid->gbeg[dir];
+  for (i = grid->gbeg[dir]; i <= grid->gend[dir]; i++){
+    if (fabs(xg[i] - x) < fabs(xg[imin] - x)) imin = i;
+  }
+  ind[0] = ind[1] = imin - grid->gbeg[dir];
+}
+
+/* ********************************************************************* */
+void SliceRestart (Slice *s)
+/*!
+ * On restart, drop entries of the slice list at or after the current
+ * time and continue numbering from the last one kept.
+ *********************************************************************** */
+{
+  int    nf, nkeep = 0, nlines = 0;
+  char   fname[512], line[1024], **kept = NULL;
+  double t;
+  FILE   *fp;
+
+  if (prank == 0){
+    sprintf (fname, "%.256s/%.63s.out", slice_dir, s->name);
+    fp = fopen (fname, "r");
+    if (fp != NULL){
+      while (fgets(line, 1024, fp) != NULL) nlines++;
+      rewind (fp);
+      if (nlines > 0) kept = ARRAY_2D(nlines, 1024, char);
+      while (fgets(line, 1024, fp) != NULL){
+        if (sscanf (line, "%d %lf", &nf, &t) != 2) continue;
+        if (t >= g_time*(1.0 - 1.e-12)) break;
+        strcpy (kept[nkeep++], line);
+      }
+      fclose (fp);
+
+      fp = fopen (fname, "w");
+      for (nf = 0; nf < nkeep; nf++) fprintf (fp, "%s", kept[nf]);
+      fclose (fp);
+      if (kept != NULL) FreeArray2D ((void *) kept);
+    }
+    s->nfile = nkeep - 1;
+  }
+  #ifdef PARALLEL
+  MPI_Bcast (&s->nfile, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  #endif
+}
@@ -0,0 +1,372 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Monitor the convergence to a steady state and stop the spin-up
+         early.
+
+  SteadyMonitor() is enabled by the optional \c steady line in the
+  <tt> [Time] </tt> section of pluto.ini:
+  \verbatim
+   steady   0.1   1.e-3   5
+  \endverbatim
+  giving the interval \c dt between checks, the tolerance \c tol and
+  the number \c nstall of checks without improvement after which the
+  state is taken as converged.
+
+  At every check the relative change per unit time of density, radial
+  velocity and magnetic field strength since the previous check,
+  \f[
+     \epsilon_1 = \frac{\sum |q - q_{\rm prev}|\,\Delta V}
+                       {\Delta t\,\sum |q|\,\Delta V} \,,\qquad
+     \epsilon_\infty = \frac{\max |q - q_{\rm prev}|}
+                            {\Delta t\,\max |q|} \,,
+  \f]
+  is appended to <tt> output_dir/steady.dat </tt>.
+  Sums and maxima of all processes are combined by a single
+  MPI_Allreduce().
+
+  The ambient wind is steady in the frame of the Sun, which rotates
+  on the grid at ::g_OmegaZsteady (zero in the Carrington frame).
+  The previous state is then rotated in x3 by the angle elapsed since
+  it was saved: \c dt is rounded to the time taken by the pattern to
+  move by a whole number of zones (at most <tt> nghost - 1 </tt>) and
+  the time step is shortened so that checks fall exactly at multiples
+  of it (linear interpolation between zones is used otherwise).
+
+  The state is converged when the largest \f$\epsilon_1\f$ falls below
+  \c tol or, once below <tt> 10*tol </tt>, has not reached a new
+  minimum for \c nstall consecutive checks. Larger residuals that stop
+  decreasing (e.g. while the first wind crosses the domain) are taken
+  as part of a transient.
+  The time left to \c tstop is then skipped: the solution is rotated
+  by the whole number of zones the pattern would have moved and
+  ::g_time is advanced by the corresponding amount, leaving less
+  than one step (plus, with a rotating pattern, the time taken to move
+  by one zone) to \c tstop.
+  Output counters are advanced by the number of outputs skipped, so
+  that the last output (which is integrated normally) keeps the number
+  it would have had without early stop and the forecast can be
+  restarted from it as usual.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include "pluto.h"
+
+#define STEADY_NQ   3   /* Density, radial velocity, |B| */
+
+static void   SteadyLimitStep (double);
+static double SteadyValue (Data *, int, int, int, int);
+static void   SteadyRotate (Data *, int, Grid *);
+#ifdef PARALLEL
+static void   SteadyReduce (void *, void *, int *, MPI_Datatype *);
+#endif
+
+/* ********************************************************************* */
+void SteadyMonitor (Data *d, Runtime *runtime, Grid *grid)
+/*!
+ * Check the convergence to a steady state and, once converged, skip
+ * to the end of the run. Called by all processes after every step,
+ * with ::g_time and ::g_dt giving the next step.
+ *
+ * \param [in,out] d        pointer to the PLUTO Data structure
+ * \param [in,out] runtime  pointer to a Runtime structure
+ * \param [in]     grid     pointer to an array of Grid structures
+ *********************************************************************** */
+{
+  int    i, j, k, n, q, ks, nshift = 0, conv = 0;
+  int    ng = grid->nghost[KDIR];
+  static int    first_call = 1, done = 0, saved = 0, nstall = 0;
+  static double omega = 0.0, dphi, dtcheck, tcheck, tprev, eps_min;
+  static double ****qprev;
+  double s, w, val, old, res[4*STEADY_NQ], eps, epsinf;
+  double t_old, t_new;
+  char   fname[512];
+  FILE   *fp;
+  Output *output;
+  #ifdef PARALLEL
+  double res_glob[4*STEADY_NQ];
+  static MPI_Op op;
+  #endif
+
+  if (done) return;
+
+/* --------------------------------------------------------
+   0. Set the check interval and save the first state
+   -------------------------------------------------------- */
+
+  if (first_call){
+    #ifdef STAGGERED_MHD
+    printLog ("! SteadyMonitor(): staggered fields are not supported\n");
+    QUIT_PLUTO(1);
+    #endif
+    #if ROTATING_FRAME
+    omega = g_OmegaZsteady;
+    #endif
+    dtcheck = runtime->steady_dt;
+    if (omega != 0.0){
+      #if GEOMETRY != SPHERICAL
+      printLog ("! SteadyMonitor(): a rotating pattern requires x3 = phi\n");
+      QUIT_PLUTO(1);
+      #endif
+      dphi = (grid->xend_glob[KDIR] - grid->xbeg_glob[KDIR])
+             /(double)grid->np_int_glob[KDIR];
+      KDOM_LOOP(k){
+        if (fabs(grid->dx[KDIR][k] - dphi) > 1.e-6*dphi) break;
+      }
+      if (   (grid->lbound[KDIR] && grid->lbound[KDIR] != PERIODIC)
+          || k <= KEND){
+        printLog ("! SteadyMonitor(): x3 must be periodic and uniform\n");
+        QUIT_PLUTO(1);
+      }
+      nshift  = (int)floor(runtime->steady_dt*fabs(omega)/dphi + 0.5);
+      nshift  = MAX(nshift, 1);
+      nshift  = MIN(nshift, ng - 1);
+      dtcheck = nshift*dphi/fabs(omega);
+    }
+    print ("> Steady-state monitor: check every %10.4e", dtcheck);
+    if (omega != 0.0) print (" (pattern moves by %d zones)", nshift);
+    print (", tol = %8.2e, nstall = %d\n", runtime->steady_tol,
+                                           runtime->steady_nstall);
+
+    qprev = ARRAY_4D(STEADY_NQ, NX3_TOT, NX2_TOT, NX1_TOT, double);
+    #ifdef PARALLEL
+    MPI_Op_create (SteadyReduce, 1, &op);
+    #endif
+    if (prank == 0){
+      sprintf (fname, "%s/steady.dat", runtime->output_dir);
+      fp = fopen (fname, "w");
+      fprintf (fp, "# %12s  %12s %12s %12s  %12s %12s %12s\n", "t",
+               "L1(rho)", "L1(vx1)", "L1(|B|)",
+               "Linf(rho)", "Linf(vx1)", "Linf(|B|)");
+      fclose (fp);
+    }
+    eps_min = 1.e38;
+    tcheck  = g_time;
+    first_call = 0;
+  }
+
+  if (g_time < tcheck - 1.e-9*dtcheck){
+    if (omega != 0.0) SteadyLimitStep (tcheck);
+    return;
+  }
+  while (tcheck <= g_time + 1.e-9*dtcheck) tcheck += dtcheck;
+
+/* --------------------------------------------------------
+   1. Compare with the previous state, rotated by the
+      angle elapsed since it was saved
+   -------------------------------------------------------- */
+
+  if (omega != 0.0) Boundary (d, ALL_DIR, grid);
+
+  s  = (saved && omega != 0.0) ? omega*(g_time - tprev)/dphi:0.0;
+  ks = (int)floor(s);
+  w  = s - ks;
+  if (ks < -ng || ks + 1 > ng){
+    print ("! SteadyMonitor(): pattern moved by %f zones, check skipped\n", s);
+    saved = 0;
+  }
+
+  if (saved){
+    for (n = 0; n < 4*STEADY_NQ; n++) res[n] = 0.0;
+    DOM_LOOP(k,j,i){
+      for (q = 0; q < STEADY_NQ; q++){
+        val = SteadyValue(d, q, k, j, i);
+        old =   (1.0 - w)*qprev[q][k - ks][j][i]
+              + (w > 0.0 ? w*qprev[q][k - ks - 1][j][i]:0.0);
+        res[q]               += fabs(val - old)*grid->dV[k][j][i];
+        res[q +   STEADY_NQ] += fabs(val)*grid->dV[k][j][i];
+        res[q + 2*STEADY_NQ]  = MAX(res[q + 2*STEADY_NQ], fabs(val - old));
+        res[q + 3*STEADY_NQ]  = MAX(res[q + 3*STEADY_NQ], fabs(val));
+      }
+    }
+    #ifdef PARALLEL
+    MPI_Allreduce (res, res_glob, 4*STEADY_NQ, MPI_DOUBLE, op, MPI_COMM_WORLD);
+    for (n = 0; n < 4*STEADY_NQ; n++) res[n] = res_glob[n];
+    #endif
+
+    eps = epsinf = 0.0;
+    for (q = 0; q < STEADY_NQ; q++){
+      res[q]               /= (g_time - tprev)*res[q + STEADY_NQ] + 1.e-38;
+      res[q + 2*STEADY_NQ] /= (g_time - tprev)*res[q + 3*STEADY_NQ] + 1.e-38;
+      eps    = MAX(eps, res[q]);
+      epsinf = MAX(epsinf, res[q + 2*STEADY_NQ]);
+    }
+    if (prank == 0){
+      sprintf (fname, "%s/steady.dat", runtime->output_dir);
+      fp = fopen (fname, "a");
+      fprintf (fp, "  %12.6e  %12.6e %12.6e %12.6e  %12.6e %12.6e %12.6e\n",
+               g_time, res[0], res[1], res[2],
+               res[2*STEADY_NQ], res[2*STEADY_NQ+1], res[2*STEADY_NQ+2]);
+      fclose (fp);
+    }
+    print ("> Steady-state residual at t = %10.4e: L1 = %8.2e, Linf = %8.2e\n",
+           g_time, eps, epsinf);
+
+    if (eps < runtime->steady_tol){
+      conv = 1;
+    }else if (eps < eps_min){
+      eps_min = eps;
+      nstall  = 0;
+    }else if (eps > 10.0*runtime->steady_tol){  /* Still in a transient */
+      nstall = 0;
+    }else if (++nstall >= runtime->steady_nstall){
+      conv = 2;
+    }
+  }
+
+/* --------------------------------------------------------
+   2. Save the current state, ghost zones included
+   -------------------------------------------------------- */
+
+  for (q = 0; q < STEADY_NQ; q++){
+    TOT_LOOP(k,j,i) qprev[q][k][j][i] = SteadyValue(d, q, k, j, i);
+  }
+  tprev = g_time;
+  saved = 1;
+  if (!conv){
+    if (omega != 0.0) SteadyLimitStep (tcheck);
+    return;
+  }
+
+/* --------------------------------------------------------
+   3. Converged: skip to the last step. With a rotating
+      pattern, rotate the solution by a whole number of
+      zones.
+   -------------------------------------------------------- */
+
+  done  = 1;
+  t_old = g_time;
+  t_new = runtime->tstop - g_dt;
+  if (omega != 0.0){
+    nshift = (int)floor(fabs(omega)*(t_new - t_old)/dphi);
+    t_new  = t_old + nshift*dphi/fabs(omega);
+  }
+  print ("> Steady state reached at t = %10.4e (%s)",
+         t_old, conv == 1 ? "below tolerance":"no further decrease");
+  if (t_new <= t_old){
+    print ("\n");
+    return;
+  }
+  print (", skipping to t = %10.4e\n", t_new);
+
+  if (omega != 0.0) SteadyRotate (d, omega > 0.0 ? nshift:-nshift, grid);
+
+  for (n = 0; n < MAX_OUTPUT_TYPES; n++){
+    output = runtime->output + n;
+    if (output->dt > 0.0){
+      output->nfile +=   (int)(t_new/output->dt) - (int)(t_old/output->dt);
+    }
+  }
+  g_time = t_new;
+}
+
+/* ********************************************************************* */
+void SteadyLimitStep (double tcheck)
+/*!
+ * Shorten the next step(s) so that the next check falls exactly at
+ * \c tcheck, when the pattern has moved by a whole number of zones.
+ * The last two steps are made equal to avoid a very short one.
+ *********************************************************************** */
+{
+  double dt = tcheck - g_time;
+
+  if (dt < 2.0*g_dt) g_dt = (dt > g_dt ? 0.5*dt:dt);
+}
+
+/* ********************************************************************* */
+double SteadyValue (Data *d, int q, int k, int j, int i)
+/*!
+ * Return density, radial velocity or magnetic field strength.
+ *********************************************************************** */
+{
+  if (q == 0) return d->Vc[RHO][k][j][i];
+  if (q == 1) return d->Vc[VX1][k][j][i];
+  #if PHYSICS == MHD
+  return sqrt(  d->Vc[BX1][k][j][i]*d->Vc[BX1][k][j][i]
+              + d->Vc[BX2][k][j][i]*d->Vc[BX2][k][j][i]
+              + d->Vc[BX3][k][j][i]*d->Vc[BX3][k][j][i]);
+  #else
+  return 0.0;
+  #endif
+}
+
+/* ********************************************************************* */
+void SteadyRotate (Data *d, int nshift, Grid *grid)
+/*!
+ * Rotate the primitive variables by \c nshift zones in x3,
+ * <tt> V(k) = V(k - nshift) </tt> with global periodic indices.
+ * Processes sharing the same x1 and x2 ranges gather the full ring,
+ * one variable at a time.
+ *********************************************************************** */
+{
+  int  i, j, k, nv, n, kg, ks;
+  int  nk = KEND - KBEG + 1, nring = grid->np_int_glob[KDIR];
+  int  kg0 = grid->beg[KDIR] - grid->gbeg[KDIR];
+  long nplane = (long)NX2*NX1;
+  double *sbuf, *ring;
+  #ifdef PARALLEL
+  int  np, *cnt, *displ;
+  MPI_Comm ring_comm;
+  #endif
+
+  sbuf = ARRAY_1D(nk*nplane, double);
+  ring = ARRAY_1D(nring*nplane, double);
+
+  #ifdef PARALLEL
+  MPI_Comm_split (MPI_COMM_WORLD,
+                  grid->rank_coord[JDIR]*grid->nproc[IDIR] + grid->rank_coord[IDIR],
+                  grid->rank_coord[KDIR], &ring_comm);
+  MPI_Comm_size (ring_comm, &np);
+  cnt   = ARRAY_1D(np, int);
+  displ = ARRAY_1D(np, int);
+  n = nk*nplane;
+  MPI_Allgather (&n, 1, MPI_INT, cnt, 1, MPI_INT, ring_comm);
+  displ[0] = 0;
+  for (n = 1; n < np; n++) displ[n] = displ[n-1] + cnt[n-1];
+  #endif
+
+  NVAR_LOOP(nv){
+    n = 0;
+    KDOM_LOOP(k) JDOM_LOOP(j) IDOM_LOOP(i) sbuf[n++] = d->Vc[nv][k][j][i];
+    #ifdef PARALLEL
+    MPI_Allgatherv (sbuf, nk*nplane, MPI_DOUBLE, ring, cnt, displ,
+                    MPI_DOUBLE, ring_comm);
+    #else
+    for (n = 0; n < nk*nplane; n++) ring[n] = sbuf[n];
+    #endif
+    KDOM_LOOP(k){
+      kg = k - KBEG + kg0;
+      ks = ((kg - nshift)%nring + nring)%nring;
+      n  = ks*nplane;
+      JDOM_LOOP(j) IDOM_LOOP(i) d->Vc[nv][k][j][i] = ring[n++];
+    }
+  }
+
+  #ifdef PARALLEL
+  MPI_Comm_free (&ring_comm);
+  FreeArray1D ((void *) cnt);
+  FreeArray1D ((void *) displ);
+  #endif
+  FreeArray1D ((void *) sbuf);
+  FreeArray1D ((void *) ring);
+}
+
+#ifdef PARALLEL
+/* ********************************************************************* */
+void SteadyReduce (void *in, void *inout, int *len, MPI_Datatype *type)
+/*!
+ * MPI reduction operator: sum of the first half of the array and
+ * maximum of the second half.
+ *********************************************************************** */
+{
+  int    n;
+  double *a = (double *) in, *b = (double *) inout;
+
+  for (n = 0; n < *len; n++){
+    if (n < *len/2) b[n] += a[n];
+    else            b[n]  = MAX(a[n], b[n]);
+  }
+}
+#endif
@@ -20,7 +20,8 @@ typedef struct cmdLine_{
   int jet;                /**< Follow jet evolution in a given direction */
   int nproc[3];           /**< User supplied number of processors */
   int xres;               /**< Change the resolution via command line */
-  char fill[26];               /* useless, it makes the struct a power of 2 */ 
+  int ioranks;            /**< Number of I/O server ranks per node */
+  char fill[22];               /* useless, it makes the struct a power of 2 */ 
 } cmdLine;
 
 /* ********************************************************************* */
@@ -313,10 +314,12 @@ typedef struct Sweep_{
   double *dL, *dR;        /**< Diffusion coefficient for EMF  */
   double *aL, *aR;        /**< Flux averaging coefficients    */
   uint16_t *flag;
+  double **vh;      /**< Half time-step increment of primitive variables
+                         added to the L/R states (MUSCL_HANCOCK only). */
   State stateL;
   State stateR;
   State stateC;
-  char fill[16];
+  char fill[8];
 } Sweep;
 
 typedef struct Table2D_ {
@@ -398,6 +401,7 @@ typedef struct Output_{
   int    cgs;          /**< (Fluid only) When set to 1, save data in c.g.s units     */
   int    nfile;        /**< Current number being saved. */
   int    dn;           /**< Step increment between outputs. */
+  int    deflate;      /**< (NetCDF only) Compress chunks with deflate. */
   int    stag_var[MAX_OUTPUT_VARS];  /**< (Fluid only). Centered or staggered
                                            variable - same for all outputs. */
   int    dump_var[MAX_OUTPUT_VARS];  /**< (Fluid only) Include/exclude variables
@@ -409,12 +413,14 @@ typedef struct Output_{
   char   **var_name;   /**< (Fluid only) Variable names. Same for all output types.  */
   char   ext[8];       /**< File extension (.flt, .dbl, etc...)           */
   char   dir[256];     /**< Output directory name                        */
+  char   nbits[MAX_OUTPUT_VARS]; /**< (NetCDF only) Mantissa bits kept for
+                                      each variable (0 = all). */
 
   double dt;           /**< Time increment between outputs. */
   double dclock;       /**< Time increment in clock hours. */
   double ***V[MAX_OUTPUT_VARS]; /**< (Fluid only) Array of pointers to 3D arrays
                                      to be written - same for all outputs. */
-  char   fill[140];    /**< Useless, just to make the structure size a power of 2 */
+  char   fill[72];     /**< Useless, just to make the structure size a power of 2 */
 } Output;
 
 /* ********************************************************************* */
@@ -449,6 +455,11 @@ typedef struct Runtime_{
   double  cfl;               /**< Hyperbolic cfl number (\c CFL) */
   double  cfl_max_var;       /**< Maximum increment between consecutive time
                                   steps (\c CFL_max_var). */
+  double  cfl_min;           /**< Smallest cfl number of AdaptCFLCheck() */
+  double  cfl_max;           /**< Largest cfl number of AdaptCFLCheck(),
+                                  negative if disabled (\c CFL_adapt) */
+  double  cfl_mach_var;      /**< Largest relative change of the Mach
+                                  number in a quiet step */
   double  cfl_par;           /**< (STS) parabolic  cfl number */
   double  rmax_par;          /**< (STS) max ratio between current time
                                 step and parabolic time step */
@@ -461,6 +472,20 @@ typedef struct Runtime_{
   double particles_tstart;  /**< Time at which particles are integrated */
   int     Nparticles_glob;  /**< Total number of particles in the whole domain */
   int     Nparticles_cell;  /**< Total number of particles per cell */
+
+  double  march_tol;       /**< Tolerance of MarchSteadyState(), negative
+                                if disabled ( \c march ) */
+  double  march_t0;        /**< Initial time of a marched run */
+  int     march_maxit;     /**< Maximum number of iterations per shell */
+  double  steady_tol;      /**< Tolerance of SteadyMonitor(), negative
+                                if disabled ( \c steady ) */
+  double  steady_dt;       /**< Time between steady-state checks */
+  int     steady_nstall;   /**< Checks without improvement before stop */
+  char    prolong_dir[256]; /**< Output directory of a coarser run whose
+                                 result is the initial condition
+                                 ( \c prolong ) */
+  int     prolong_nfile;   /**< Number of that \c .dbl file, negative if
+                                disabled */
     
   double  aux[32];         /* we keep aux inside this structure, 
                               since in parallel execution it has
@@ -512,14 +537,16 @@ typedef struct intList_{
    ********************************************************************* */
 
 typedef struct Data_{
-  double ****Vc;    /**< The main four-index data array used for cell-centered
-                        primitive variables. The index order is
+  Data_Arr Vc;      /**< The main four-index data array used for cell-centered
+                        primitive variables (single precision with
+                        MIXED_PRECISION). The index order is
                         <tt>Vc[nv][k][j][i]</tt> where \c nv gives the variable
                         index while \c k,\c j and \c i are the
                         locations of the cell in the \f$x_3\f$,
                         \f$x_2\f$ and \f$x_1\f$ direction. */
-  double ****Uc;    /**< The main four-index data array used for cell-centered
-                       conservative variables. The index order is
+  Data_Arr Uc;      /**< The main four-index data array used for cell-centered
+                       conservative variables (single precision with
+                       MIXED_PRECISION). The index order is
                        <tt>Uc[k][j][i][nv]</tt> (\c nv fast running index)
                        where \c nv gives the variable index, \c k,\c j and \c i
                        are the locations of the cell in the \f$x_3\f$,
@@ -540,6 +567,8 @@ typedef struct Data_{
   double ***q;      /**< Electric charge density (only for ResRMHD)    */
   uint16_t ***flag; /**< Pointer to a 3D array setting useful integration
                          flags that are retrieved during integration. */
+  double ****dVh;   /**< Half time-step increment of primitive variables,
+                         <tt>dVh[k][j][i][nv]</tt> (MUSCL_HANCOCK only). */
 
   /* -- Particles-related quantities -- */
 
@@ -571,6 +600,6 @@ typedef struct Data_{
   
   void (*fluidRiemannSolver)     (const Sweep *, int, int, double *, Grid *);
   void (*radiationRiemannSolver) (const Sweep *, int, int, double *, Grid *);
-  char fill[54];  /* make the structure a power of two.  */
+  char fill[46];  /* make the structure a power of two.  */
 } Data;
 
@@ -336,6 +336,28 @@ void MakeState (Sweep *sweep)
   stateR->Bbck   = stateL->Bbck;
 }
 
+/* ********************************************************************* */
+double OutputFrameAngle (double t)
+/*!
+ * Return the angle by which the computational frame has turned about
+ * the z-axis, at time t, with respect to the frame in which VTK outputs
+ * and probes are given.
+ * A point at longitude \f$\phi\f$ on the grid is at longitude
+ * \f$\phi + \Delta\phi\f$ in the output frame, where its azimuthal
+ * velocity is larger by \f$\Omega_{\rm out} r\sin\theta\f$.
+ *
+ * \param [in] t   the simulation time
+ * \return The angle \f$\Delta\phi = \Omega_{\rm out}(t - t_{\rm out})\f$,
+ *         zero without a rotating frame.
+ *********************************************************************** */
+{
+#if ROTATING_FRAME == YES
+  return g_OmegaZout*(t - g_tOmegaZout);
+#else
+  return 0.0;
+#endif
+}
+
 /* ********************************************************************* */
 void PlutoError (int condition, char *str)
 /*!
@@ -440,9 +462,9 @@ void SymmetryCheck (Data_Arr V, int where, RBox *box)
 #else
   int i,j,k;
   int ip, jp;
-  double ***Vx1 = V[0];
-  double ***Vx2 = V[1];
-  double ***Vx3 = V[2];
+  Data_Type ***Vx1 = V[0];
+  Data_Type ***Vx2 = V[1];
+  Data_Type ***Vx3 = V[2];
   double scrh1 = 0.0, scrh2 = 0.0, scrh3 = 0.0;
 
   BOX_LOOP(box,k,j,i){
@@ -9,6 +9,10 @@
   - For .dbl, .flt or .vtk file formats, access to binary files is 
     provided by the functions in bin_io.c.
   - HDF5 files are handled by hdf5_io.c.
+  - NetCDF-4 files are handled by nc_io.c.
+  - XML VTK (.pvts / .vts) files are handled by write_vts.c.
+  - coarsened VTK files (quick-look levels) are handled by
+    write_pyramid.c.
   - image files are handled by write_img.c
   - tabulated ascii files are handled by write_tab.c
 
@@ -42,11 +46,17 @@ void WriteData (const Data *d, Output *output, Grid *grid)
   char   filename[512], sline[512];
   static int last_computed_var = -1;
   double units[MAX_OUTPUT_VARS]; 
-  float ***Vpt3;
   #ifdef FARGO
   static double ***vphi_res;
   double **wA = FARGO_Velocity();
   #endif
+  #if (ROTATING_FRAME == YES) && (GEOMETRY == SPHERICAL)
+  int out_frame;
+  static double ***vphi_frame;
+  #endif
+  #if MIXED_PRECISION == YES
+  static double ****Vout;
+  #endif
   void *Vpt;
   FILE *fout, *fbin;
   time_t tbeg, tend;
@@ -90,6 +100,47 @@ void WriteData (const Data *d, Output *output, Grid *grid)
   #endif
 #endif
 
+/* --------------------------------------------------------
+   2b. VTK files are given in the output frame (see
+       OutputFrameAngle()): add the rotation velocity of
+       the computational frame and, with FARGO, the mean
+       orbital velocity.
+   -------------------------------------------------------- */
+
+#if (ROTATING_FRAME == YES) && (GEOMETRY == SPHERICAL)
+  #if (defined FARGO) && (FARGO_OUTPUT_VTOT == NO)
+  out_frame = YES;
+  #else
+  out_frame = (g_OmegaZout != 0.0);
+  #endif
+  out_frame = out_frame && (   output->type == VTK_OUTPUT
+                            || output->type == VTS_OUTPUT
+                            || output->type == PYR_OUTPUT);
+  if (out_frame){
+    if (vphi_frame == NULL) vphi_frame = ARRAY_3D(NX3_TOT, NX2_TOT, NX1_TOT, double);
+    TOT_LOOP(k,j,i){
+      vphi_frame[k][j][i]  = d->Vc[VX3][k][j][i];
+      d->Vc[VX3][k][j][i] += g_OmegaZout*grid->x[IDIR][i]*sin(grid->x[JDIR][j]);
+      #if (defined FARGO) && (FARGO_OUTPUT_VTOT == NO)
+      d->Vc[VX3][k][j][i] += wA[j][i];
+      #endif
+    }
+  }
+#endif
+
+/* --------------------------------------------------------
+   2c. With MIXED_PRECISION the writers are given double
+       copies of d->Vc. They only exist during output.
+   -------------------------------------------------------- */
+
+#if MIXED_PRECISION == YES
+  if (Vout == NULL) Vout = ARRAY_4D(NVAR, NX3_TOT, NX2_TOT, NX1_TOT, double);
+  NVAR_LOOP(nv) {
+    output->V[nv] = Vout[nv];
+    TOT_LOOP(k,j,i) Vout[nv][k][j][i] = d->Vc[nv][k][j][i];
+  }
+#endif
+
 /* --------------------------------------------------------
    3. Select the output type 
    -------------------------------------------------------- */
@@ -212,10 +263,7 @@ void WriteData (const Data *d, Output *output, Grid *grid)
       fbin = FileOpen (filename, SZ_float, "w");
       for (nv = 0; nv < output->nvar; nv++) {
         if (!output->dump_var[nv]) continue;
-        Vpt3 = Convert_dbl2flt(output->V[nv], units[nv],0);
-        Vpt = (void *)Vpt3[0][0];
-        FileWriteData (Vpt, sizeof(float), SZ_float, fbin, 
-                          output->stag_var[nv]);
+        FileWriteFloat (output->V[nv], units[nv], 0, SZ_float, fbin);
       }
       FileClose(fbin, SZ_float);
 /*
@@ -230,10 +278,7 @@ BOV_Header(output, filename);
 
         FileDelete (filename);  /* Avoid partial fill of pre-existing files */
         fbin = FileOpen (filename, SZ_float, "w");
-        Vpt3 = Convert_dbl2flt(output->V[nv], units[nv],0);
-        Vpt = (void *)Vpt3[0][0];
-        FileWriteData (Vpt, sizeof(float), SZ_float, fbin, 
-                          output->stag_var[nv]);
+        FileWriteFloat (output->V[nv], units[nv], 0, SZ_float, fbin);
         FileClose (fbin, SZ_float);
       }
     }
@@ -252,6 +297,20 @@ BOV_Header(output, filename);
     return;
     #endif
 
+  }else if (output->type == NETCDF_OUTPUT){
+
+  /* ------------------------------------------------------
+     3c'. NetCDF-4 output: all snapshots in one file
+     ------------------------------------------------------ */
+
+    #ifdef USE_NETCDF
+    single_file = YES;
+    WriteNetCDF (output, grid);
+    #else
+    print ("! WriteData: NetCDF library not available\n");
+    return;
+    #endif
+
   }else if (output->type == VTK_OUTPUT) { 
 
   /* -------------------------------------------------------------------
@@ -335,6 +394,24 @@ BOV_Header(output, filename);
       }
     }
 
+  }else if (output->type == VTS_OUTPUT) { 
+
+  /* ------------------------------------------------------
+     3d'. XML VTK output: one .vts piece per processor
+     ------------------------------------------------------ */
+
+    single_file = NO;
+    WriteVTS (output, grid);
+
+  }else if (output->type == PYR_OUTPUT) { 
+
+  /* ------------------------------------------------------
+     3d''. Coarsened VTK files for quick-look viewers
+     ------------------------------------------------------ */
+
+    single_file = NO;
+    WritePyramid (output, grid);
+
   }else if (output->type == TAB_OUTPUT) { 
 
   /* ------------------------------------------------------
@@ -414,12 +491,24 @@ BOV_Header(output, filename);
     fclose (fout);
   }
 
+/* -- Restore velocities of the computational frame -- */
+
+  #if (ROTATING_FRAME == YES) && (GEOMETRY == SPHERICAL)
+  if (out_frame) TOT_LOOP(k,j,i) d->Vc[VX3][k][j][i] = vphi_frame[k][j][i];
+  #endif
+
 /* -- Copy residual back onto main array -- */
 
   #if (defined FARGO) &&  (FARGO_OUTPUT_VTOT == YES)
   TOT_LOOP(k,j,i) d->Vc[VX1+SDIR][k][j][i] = vphi_res[k][j][i];
   #endif
 
+  #if MIXED_PRECISION == YES
+  FreeArray4D ((void *) Vout);
+  Vout = NULL;
+  NVAR_LOOP(nv) output->V[nv] = NULL;
+  #endif
+
   #ifdef PARALLEL
   MPI_Barrier (MPI_COMM_WORLD);
   if (prank == 0){
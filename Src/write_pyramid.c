@@ -0,0 +1,399 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Write coarsened copies of a snapshot for quick-look viewers.
+
+  WritePyramid() writes, for every snapshot, \c PYR_LEVELS coarse
+  versions of the cell-centered output variables: level \c l is
+  coarsened by a factor 2^l in every direction, each coarse zone being
+  the volume-weighted average (with \c grid->dV) of the fine zones it
+  contains.
+  Level \c l goes into one legacy VTK file
+  <tt> data.nnnn.l<l>.vtk </tt>, with the same layout as the
+  full-resolution .vtk files (big endian single precision scalars,
+  rectilinear or structured grid depending on the geometry), so that a
+  viewer can load a coarse level first and fetch the full-resolution
+  file only on demand.
+  When the number of zones is not a multiple of the coarsening factor,
+  the last coarse zone in that direction is smaller.
+
+  Output is enabled from the <tt> [Static Grid Output] </tt> section
+  of pluto.ini with
+  \verbatim
+   pyr   0.04166666666666666  -1   [cgs]
+  \endverbatim
+  and the files are listed in <tt> pyr.out </tt>.
+  Variables are selected as for the other formats, with
+  SetOutputVar (name, PYR_OUTPUT, NO) in ChangeOutputVar().
+  Vector fields are written as scalar components.
+
+  Coarsening is done by the processes owning the fine zones.
+  A coarse zone cut by process boundaries is completed one direction
+  at a time, from right to left: each process first adds the partial
+  sums received from its right neighbour and then sends its own lower
+  layer to the left one, so that a coarse zone may span any number of
+  processes.
+  Each coarse zone is then written by the process owning its first
+  fine zone with a collective MPI-IO call.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include "pluto.h"
+
+#ifndef PYR_LEVELS
+ #define PYR_LEVELS  2   /* Levels coarsened by 2, 4, ... 2^PYR_LEVELS */
+#endif
+
+#ifndef VTK_TIME_INFO
+ #define VTK_TIME_INFO  NO
+#endif
+
+static long PyrHeader (FILE *, int, int *, Grid *);
+static void PyrLayer (double *, double *, int, int, int *, int, int);
+
+/* ********************************************************************* */
+void WritePyramid (Output *output, Grid *grid)
+/*!
+ * Coarsen the output variables by 2, 4, ..., 2^PYR_LEVELS and write
+ * one VTK file per level.
+ * Must be called by all processes.
+ *
+ * \param [in] output the output structure associated with PYR format
+ * \param [in] grid   a pointer to an array of Grid structures
+ *********************************************************************** */
+{
+  int    i, j, k, nv, m, nw, lev, f, dir, own;
+  int    fac[3], nc[3], c0[3], c1[3], co[3], nloc[3], nown[3], gofs[3];
+  int    include_dir[] = {INCLUDE_IDIR, INCLUDE_JDIR, INCLUDE_KDIR};
+  int    var[MAX_OUTPUT_VARS];
+  char   fname[512], label[128];
+  long   n, nq, cnt, ncell, header_len;
+  double units[MAX_OUTPUT_VARS], dV;
+  float  q;
+  static double *sum;
+  static float  *fbuf;
+  FILE   *fp;
+  #ifdef PARALLEL
+  int    sizes[3], subsizes[3], starts[3];
+  int    left, right, send, recv;
+  long   nlayer;
+  static double *lbuf;
+  MPI_Comm     cart, comm;
+  MPI_File     fh;
+  MPI_Datatype ftype;
+  MPI_Offset   offset;
+  #else
+  long   offset;
+  #endif
+
+  for (nv = 0; nv < MAX_OUTPUT_VARS; nv++) units[nv] = 1.0;
+  if (output->cgs) GetCGSUnits(units);
+
+  nw = 0;
+  for (nv = 0; nv < output->nvar; nv++){
+    if (output->dump_var[nv] && output->stag_var[nv] == -1) var[nw++] = nv;
+  }
+
+/* --------------------------------------------------------
+   0. Buffers are sized for the first level (the largest):
+      nw sums + volume over the local coarse zones, with
+      one extra partial zone on each side
+   -------------------------------------------------------- */
+
+  nq = 1;
+  for (dir = 0; dir < 3; dir++){
+    nloc[dir] = include_dir[dir] ? (grid->np_int[dir] + 1)/2 + 1:1;
+    nq       *= nloc[dir];
+  }
+  if (sum == NULL){
+    sum  = ARRAY_1D((MAX_OUTPUT_VARS + 1)*nq, double);
+    fbuf = ARRAY_1D(nq, float);
+    #ifdef PARALLEL
+    lbuf = ARRAY_1D((MAX_OUTPUT_VARS + 1)*nq, double);
+    #endif
+  }
+
+  for (lev = 1; lev <= PYR_LEVELS; lev++){
+    f = 1 << lev;
+
+  /* --------------------------------------------------------
+     1. Global coarse size nc[], local coarse range
+        c0..c1 (including partial zones) and first
+        coarse zone owned by this process co[]
+     -------------------------------------------------------- */
+
+    nq = 1;
+    own = 1;
+    ncell = 1;
+    for (dir = 0; dir < 3; dir++){
+      fac[dir]  = include_dir[dir] ? f:1;
+      gofs[dir] = grid->beg[dir] - grid->nghost[dir] - grid->lbeg[dir];
+      i         = grid->beg[dir] - grid->nghost[dir];
+      j         = grid->end[dir] - grid->nghost[dir];
+      nc[dir]   = (grid->np_int_glob[dir] + fac[dir] - 1)/fac[dir];
+      c0[dir]   = i/fac[dir];
+      c1[dir]   = j/fac[dir];
+      co[dir]   = (i + fac[dir] - 1)/fac[dir];
+      nloc[dir] = c1[dir] - c0[dir] + 1;
+      nown[dir] = c1[dir] - co[dir] + 1;
+      nq    *= nloc[dir];
+      ncell *= nc[dir];
+      own    = own && (nown[dir] > 0);
+    }
+
+  /* --------------------------------------------------------
+     2. Accumulate V*dV and dV on the local coarse zones
+     -------------------------------------------------------- */
+
+    for (n = 0; n < (nw + 1)*nq; n++) sum[n] = 0.0;
+    DOM_LOOP(k,j,i){
+      n  = (k + gofs[KDIR])/fac[KDIR] - c0[KDIR];
+      n  = n*nloc[JDIR] + (j + gofs[JDIR])/fac[JDIR] - c0[JDIR];
+      n  = n*nloc[IDIR] + (i + gofs[IDIR])/fac[IDIR] - c0[IDIR];
+      dV = grid->dV[k][j][i];
+      for (m = 0; m < nw; m++) sum[m*nq + n] += output->V[var[m]][k][j][i]*dV;
+      sum[nw*nq + n] += dV;
+    }
+
+  /* --------------------------------------------------------
+     3. Complete coarse zones cut by process boundaries,
+        right to left: add the upper layer received from the
+        right neighbour, then send the lower layer (which
+        is the same one when nloc = 1) to the left neighbour
+     -------------------------------------------------------- */
+
+    #ifdef PARALLEL
+    AL_Get_cart_comm (SZ, &cart);
+    for (dir = 0; dir < DIMENSIONS; dir++){
+      if (grid->nproc[dir] == 1) continue;
+      MPI_Cart_shift (cart, dir, 1, &left, &right);
+      i = grid->beg[dir] - grid->nghost[dir];
+      j = grid->end[dir] - grid->nghost[dir];
+      send = (i%fac[dir] != 0);
+      recv = ((j + 1)%fac[dir] != 0) && (j + 1 < grid->np_int_glob[dir]);
+      nlayer = (nw + 1)*nq/nloc[dir];
+      if (recv){
+        MPI_Recv (lbuf, nlayer, MPI_DOUBLE, right, lev, cart,
+                  MPI_STATUS_IGNORE);
+        PyrLayer (sum, lbuf, dir, nloc[dir] - 1, nloc, nw + 1, 1);
+      }
+      if (send){
+        PyrLayer (sum, lbuf, dir, 0, nloc, nw + 1, 0);
+        MPI_Send (lbuf, nlayer, MPI_DOUBLE, left, lev, cart);
+      }
+    }
+    #endif
+
+  /* --------------------------------------------------------
+     4. Processor 0 writes the file header and the label
+        of each variable; data blocks are filled below
+     -------------------------------------------------------- */
+
+    sprintf (fname, "%s/data.%04d.l%d.vtk", output->dir, output->nfile, lev);
+    header_len = 0;
+    if (prank == 0){
+      fp = fopen (fname, "wb");
+      if (fp == NULL){
+        printLog ("! WritePyramid(): cannot open file %s\n", fname);
+        QUIT_PLUTO(1);
+      }
+      header_len = PyrHeader (fp, lev, nc, grid);
+      offset = header_len;
+      for (m = 0; m < nw; m++){
+        sprintf (label, "\nSCALARS %s float\nLOOKUP_TABLE default\n",
+                 output->var_name[var[m]]);
+        fseek (fp, offset, SEEK_SET);
+        fwrite (label, 1, strlen(label), fp);
+        offset += strlen(label) + ncell*sizeof(float);
+      }
+      fclose (fp);
+    }
+
+    #ifdef PARALLEL
+    MPI_Bcast (&header_len, 1, MPI_LONG, 0, MPI_COMM_WORLD);
+    MPI_Comm_split (MPI_COMM_WORLD, own ? 0:MPI_UNDEFINED, prank, &comm);
+    if (!own) continue;
+
+    for (dir = 0; dir < 3; dir++){
+      sizes[2-dir]    = nc[dir];
+      subsizes[2-dir] = nown[dir];
+      starts[2-dir]   = co[dir];
+    }
+    MPI_Type_create_subarray (3, sizes, subsizes, starts, MPI_ORDER_C,
+                              MPI_FLOAT, &ftype);
+    MPI_Type_commit (&ftype);
+    MPI_File_open (comm, fname, MPI_MODE_WRONLY, MPI_INFO_NULL, &fh);
+    #else
+    fp = fopen (fname, "r+b");
+    #endif
+
+  /* --------------------------------------------------------
+     5. Divide by the volume and write the owned zones
+     -------------------------------------------------------- */
+
+    offset = header_len;
+    for (m = 0; m < nw; m++){
+      sprintf (label, "\nSCALARS %s float\nLOOKUP_TABLE default\n",
+               output->var_name[var[m]]);
+      offset += strlen(label);
+
+      cnt = 0;
+      for (k = co[KDIR] - c0[KDIR]; k < nloc[KDIR]; k++){
+      for (j = co[JDIR] - c0[JDIR]; j < nloc[JDIR]; j++){
+      for (i = co[IDIR] - c0[IDIR]; i < nloc[IDIR]; i++){
+        n = ((long)k*nloc[JDIR] + j)*nloc[IDIR] + i;
+        q = (float)(sum[m*nq + n]/sum[nw*nq + n]*units[var[m]]);
+        if (IsLittleEndian()) SWAP_VAR(q);
+        fbuf[cnt++] = q;
+      }}}
+
+      #ifdef PARALLEL
+      MPI_File_set_view (fh, offset, MPI_FLOAT, ftype, "native",
+                         MPI_INFO_NULL);
+      MPI_File_write_all (fh, fbuf, cnt, MPI_FLOAT, MPI_STATUS_IGNORE);
+      #else
+      fseek (fp, offset, SEEK_SET);
+      fwrite (fbuf, sizeof(float), cnt, fp);
+      #endif
+      offset += ncell*sizeof(float);
+    }
+
+    #ifdef PARALLEL
+    MPI_File_close (&fh);
+    MPI_Type_free (&ftype);
+    MPI_Comm_free (&comm);
+    #else
+    fclose (fp);
+    #endif
+  }
+}
+
+/* ********************************************************************* */
+long PyrHeader (FILE *fp, int lev, int *nc, Grid *grid)
+/*!
+ * Write the VTK header of level lev (up to and including the
+ * CELL_DATA line) at the beginning of the file and return its length
+ * in bytes.
+ * Node coordinates are those of the full grid taken every 2^lev
+ * zones (see WriteVTK_Header()).
+ *********************************************************************** */
+{
+  int    i, j, k, dir, f = 1 << lev;
+  int    include_dir[] = {INCLUDE_IDIR, INCLUDE_JDIR, INCLUDE_KDIR};
+  int    nn[3];
+  #if GEOMETRY == CARTESIAN || GEOMETRY == CYLINDRICAL
+  int    n, beg[3] = {IBEG, JBEG, KBEG};
+  #endif
+  long   len;
+  float  x[3], xyz[3];
+  double tt, dphi = OutputFrameAngle(g_time);
+
+  for (dir = 0; dir < 3; dir++) nn[dir] = nc[dir] + include_dir[dir];
+
+  fprintf (fp, "# vtk DataFile Version 2.0\n");
+  fprintf (fp, "PLUTO %s VTK Data (coarsened by %d)\n", PLUTO_VERSION, f);
+  fprintf (fp, "BINARY\n");
+  #if GEOMETRY == CARTESIAN || GEOMETRY == CYLINDRICAL
+  fprintf (fp, "DATASET RECTILINEAR_GRID\n");
+  #else
+  fprintf (fp, "DATASET STRUCTURED_GRID\n");
+  #endif
+
+  #if VTK_TIME_INFO == YES
+  fprintf (fp, "FIELD FieldData 1\n");
+  fprintf (fp, "TIME 1 1 double\n");
+  tt = g_time;
+  if (IsLittleEndian()) SWAP_VAR(tt);
+  fwrite (&tt, sizeof(double), 1, fp);
+  fprintf (fp, "\n");
+  #endif
+  fprintf (fp, "DIMENSIONS %d %d %d\n", nn[IDIR], nn[JDIR], nn[KDIR]);
+
+/* -- Node n of level lev is node min(n*2^lev, N) of the full grid -- */
+
+  #if GEOMETRY == CARTESIAN || GEOMETRY == CYLINDRICAL
+  for (dir = 0; dir < 3; dir++){
+    fprintf (fp, "%sCOORDINATES %d float\n", dir == IDIR ? "X_":
+                 (dir == JDIR ? "\nY_":"\nZ_"), nn[dir]);
+    for (n = 0; n < nn[dir]; n++){
+      x[0] = 0.0;
+      if (include_dir[dir]){
+        i    = MIN(n*f, grid->np_int_glob[dir]);
+        x[0] = (float)grid->xl_glob[dir][beg[dir] + i];
+      }
+      if (IsLittleEndian()) SWAP_VAR(x[0]);
+      fwrite (x, sizeof(float), 1, fp);
+    }
+  }
+  #else
+  fprintf (fp, "POINTS %ld float\n", (long)nn[IDIR]*nn[JDIR]*nn[KDIR]);
+  x[0] = x[1] = x[2] = 0.0;
+  for (k = 0; k < nn[KDIR]; k++){
+  for (j = 0; j < nn[JDIR]; j++){
+  for (i = 0; i < nn[IDIR]; i++){
+    DIM_EXPAND(
+      x[0] = grid->xl_glob[IDIR][IBEG + MIN(i*f, grid->np_int_glob[IDIR])];  ,
+      x[1] = grid->xl_glob[JDIR][JBEG + MIN(j*f, grid->np_int_glob[JDIR])];  ,
+      x[2] = grid->xl_glob[KDIR][KBEG + MIN(k*f, grid->np_int_glob[KDIR])];)
+
+    #if GEOMETRY == POLAR
+    xyz[0] = x[0]*cos(x[1]);
+    xyz[1] = x[0]*sin(x[1]);
+    xyz[2] = x[2];
+    #elif GEOMETRY == SPHERICAL
+    #if DIMENSIONS == 2
+    xyz[0] = x[0]*sin(x[1]);
+    xyz[1] = x[0]*cos(x[1]);
+    xyz[2] = 0.0;
+    #else
+    x[2] += dphi;   /* Longitude in the output frame */
+    xyz[0] = x[0]*sin(x[1])*cos(x[2]);
+    xyz[1] = x[0]*sin(x[1])*sin(x[2]);
+    xyz[2] = x[0]*cos(x[1]);
+    #endif
+    #endif
+    if (IsLittleEndian()){
+      SWAP_VAR(xyz[0]);
+      SWAP_VAR(xyz[1]);
+      SWAP_VAR(xyz[2]);
+    }
+    fwrite (xyz, sizeof(float), 3, fp);
+  }}}
+  #endif
+
+  fprintf (fp, "\nCELL_DATA %ld\n", (long)nc[IDIR]*nc[JDIR]*nc[KDIR]);
+  len = ftell (fp);
+  return len;
+}
+
+/* ********************************************************************* */
+void PyrLayer (double *s, double *buf, int dir, int p, int *nloc,
+               int nq, int add)
+/*!
+ * Copy the layer p in direction dir of the nq arrays s (stored one
+ * after the other, x1 index running fastest) into buf (add = 0), or
+ * add buf to it (add = 1).
+ *********************************************************************** */
+{
+  int  i, j, k, m;
+  int  b[3][2];
+  long n, cnt = 0, nvol = (long)nloc[IDIR]*nloc[JDIR]*nloc[KDIR];
+
+  for (i = 0; i < 3; i++){
+    b[i][0] = 0;
+    b[i][1] = nloc[i] - 1;
+  }
+  b[dir][0] = b[dir][1] = p;
+
+  for (m = 0; m < nq; m++){
+    for (k = b[KDIR][0]; k <= b[KDIR][1]; k++){
+    for (j = b[JDIR][0]; j <= b[JDIR][1]; j++){
+    for (i = b[IDIR][0]; i <= b[IDIR][1]; i++){
+      n = m*nvol + ((long)k*nloc[JDIR] + j)*nloc[IDIR] + i;
+      if (add) s[n] += buf[cnt++];
+      else     buf[cnt++] = s[n];
+    }}}
+  }
+}
@@ -105,6 +105,7 @@ void WriteVTK_Header (FILE *fvtk, Grid *grid)
   long int nx1, nx2, nx3;
   char     header[128];
   float    x1, x2, x3;
+  double   dphi = OutputFrameAngle(g_time);
   static float  **node_coord, *xnode, *ynode, *znode;
 
 /* -- Get global domain sizes -- */
@@ -236,6 +237,7 @@ void WriteVTK_Header (FILE *fvtk, Grid *grid)
       node_coord[i][1] = x1*cos(x2);
       node_coord[i][2] = 0.0;
       #elif DIMENSIONS == 3
+      x3 += dphi;   /* Longitude in the output frame */
       node_coord[i][0] = x1*sin(x2)*cos(x3);
       node_coord[i][1] = x1*sin(x2)*sin(x3);
       node_coord[i][2] = x1*cos(x2);
@@ -265,7 +267,7 @@ void WriteVTK_Header (FILE *fvtk, Grid *grid)
 #undef VTK_RECTILINEAR_GRID  
 
 /* ********************************************************************* */
-void WriteVTK_Vector (FILE *fvtk, Data_Arr V, double unit,
+void WriteVTK_Vector (FILE *fvtk, double ****V, double unit,
                       char *var_name, Grid *grid)
 /*!
  * Write VTK vector field data.
@@ -303,6 +305,7 @@ void WriteVTK_Vector (FILE *fvtk, Data_Arr V, double unit,
   char header[128];
   static Float_Vect ***vect3D;
   double v[3], x1, x2, x3;
+  double dphi = OutputFrameAngle(g_time);
 
   if (vect3D == NULL){
     vect3D = ARRAY_3D(NX3_TOT, NX2_TOT, NX1_TOT, Float_Vect);
@@ -322,6 +325,9 @@ void WriteVTK_Vector (FILE *fvtk, Data_Arr V, double unit,
       DIM_EXPAND(v[0] = V[0][k][j][i]; x1 = grid->x[IDIR][i]; ,
                  v[1] = V[1][k][j][i]; x2 = grid->x[JDIR][j]; ,
                  v[2] = V[2][k][j][i]; x3 = grid->x[KDIR][k];)
+      #if GEOMETRY == SPHERICAL && DIMENSIONS == 3
+      x3 += dphi;
+      #endif
    
       VectorCartesianComponents(v, x1, x2, x3);
       vect3D[k][j][i].v1 = (float)v[0]*unit;
@@ -361,7 +367,6 @@ void WriteVTK_Scalar (FILE *fvtk, double ***V, double unit,
 {
   int i,j,k;
   char header[128];
-  float ***Vflt;
 
   sprintf (header,"\nSCALARS %s float\n", var_name);
   sprintf (header+strlen(header),"LOOKUP_TABLE default\n");
@@ -374,6 +379,5 @@ void WriteVTK_Scalar (FILE *fvtk, double ***V, double unit,
    fprintf (fvtk, "%s",header);
   #endif
 
-  Vflt = Convert_dbl2flt(V, unit, IsLittleEndian());
-  FileWriteData (Vflt[0][0], sizeof(float), SZ_float, fvtk, -1);
+  FileWriteFloat (V, unit, IsLittleEndian(), SZ_float, fvtk);
 }
@@ -0,0 +1,284 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Write data in XML VTK structured grid format (.pvts / .vts).
+
+  WriteVTS() writes one snapshot as a collection of pieces, one per
+  processor, plus a small index file:
+
+  - each processor independently writes its own block of the mesh to
+    <tt> data.nnnn.pppp.vts </tt> (nnnn = file number, pppp = rank),
+    without any collective I/O;
+  - processor 0 writes <tt> data.nnnn.pvts </tt>, listing the extent and
+    file name of all pieces.
+
+  Pieces use the \e appended raw binary encoding in native byte order
+  (no endian swapping), with 64-bit block size headers.
+  Node coordinates are written as Cartesian points (as for legacy VTK
+  files in structured grid mode); cell data are written in single
+  precision.
+  When \c VTK_VECTOR_DUMP is enabled, velocity and magnetic field are
+  written as 3-component vectors in Cartesian components.
+  The simulation time is stored in the \c TimeValue field data array.
+
+  The .pvts file can be opened directly with ParaView or VisIt.
+
+  \b Reference
+
+  https://vtk.org/wp-content/uploads/2015/04/file-formats.pdf
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include "pluto.h"
+
+static void VTS_Points (float *, Grid *);
+static void VTS_Vector (float *, double ****, double, Grid *);
+
+/* ********************************************************************* */
+void WriteVTS (Output *output, Grid *grid)
+/*!
+ * Write the local .vts piece and (rank 0 only) the .pvts index file.
+ *
+ * \param [in] output the output structure associated with VTS format
+ * \param [in] grid   a pointer to an array of Grid structures
+ *********************************************************************** */
+{
+  int    i, j, k, nv, n, p, ncomp, nproc = 1;
+  int    ext[6], *ext_all;
+  int    include_dir[] = {INCLUDE_IDIR, INCLUDE_JDIR, INCLUDE_KDIR};
+  char   fname[512], piece[64], *btype, *vname[MAX_OUTPUT_VARS];
+  char   vec_name[2][32];
+  double units[MAX_OUTPUT_VARS];
+  long int ncell, npoint;
+  uint64_t nbytes, offset;
+  FILE   *fp;
+  static float *buf;
+
+  btype = IsLittleEndian() ? "LittleEndian":"BigEndian";
+  for (nv = 0; nv < MAX_OUTPUT_VARS; nv++) units[nv] = 1.0;
+  if (output->cgs) GetCGSUnits(units);
+
+  sprintf (vec_name[0], "%dD_Velocity_Field", DIMENSIONS);
+  sprintf (vec_name[1], "%dD_Magnetic_Field", DIMENSIONS);
+
+/* --------------------------------------------------------
+   0. Local node extent (global node indices) and names
+      of the arrays being written
+   -------------------------------------------------------- */
+
+  for (n = 0; n < 3; n++){
+    ext[2*n]     = grid->beg[n] - grid->gbeg[n];
+    ext[2*n + 1] = grid->end[n] - grid->gbeg[n] + include_dir[n];
+  }
+  ncell  = (long int)NX1*NX2*NX3;
+  npoint = (long int)(NX1 + INCLUDE_IDIR)*(NX2 + INCLUDE_JDIR)*(NX3 + INCLUDE_KDIR);
+
+  if (buf == NULL) buf = ARRAY_1D(3*MAX(ncell,npoint), float);
+
+  for (nv = 0; nv < output->nvar; nv++){
+    vname[nv] = output->var_name[nv];
+    if (output->dump_var[nv] == VTK_VECTOR){
+      if      (strcmp(output->var_name[nv],"vx1") == 0) vname[nv] = vec_name[0];
+      else if (strcmp(output->var_name[nv],"Bx1") == 0) vname[nv] = vec_name[1];
+    }
+  }
+
+/* --------------------------------------------------------
+   1. Write the XML header of the local piece
+   -------------------------------------------------------- */
+
+  sprintf (piece, "data.%04d.%04d.%s", output->nfile, prank, output->ext);
+  sprintf (fname, "%s/%s", output->dir, piece);
+  fp = fopen (fname, "wb");
+  if (fp == NULL){
+    printLog ("! WriteVTS(): cannot open file %s\n", fname);
+    QUIT_PLUTO(1);
+  }
+
+  fprintf (fp, "<?xml version=\"1.0\"?>\n");
+  fprintf (fp, "<VTKFile type=\"StructuredGrid\" version=\"1.0\" "
+               "byte_order=\"%s\" header_type=\"UInt64\">\n", btype);
+  fprintf (fp, "  <StructuredGrid WholeExtent=\"%d %d %d %d %d %d\">\n",
+               ext[0], ext[1], ext[2], ext[3], ext[4], ext[5]);
+  fprintf (fp, "    <FieldData>\n");
+  fprintf (fp, "      <DataArray type=\"Float64\" Name=\"TimeValue\" "
+               "NumberOfTuples=\"1\" format=\"ascii\"> %18.12e </DataArray>\n",
+               g_time);
+  fprintf (fp, "    </FieldData>\n");
+  fprintf (fp, "    <Piece Extent=\"%d %d %d %d %d %d\">\n",
+               ext[0], ext[1], ext[2], ext[3], ext[4], ext[5]);
+  fprintf (fp, "      <CellData>\n");
+
+  offset = 0;
+  for (nv = 0; nv < output->nvar; nv++){
+    if (output->stag_var[nv] != -1) continue;
+    if      (output->dump_var[nv] == YES)        ncomp = 1;
+    else if (output->dump_var[nv] == VTK_VECTOR) ncomp = 3;
+    else continue;
+    fprintf (fp, "        <DataArray type=\"Float32\" Name=\"%s\" "
+                 "NumberOfComponents=\"%d\" format=\"appended\" "
+                 "offset=\"%lu\"/>\n", vname[nv], ncomp, (unsigned long)offset);
+    offset += sizeof(uint64_t) + ncomp*ncell*sizeof(float);
+  }
+  fprintf (fp, "      </CellData>\n");
+  fprintf (fp, "      <Points>\n");
+  fprintf (fp, "        <DataArray type=\"Float32\" NumberOfComponents=\"3\" "
+               "format=\"appended\" offset=\"%lu\"/>\n", (unsigned long)offset);
+  fprintf (fp, "      </Points>\n");
+  fprintf (fp, "    </Piece>\n");
+  fprintf (fp, "  </StructuredGrid>\n");
+  fprintf (fp, "  <AppendedData encoding=\"raw\">\n_");
+
+/* --------------------------------------------------------
+   2. Write raw data blocks (in the same order)
+   -------------------------------------------------------- */
+
+  for (nv = 0; nv < output->nvar; nv++){
+    if (output->stag_var[nv] != -1) continue;
+    if (output->dump_var[nv] == YES){
+      n = 0;
+      DOM_LOOP(k,j,i) buf[n++] = (float)(output->V[nv][k][j][i]*units[nv]);
+      ncomp = 1;
+    }else if (output->dump_var[nv] == VTK_VECTOR){
+      VTS_Vector (buf, output->V + nv, units[nv], grid);
+      ncomp = 3;
+    }else continue;
+    nbytes = ncomp*ncell*sizeof(float);
+    fwrite (&nbytes, sizeof(uint64_t), 1, fp);
+    fwrite (buf, sizeof(float), ncomp*ncell, fp);
+  }
+
+  VTS_Points (buf, grid);
+  nbytes = 3*npoint*sizeof(float);
+  fwrite (&nbytes, sizeof(uint64_t), 1, fp);
+  fwrite (buf, sizeof(float), 3*npoint, fp);
+
+  fprintf (fp, "\n  </AppendedData>\n");
+  fprintf (fp, "</VTKFile>\n");
+  fclose (fp);
+
+/* --------------------------------------------------------
+   3. Collect extents and write the .pvts index file
+   -------------------------------------------------------- */
+
+  #ifdef PARALLEL
+  MPI_Comm_size (MPI_COMM_WORLD, &nproc);
+  #endif
+  ext_all = (prank == 0 ? ARRAY_1D(6*nproc, int):NULL);
+  #ifdef PARALLEL
+  MPI_Gather (ext, 6, MPI_INT, ext_all, 6, MPI_INT, 0, MPI_COMM_WORLD);
+  #else
+  for (n = 0; n < 6; n++) ext_all[n] = ext[n];
+  #endif
+
+  if (prank != 0) return;
+
+  sprintf (fname, "%s/data.%04d.p%s", output->dir, output->nfile, output->ext);
+  fp = fopen (fname, "w");
+  fprintf (fp, "<?xml version=\"1.0\"?>\n");
+  fprintf (fp, "<VTKFile type=\"PStructuredGrid\" version=\"1.0\" "
+               "byte_order=\"%s\" header_type=\"UInt64\">\n", btype);
+  fprintf (fp, "  <PStructuredGrid WholeExtent=\"0 %d 0 %d 0 %d\" "
+               "GhostLevel=\"0\">\n",
+               grid->np_int_glob[IDIR] - 1 + INCLUDE_IDIR,
+               grid->np_int_glob[JDIR] - 1 + INCLUDE_JDIR,
+               grid->np_int_glob[KDIR] - 1 + INCLUDE_KDIR);
+  fprintf (fp, "    <PCellData>\n");
+  for (nv = 0; nv < output->nvar; nv++){
+    if (output->stag_var[nv] != -1) continue;
+    if      (output->dump_var[nv] == YES)        ncomp = 1;
+    else if (output->dump_var[nv] == VTK_VECTOR) ncomp = 3;
+    else continue;
+    fprintf (fp, "      <PDataArray type=\"Float32\" Name=\"%s\" "
+                 "NumberOfComponents=\"%d\"/>\n", vname[nv], ncomp);
+  }
+  fprintf (fp, "    </PCellData>\n");
+  fprintf (fp, "    <PPoints>\n");
+  fprintf (fp, "      <PDataArray type=\"Float32\" NumberOfComponents=\"3\"/>\n");
+  fprintf (fp, "    </PPoints>\n");
+  for (p = 0; p < nproc; p++){
+    n = 6*p;
+    fprintf (fp, "    <Piece Extent=\"%d %d %d %d %d %d\" "
+                 "Source=\"data.%04d.%04d.%s\"/>\n",
+                 ext_all[n], ext_all[n+1], ext_all[n+2], ext_all[n+3],
+                 ext_all[n+4], ext_all[n+5], output->nfile, p, output->ext);
+  }
+  fprintf (fp, "  </PStructuredGrid>\n");
+  fprintf (fp, "</VTKFile>\n");
+  fclose (fp);
+
+  FreeArray1D ((void *) ext_all);
+}
+
+/* ********************************************************************* */
+void VTS_Points (float *xyz, Grid *grid)
+/*!
+ * Compute the Cartesian coordinates of the nodes of the local block
+ * (same mapping used by WriteVTK_Header()).
+ *********************************************************************** */
+{
+  int    i, j, k, n = 0;
+  double x1, x2, x3;
+  double dphi = OutputFrameAngle(g_time);
+
+  x1 = x2 = x3 = 0.0;
+  for (k = KBEG; k <= KEND + INCLUDE_KDIR; k++){
+  for (j = JBEG; j <= JEND + INCLUDE_JDIR; j++){
+  for (i = IBEG; i <= IEND + INCLUDE_IDIR; i++){
+    DIM_EXPAND(x1 = (i <= IEND ? grid->xl[IDIR][i]:grid->xr[IDIR][IEND]);  ,
+               x2 = (j <= JEND ? grid->xl[JDIR][j]:grid->xr[JDIR][JEND]);  ,
+               x3 = (k <= KEND ? grid->xl[KDIR][k]:grid->xr[KDIR][KEND]);)
+
+    #if (GEOMETRY == CARTESIAN) || (GEOMETRY == CYLINDRICAL)
+    xyz[n]   = x1;
+    xyz[n+1] = x2;
+    xyz[n+2] = x3;
+    #elif GEOMETRY == POLAR
+    xyz[n]   = x1*cos(x2);
+    xyz[n+1] = x1*sin(x2);
+    xyz[n+2] = x3;
+    #elif GEOMETRY == SPHERICAL
+    #if DIMENSIONS == 2
+    xyz[n]   = x1*sin(x2);
+    xyz[n+1] = x1*cos(x2);
+    xyz[n+2] = 0.0;
+    #elif DIMENSIONS == 3
+    x3 += dphi;   /* Longitude in the output frame */
+    xyz[n]   = x1*sin(x2)*cos(x3);
+    xyz[n+1] = x1*sin(x2)*sin(x3);
+    xyz[n+2] = x1*cos(x2);
+    #endif
+    #endif
+    n += 3;
+  }}}
+}
+
+/* ********************************************************************* */
+void VTS_Vector (float *v3, double ****V, double unit, Grid *grid)
+/*!
+ * Pack the Cartesian components of a cell-centered vector field
+ * (see WriteVTK_Vector()).
+ *********************************************************************** */
+{
+  int    i, j, k, n = 0;
+  double v[3], x1, x2, x3;
+  double dphi = OutputFrameAngle(g_time);
+
+  v[0] = v[1] = v[2] = 0.0;
+  x1 = x2 = x3 = 0.0;
+  DOM_LOOP(k,j,i){
+    DIM_EXPAND(v[0] = V[0][k][j][i]; x1 = grid->x[IDIR][i]; ,
+               v[1] = V[1][k][j][i]; x2 = grid->x[JDIR][j]; ,
+               v[2] = V[2][k][j][i]; x3 = grid->x[KDIR][k];)
+    #if GEOMETRY == SPHERICAL && DIMENSIONS == 3
+    x3 += dphi;
+    #endif
+
+    VectorCartesianComponents(v, x1, x2, x3);
+    v3[n++] = (float)(v[0]*unit);
+    v3[n++] = (float)(v[1]*unit);
+    v3[n++] = (float)(v[2]*unit);
+  }
+}
@@ -0,0 +1,34 @@
+#define  PHYSICS                        MHD
+#define  DIMENSIONS                     3
+#define  GEOMETRY                       SPHERICAL
+#define  BODY_FORCE                     NO
+#define  COOLING                        NO
+#define  RECONSTRUCTION                 LINEAR
+#define  TIME_STEPPING                  EULER
+#define  NTRACER                        0
+#define  PARTICLES                      NO
+#define  USER_DEF_PARAMETERS            2
+
+/* -- physics dependent declarations -- */
+
+#define  EOS                            IDEAL
+#define  ENTROPY_SWITCH                 NO
+#define  DIVB_CONTROL                   NO
+#define  BACKGROUND_FIELD               NO
+#define  AMBIPOLAR_DIFFUSION            NO
+#define  RESISTIVITY                    NO
+#define  HALL_MHD                       NO
+#define  THERMAL_CONDUCTION             NO
+#define  VISCOSITY                      NO
+#define  ROTATING_FRAME                 NO
+
+/* -- user-defined parameters (labels) -- */
+
+#define  RHO_BLOB                       0
+#define  VPHI_BLOB                      1
+
+/* [Beg] user-defined constants (do not change this line) */
+
+#define  MULTIRATE_LEVELS               3
+
+/* [End] user-defined constants (do not change this line) */
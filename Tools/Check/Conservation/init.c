@@ -0,0 +1,156 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Closed spherical box for the conservation check.
+
+  A uniform gas at rest (sound speed 1, no magnetic field) fills a
+  spherical shell with reflective radial and meridional walls and a
+  periodic azimuthal direction.
+  A compact, spinning blob of overpressure, centred across the radius
+  where the levels of the multirate scheme change, sends waves across
+  the level interfaces.
+  As long as the waves do not reach the walls every flux through them
+  is exactly zero, so that the total mass, energy and angular momentum
+  must be conserved to round-off.
+
+  Analysis() appends, at every step, the time, the three totals and the
+  largest deviation from the initial state in the zones next to the
+  walls to \c totals.dat in the output directory.
+  Tools/Check/check_conservation.sh builds and runs the case and checks
+  these totals.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include "pluto.h"
+
+#define BLOB_R      1.55  /* Radius of the centre of the blob */
+#define BLOB_SIZE   0.3   /* Radius of the blob */
+
+/* ********************************************************************* */
+void Init (double *v, double x1, double x2, double x3)
+/*!
+ * Uniform gas at rest plus a blob of density, pressure and azimuthal
+ * velocity with a cos^2 profile, zero outside a sphere of radius
+ * \c BLOB_SIZE centred at (BLOB_R, pi/2, pi).
+ *
+ *********************************************************************** */
+{
+  double x, y, z, xb, d, f;
+
+  x  = x1*sin(x2)*cos(x3);
+  y  = x1*sin(x2)*sin(x3);
+  z  = x1*cos(x2);
+  xb = -BLOB_R;
+  d  = sqrt((x - xb)*(x - xb) + y*y + z*z);
+  f  = d < BLOB_SIZE ? cos(0.5*CONST_PI*d/BLOB_SIZE) : 0.0;
+  f *= f;
+
+  v[RHO] = 1.0 + g_inputParam[RHO_BLOB]*f;
+  v[VX1] = 0.0;
+  v[VX2] = 0.0;
+  v[VX3] = g_inputParam[VPHI_BLOB]*f;
+  v[PRS] = v[RHO]/g_gamma;
+  v[BX1] = v[BX2] = v[BX3] = 0.0;
+}
+
+/* ********************************************************************* */
+void InitDomain (Data *d, Grid *grid)
+/*!
+ * Assign initial condition by looping over the computational domain.
+ * Called after the usual Init() function to assign initial conditions
+ * on primitive variables.
+ * Value assigned here will overwrite those prescribed during Init().
+ *
+ *
+ *********************************************************************** */
+{
+}
+
+/* ********************************************************************* */
+void Analysis (const Data *d, Grid *grid)
+/*!
+ *  Append the totals of mass, energy and angular momentum
+ *  \f$ \sum \Delta V\, r\sin\theta\, m_\phi \f$ (with \c r and
+ *  \f$ \sin\theta \f$ those the update divides by) to totals.dat, with
+ *  the largest deviation from the initial state in the zones next to
+ *  the radial and meridional walls.
+ *
+ * \param [in] d the PLUTO Data structure
+ * \param [in] grid   pointer to array of Grid structures
+ *
+ *********************************************************************** */
+{
+  int    i, j, k, wall;
+  double dV, tot[3], dw, v0[NVAR];
+  double *x1 = grid->x[IDIR], *s = grid->s;
+  char   fname[512];
+  static int first_call = 1;
+  FILE  *fp;
+
+  Init (v0, 1.0, CONST_PI, 0.0);  /* -- the gas outside the blob -- */
+
+  tot[0] = tot[1] = tot[2] = 0.0;
+  dw = 0.0;
+  DOM_LOOP(k,j,i){
+    dV = grid->dV[k][j][i];
+    tot[0] += dV*d->Uc[k][j][i][RHO];
+    tot[1] += dV*d->Uc[k][j][i][ENG];
+    tot[2] += dV*x1[i]*s[j]*d->Uc[k][j][i][iMPHI];
+
+    wall =    (i == IBEG && grid->lbound[IDIR] != 0)
+           || (i == IEND && grid->rbound[IDIR] != 0)
+           || (j == JBEG && grid->lbound[JDIR] != 0)
+           || (j == JEND && grid->rbound[JDIR] != 0);
+    if (wall) {
+      dw = MAX(dw, fabs(d->Vc[RHO][k][j][i] - v0[RHO]));
+      dw = MAX(dw, fabs(d->Vc[PRS][k][j][i] - v0[PRS]));
+      dw = MAX(dw, fabs(d->Vc[VX1][k][j][i]));
+      dw = MAX(dw, fabs(d->Vc[VX2][k][j][i]));
+      dw = MAX(dw, fabs(d->Vc[VX3][k][j][i]));
+    }
+  }
+
+#ifdef PARALLEL
+  MPI_Allreduce (MPI_IN_PLACE, tot, 3, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+  MPI_Allreduce (MPI_IN_PLACE, &dw, 1, MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD);
+#endif
+
+  if (prank == 0){
+    sprintf (fname, "%s/totals.dat", RuntimeGet()->output_dir);
+    fp = fopen (fname, first_call ? "w" : "a");
+    if (first_call) {
+      fprintf (fp, "# %22s %24s %24s %24s %12s\n",
+               "t", "mass", "energy", "Lz", "wall");
+    }
+    fprintf (fp, "%24.16e %24.16e %24.16e %24.16e %12.4e\n",
+             g_time, tot[0], tot[1], tot[2], dw);
+    fclose (fp);
+  }
+  first_call = 0;
+}
+
+#if PHYSICS == MHD
+/* ********************************************************************* */
+void BackgroundField (double x1, double x2, double x3, double *B0)
+/*!
+ * Define the component of a static, curl-free background
+ * magnetic field.
+ *
+ *********************************************************************** */
+{
+  B0[0] = 0.0;
+  B0[1] = 0.0;
+  B0[2] = 0.0;
+}
+#endif
+
+/* ********************************************************************* */
+void UserDefBoundary (const Data *d, RBox *box, int side, Grid *grid)
+/*!
+ *  No user-defined boundary: all walls are reflective.
+ *
+ *********************************************************************** */
+{
+}
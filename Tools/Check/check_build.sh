@@ -0,0 +1,89 @@
+#!/bin/sh
+#
+# Build the code twice with different compile-time settings, run the
+# same short case with both builds and compare the last .dbl snapshot
+# with dbl-compare (Tools/Dbl/dbl_compare.c).
+#
+#   Tools/Check/check_build.sh [options] "SETTINGS_A" "SETTINGS_B"
+#
+# SETTINGS are space-separated NAME=VALUE pairs. Each one replaces the
+# #define of NAME in definitions.h, or is appended to it when absent
+# (for the #ifndef defaults of pluto.h and plm_coeffs.h). Examples:
+#
+#   Tools/Check/check_build.sh "PLM_VECTORIZE=YES" "PLM_VECTORIZE=NO"
+#   Tools/Check/check_build.sh -tol 0.01 "TIME_STEPPING=RK2" "TIME_STEPPING=RK3"
+#
+# Options:
+#   -np n       number of processes (default: 4)
+#   -ini file   case to run (default: Tools/Check/check.ini, a coarse
+#               grid up to t = 3)
+#   -tol x      largest relative L1 difference accepted (default: 0,
+#               the snapshots must be identical)
+#   -dir d      where builds and runs are placed (default: ./check)
+#   -make "..." extra arguments for make, e.g. "-j8 ARCH=Linux.gcc.defs"
+#
+# Run it from the top directory of the repository, with the boundary
+# data of the case in ./bnds (linked into both runs). The exit status
+# is that of dbl-compare: 0 if the runs agree, 2 if they do not, 1 on
+# error.
+
+np=4
+ini=Tools/Check/check.ini
+tol=0
+dir=./check
+make_args=
+
+while [ $# -gt 2 ]; do
+  case $1 in
+    -np)   np=$2 ;;
+    -ini)  ini=$2 ;;
+    -tol)  tol=$2 ;;
+    -dir)  dir=$2 ;;
+    -make) make_args=$2 ;;
+    *)     echo "! check_build.sh: unknown option $1"; exit 1 ;;
+  esac
+  shift 2
+done
+if [ $# -ne 2 ]; then
+  sed -n '3,27p' $0 | sed 's/^# \{0,1\}//'
+  exit 1
+fi
+
+top=$(pwd)
+case $ini in /*) ;; *) ini=$top/$ini ;; esac
+
+for c in a b; do
+  if [ $c = a ]; then set_list=$1; else set_list=$2; fi
+  d=$dir/$c
+  rm -rf $d && mkdir -p $d || exit 1
+  git ls-files | tar cf - -T - | (cd $d && tar xf -)
+
+  for s in $set_list; do
+    name=${s%%=*}
+    value=${s#*=}
+    if grep -q "^#define *$name " $d/definitions.h; then
+      sed -i "s/^#define *$name .*/#define  $name  $value/" $d/definitions.h
+    else
+      echo "#define  $name  $value" >> $d/definitions.h
+    fi
+  done
+
+  echo "> build $c: $set_list"
+  if ! eval make -C $d $make_args pluto > $d/build.log 2>&1; then
+    echo "! build $c failed, see $d/build.log"
+    exit 1
+  fi
+
+  rm -rf $d/bnds $d/out
+  ln -s $top/bnds $d/bnds
+  mkdir $d/out
+  cp $ini $d/check.ini
+  echo "> run $c on $np processes"
+  if ! (cd $d && mpirun -np $np ./pluto -i check.ini > run.log 2>&1); then
+    echo "! run $c failed, see $d/run.log"
+    exit 1
+  fi
+done
+
+eval make -C $dir/a $make_args dbl-compare > /dev/null 2>&1 || exit 1
+$dir/a/dbl-compare -tol $tol $dir/a/out $dir/b/out
@@ -0,0 +1,101 @@
+#!/bin/sh
+#
+# Build the closed-box case of Tools/Check/Conservation (a spinning
+# blob in a gas at rest, reflective radial and meridional walls,
+# periodic in x3), run it and check that the total mass, energy and
+# angular momentum written by its Analysis() at every step stay equal
+# to the initial ones to round-off.
+#
+#   Tools/Check/check_conservation.sh [options] ["SETTINGS"]
+#
+# The case is built with MULTIRATE_LEVELS = 3, so that the waves of the
+# blob cross the interfaces between levels. SETTINGS are NAME=VALUE
+# pairs replacing the #defines of the case, as in check_build.sh, e.g.
+#
+#   Tools/Check/check_conservation.sh "MULTIRATE_LEVELS=1"
+#
+# Options:
+#   -np n       number of processes (default: 4)
+#   -tol x      largest relative change of a total accepted
+#               (default: 1e-13)
+#   -dir d      where the build and the run are placed
+#               (default: ./check/conservation)
+#   -make "..." extra arguments for make, e.g. "-j8 ARCH=Linux.gcc.defs"
+#
+# Run it from the top directory of the repository. The exit status is
+# 0 if the totals are conserved, 2 if they are not, 1 on error or if
+# the waves reached the walls (the case is then no longer closed).
+
+np=4
+tol=1e-13
+dir=./check/conservation
+make_args=
+case_dir=Tools/Check/Conservation
+
+while [ $# -gt 1 ]; do
+  case $1 in
+    -np)   np=$2 ;;
+    -tol)  tol=$2 ;;
+    -dir)  dir=$2 ;;
+    -make) make_args=$2 ;;
+    *)     echo "! check_conservation.sh: unknown option $1"; exit 1 ;;
+  esac
+  shift 2
+done
+case $1 in
+  -*) sed -n '3,27p' $0 | sed 's/^# \{0,1\}//'; exit 1 ;;
+esac
+
+rm -rf $dir && mkdir -p $dir || exit 1
+git ls-files | tar cf - -T - | (cd $dir && tar xf -)
+cp $case_dir/definitions.h $case_dir/init.c $dir/
+
+for s in $1; do
+  name=${s%%=*}
+  value=${s#*=}
+  if grep -q "^#define *$name " $dir/definitions.h; then
+    sed -i "s/^#define *$name .*/#define  $name  $value/" $dir/definitions.h
+  else
+    echo "#define  $name  $value" >> $dir/definitions.h
+  fi
+done
+
+echo "> build: $1"
+if ! eval make -C $dir $make_args pluto > $dir/build.log 2>&1; then
+  echo "! build failed, see $dir/build.log"
+  exit 1
+fi
+
+rm -rf $dir/out
+mkdir $dir/out
+cp $case_dir/conservation.ini $dir/
+echo "> run on $np processes"
+if ! (cd $dir && mpirun -np $np ./pluto -i conservation.ini > run.log 2>&1); then
+  echo "! run failed, see $dir/run.log"
+  exit 1
+fi
+
+awk -v tol=$tol '
+  /^#/ { next }
+  n == 0 { for (q = 2; q <= 4; q++) t0[q] = $q }
+  {
+    n++
+    for (q = 2; q <= 4; q++) {
+      e = ($q - t0[q])/t0[q]; if (e < 0) e = -e
+      if (e > err[q]) err[q] = e
+    }
+    if ($5 > wall) wall = $5
+  }
+  END {
+    if (n < 2) { print "! no totals in totals.dat"; exit 1 }
+    printf "  %d steps up to t = %g, largest relative change:\n", n - 1, $1
+    printf "  mass %.2e  energy %.2e  angular momentum %.2e\n",
+           err[2], err[3], err[4]
+    if (wall > 1.e-10) {
+      printf "! waves reached the walls (deviation %.2e)\n", wall; exit 1
+    }
+    if (err[2] > tol || err[3] > tol || err[4] > tol) {
+      print "! totals not conserved"; exit 2
+    }
+    print "  totals conserved"
+  }' $dir/out/totals.dat
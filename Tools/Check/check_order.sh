@@ -0,0 +1,120 @@
+#!/bin/sh
+#
+# Check the order of accuracy in time of a time-stepping scheme. The
+# smooth closed-box case of Tools/Check/Conservation (single rate,
+# coarse grid, Tools/Check/Conservation/order.ini) is run with a fixed
+# time step dt and dt/2, and compared with an RK3 run with dt/8. For
+# a second-order scheme the relative L1 difference must drop by 4
+# when dt is halved.
+#
+#   Tools/Check/check_order.sh [options] "SETTINGS"
+#
+# SETTINGS are NAME=VALUE pairs replacing the #defines of the case, as
+# in check_build.sh, e.g.
+#
+#   Tools/Check/check_order.sh "TIME_STEPPING=RK2"
+#
+# Options:
+#   -np n       number of processes (default: 4)
+#   -dt x       largest time step (default: 0.004, CFL 0.3 on this grid)
+#   -order p    expected order (default: 2)
+#   -tol x      largest accepted distance of the ratio of the
+#               differences from 2^p (default: 0.2)
+#   -dir d      where builds and runs are placed (default: ./check/order)
+#   -make "..." extra arguments for make, e.g. "-j8 ARCH=Linux.gcc.defs"
+#
+# Run it from the top directory of the repository. The exit status is
+# 0 if the ratio is within the tolerance for every variable, 2 if it is
+# not and 1 on error.
+
+np=4
+dt=0.004
+order=2
+tol=0.2
+dir=./check/order
+make_args=
+case_dir=Tools/Check/Conservation
+
+while [ $# -gt 1 ]; do
+  case $1 in
+    -np)    np=$2 ;;
+    -dt)    dt=$2 ;;
+    -order) order=$2 ;;
+    -tol)   tol=$2 ;;
+    -dir)   dir=$2 ;;
+    -make)  make_args=$2 ;;
+    *)      echo "! check_order.sh: unknown option $1"; exit 1 ;;
+  esac
+  shift 2
+done
+if [ $# -ne 1 ]; then
+  sed -n '3,28p' $0 | sed 's/^# \{0,1\}//'
+  exit 1
+fi
+
+vars=rho,vx1,vx2,vx3,prs
+
+for c in ref test; do
+  if [ $c = ref ]; then set_list="TIME_STEPPING=RK3"; else set_list=$1; fi
+  d=$dir/$c
+  rm -rf $d && mkdir -p $d || exit 1
+  git ls-files | tar cf - -T - | (cd $d && tar xf -)
+  cp $case_dir/definitions.h $case_dir/init.c $d/
+
+  for s in MULTIRATE_LEVELS=1 $set_list; do
+    name=${s%%=*}
+    value=${s#*=}
+    if grep -q "^#define *$name " $d/definitions.h; then
+      sed -i "s/^#define *$name .*/#define  $name  $value/" $d/definitions.h
+    else
+      echo "#define  $name  $value" >> $d/definitions.h
+    fi
+  done
+
+  echo "> build $c: $set_list"
+  if ! eval make -C $d $make_args pluto > $d/build.log 2>&1; then
+    echo "! build $c failed, see $d/build.log"
+    exit 1
+  fi
+done
+
+run ()  # run <build> <name> <dt>
+{
+  r=$dir/$2
+  rm -rf $r && mkdir -p $r/out || exit 1
+  cp $dir/$1/pluto $r/
+  sed "s/^first_dt .*/first_dt   $3/" $case_dir/order.ini > $r/order.ini
+  echo "> run $2 (dt = $3) on $np processes"
+  if ! (cd $r && mpirun -np $np ./pluto -i order.ini > run.log 2>&1); then
+    echo "! run $2 failed, see $r/run.log"
+    exit 1
+  fi
+}
+
+run ref  run_ref $(awk -v x=$dt 'BEGIN{print x/8}') || exit 1
+run test run_1   $dt                                || exit 1
+run test run_2   $(awk -v x=$dt 'BEGIN{print x/2}') || exit 1
+
+eval make -C $dir/ref $make_args dbl-compare > /dev/null 2>&1 || exit 1
+for r in 1 2; do
+  $dir/ref/dbl-compare -tol 1 -vars $vars $dir/run_ref/out $dir/run_$r/out \
+    > $dir/diff_$r.txt || exit 1
+done
+
+awk -v order=$order -v tol=$tol '
+  /^#/ { next }
+  FNR == NR { e1[$1] = $2; next }
+  {
+    ratio = ($2 > 0.0 ? e1[$1]/$2 : 0.0)
+    ok    = (ratio - 2^order <= tol && 2^order - ratio <= tol)
+    printf "  %-6s  %12.4e  %12.4e  ratio %6.3f%s\n", $1, e1[$1], $2,
+           ratio, ok ? "" : "  *"
+    if (!ok) nfail++
+  }
+  END {
+    if (nfail > 0){
+      printf "! the ratio differs from %g by more than %g\n", 2^order, tol
+      exit 2
+    }
+    printf "  order %g in time\n", order
+  }' $dir/diff_1.txt $dir/diff_2.txt
@@ -0,0 +1,149 @@
+#!/bin/sh
+#
+# Build the code in double precision and with MIXED_PRECISION = YES
+# (solution arrays stored in single precision), run the same short case
+# with both builds and compare the time series of a probe at Earth
+# (1 AU, HEEQ latitude and longitude 0): density, speed, temperature,
+# magnetic field strength and the field components.
+#
+#   Tools/Check/check_precision.sh [options] ["SETTINGS"]
+#
+# SETTINGS are NAME=VALUE pairs used by both builds, as in
+# check_build.sh, e.g.
+#
+#   Tools/Check/check_precision.sh "TIME_STEPPING=RK2"
+#
+# The probe samples every step; since the time steps of the two runs
+# differ, the mixed-precision series is interpolated linearly in time.
+# The difference of each quantity is taken relative to its largest
+# value over the time series, that of a vector component relative to
+# the largest magnitude of the vector.
+#
+# Options:
+#   -np n       number of processes (default: 4)
+#   -ini file   case to run (default: Tools/Check/check.ini); the probe
+#               is added to it
+#   -tol x      largest relative difference accepted (default: 1e-4)
+#   -dir d      where builds and runs are placed
+#               (default: ./check/precision)
+#   -make "..." extra arguments for make, e.g. "-j8 ARCH=Linux.gcc.defs"
+#
+# Run it from the top directory of the repository, with the boundary
+# data of the case in ./bnds (linked into both runs). The exit status
+# is 0 if the probes agree, 2 if they do not and 1 on error.
+
+np=4
+ini=Tools/Check/check.ini
+tol=1e-4
+dir=./check/precision
+make_args=
+
+while [ $# -gt 1 ]; do
+  case $1 in
+    -np)   np=$2 ;;
+    -ini)  ini=$2 ;;
+    -tol)  tol=$2 ;;
+    -dir)  dir=$2 ;;
+    -make) make_args=$2 ;;
+    *)     echo "! check_precision.sh: unknown option $1"; exit 1 ;;
+  esac
+  shift 2
+done
+case $1 in
+  -*) sed -n '3,33p' $0 | sed 's/^# \{0,1\}//'; exit 1 ;;
+esac
+
+top=$(pwd)
+case $ini in /*) ;; *) ini=$top/$ini ;; esac
+
+for c in double mixed; do
+  if [ $c = double ]; then set_list=$1; else set_list="$1 MIXED_PRECISION=YES"; fi
+  d=$dir/$c
+  rm -rf $d && mkdir -p $d || exit 1
+  git ls-files | tar cf - -T - | (cd $d && tar xf -)
+
+  for s in $set_list; do
+    name=${s%%=*}
+    value=${s#*=}
+    if grep -q "^#define *$name " $d/definitions.h; then
+      sed -i "s/^#define *$name .*/#define  $name  $value/" $d/definitions.h
+    else
+      echo "#define  $name  $value" >> $d/definitions.h
+    fi
+  done
+
+  echo "> build $c: $set_list"
+  if ! eval make -C $d $make_args pluto > $d/build.log 2>&1; then
+    echo "! build $c failed, see $d/build.log"
+    exit 1
+  fi
+
+  rm -rf $d/bnds $d/out
+  ln -s $top/bnds $d/bnds
+  mkdir $d/out
+  sed '/^\[Probes\]/,/^\[/{/^\[Probes\]/d;/^probe/d}' $ini > $d/check.ini
+  printf '\n[Probes]\n\nprobes  -1.0  1\nprobe1  earth  fixed  1.0  0.0  0.0\n' \
+    >> $d/check.ini
+  echo "> run $c on $np processes"
+  if ! (cd $d && mpirun -np $np ./pluto -i check.ini > run.log 2>&1); then
+    echo "! run $c failed, see $d/run.log"
+    exit 1
+  fi
+done
+
+awk -v tol=$tol '
+  function mag(a, b, c){ return sqrt(a*a + b*b + c*c) }
+  function cmp(q, x, y, scale){
+    d = x - y; if (d < 0) d = -d
+    if (d > dq[q]) dq[q] = d
+    if (scale > sq[q]) sq[q] = scale
+  }
+  /^#/ {
+    if ($2 == "t") for (c = 2; c <= NF; c++) col[$c] = c - 1
+    next
+  }
+  FNR == NR {        # -- mixed precision run: store the series --
+    nm++
+    for (c = 1; c <= NF; c++) m[nm, c] = $c
+    next
+  }
+  {                  # -- double precision run --
+    if ($1 < m[1, 1] || $1 > m[nm, 1]) next
+    while (im < nm - 1 && m[im + 1, 1] < $1) im++
+    if (im == 0) im = 1
+    w = (m[im + 1, 1] > m[im, 1] ? ($1 - m[im, 1])/(m[im + 1, 1] - m[im, 1]) : 0.0)
+    for (c = 1; c <= NF; c++) {
+      a[c] = $c
+      b[c] = (1.0 - w)*m[im, c] + w*m[im + 1, c]
+    }
+    v1 = col["vx1"]; v2 = col["vx2"]; v3 = col["vx3"]
+    va = mag(a[v1], a[v2], a[v3]); vb = mag(b[v1], b[v2], b[v3])
+    cmp("rho", a[col["rho"]], b[col["rho"]], a[col["rho"]])
+    cmp("|v|", va, vb, va)
+    cmp("vx1", a[v1], b[v1], va)
+    cmp("vx2", a[v2], b[v2], va)
+    cmp("vx3", a[v3], b[v3], va)
+    if ("T" in col) cmp("T", a[col["T"]], b[col["T"]], a[col["T"]])
+    if ("Bx1" in col) {
+      b1 = col["Bx1"]; b2 = col["Bx2"]; b3 = col["Bx3"]
+      Ba = mag(a[b1], a[b2], a[b3]); Bb = mag(b[b1], b[b2], b[b3])
+      cmp("|B|", Ba, Bb, Ba)
+      cmp("Bx1", a[b1], b[b1], Ba)
+      cmp("Bx2", a[b2], b[b2], Ba)
+      cmp("Bx3", a[b3], b[b3], Ba)
+    }
+    ns++; tlast = $1
+  }
+  END {
+    if (ns < 2) { print "! no common samples in probe.earth.dat"; exit 1 }
+    printf "  %d samples up to t = %g, largest relative difference:\n", ns, tlast
+    nq = split("rho |v| vx1 vx2 vx3 T |B| Bx1 Bx2 Bx3", q, " ")
+    for (i = 1; i <= nq; i++) {
+      if (!(q[i] in sq)) continue
+      e = (sq[q[i]] > 0.0 ? dq[q[i]]/sq[q[i]] : dq[q[i]])
+      printf "  %-4s  %10.3e%s\n", q[i], e, (e > tol ? "  *" : "")
+      if (e > tol) nfail++
+    }
+    if (nfail > 0) { printf "! probes differ by more than %g\n", tol; exit 2 }
+    print "  probes agree"
+  }' $dir/mixed/out/probe.earth.dat $dir/double/out/probe.earth.dat
@@ -0,0 +1,185 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Compare the same snapshot written by two runs.
+
+  \c dbl-compare maps <tt> data.nnnn.dbl </tt> (or \c .flt) from two
+  output directories (see dbl_map.c) and prints, for every variable,
+  the relative L1 difference
+  \f[
+    \frac{\sum |a - b|}{\sum |a|}
+  \f]
+  over all zones and the largest absolute difference.
+  \verbatim
+   ./dbl-compare run_a/out run_b/out
+   ./dbl-compare -n 3 -tol 1.e-3 -vars rho,prs run_a/out run_b/out
+  \endverbatim
+  Options:
+
+  - <tt> -n nfile </tt>: file number (default: the last file present
+    in both directories);
+  - <tt> -vars v1,v2,... </tt>: variables (default: all);
+  - <tt> -tol x </tt>: largest relative L1 difference accepted
+    (default: 0, i.e. the files must be identical);
+  - <tt> -flt </tt>: compare .flt instead of .dbl files.
+
+  The two runs must have the same grid. The exit status is 0 when all
+  differences are within the tolerance, 2 when they are not and 1 on
+  error, so that the tool can be used in scripts such as
+  Tools/Check/check_build.sh.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "dbl_map.h"
+
+static void Usage (void);
+static int  FindFile (const DblArchive *, int);
+
+/* ********************************************************************* */
+int main (int argc, char *argv[])
+/*!
+ * Parse the command line, compare and print the differences.
+ *********************************************************************** */
+{
+  int    n, na, nb, nv, nvb, dir, nfile = -1, nfail = 0;
+  char   *dir_name[2] = {NULL, NULL}, ext[4] = "dbl", vlist[1024] = "all";
+  char   *tok;
+  long   i, j, k, np[3];
+  double a, b, sd, sa, dmax, tol = 0.0;
+  DblArchive arc[2];
+  DblFile    fa, fb;
+
+  for (n = 1; n < argc; n++){
+    if      (!strcmp(argv[n], "-n") && n + 1 < argc)    nfile = atoi(argv[++n]);
+    else if (!strcmp(argv[n], "-tol") && n + 1 < argc)  tol   = atof(argv[++n]);
+    else if (!strcmp(argv[n], "-vars") && n + 1 < argc) snprintf (vlist, 1024, "%s", argv[++n]);
+    else if (!strcmp(argv[n], "-flt")) strcpy (ext, "flt");
+    else if (argv[n][0] != '-' && dir_name[0] == NULL) dir_name[0] = argv[n];
+    else if (argv[n][0] != '-' && dir_name[1] == NULL) dir_name[1] = argv[n];
+    else{
+      Usage();
+      return strcmp(argv[n], "-h") != 0;
+    }
+  }
+  if (dir_name[1] == NULL){
+    Usage();
+    return 1;
+  }
+
+  if (DblArchiveOpen (&arc[0], dir_name[0], ext) != 0) return 1;
+  if (DblArchiveOpen (&arc[1], dir_name[1], ext) != 0) return 1;
+
+  for (dir = 0; dir < 3; dir++){
+    if (arc[0].grid.np[dir] != arc[1].grid.np[dir]){
+      fprintf (stderr, "! The two runs have different grids\n");
+      return 1;
+    }
+  }
+
+/* -- File: the given one or the last one present in both -- */
+
+  if (nfile < 0){
+    for (na = arc[0].nsnap - 1; na >= 0; na--){
+      if (FindFile (&arc[1], arc[0].snap[na].nfile) >= 0) break;
+    }
+    if (na < 0){
+      fprintf (stderr, "! No file present in both directories\n");
+      return 1;
+    }
+    nfile = arc[0].snap[na].nfile;
+  }
+  na = FindFile (&arc[0], nfile);
+  nb = FindFile (&arc[1], nfile);
+  if (na < 0 || nb < 0){
+    fprintf (stderr, "! data.%04d.%s is missing in %s\n", nfile, ext,
+             dir_name[na < 0 ? 0:1]);
+    return 1;
+  }
+  if (DblFileMap (&arc[0], na, &fa) != 0) return 1;
+  if (DblFileMap (&arc[1], nb, &fb) != 0) return 1;
+
+  printf ("# data.%04d.%s: t = %12.6e (%s), %12.6e (%s)\n", nfile, ext,
+          fa.snap->t, dir_name[0], fb.snap->t, dir_name[1]);
+  if (fa.snap->t != fb.snap->t){
+    printf ("# (warning: the two files have different times)\n");
+  }
+  printf ("# %-10s  %14s  %14s\n", "var", "L1 rel. diff", "max abs. diff");
+
+/* -- Loop over variables -- */
+
+  for (nv = 0; nv < fa.snap->nvar; nv++){
+    const char *name = fa.snap->var_name[nv];
+
+    if (strcmp(vlist, "all")){
+      char list[1024];
+      snprintf (list, 1024, "%s", vlist);
+      for (tok = strtok(list, ","); tok != NULL; tok = strtok(NULL, ",")){
+        if (!strcmp(tok, name)) break;
+      }
+      if (tok == NULL) continue;
+    }
+    nvb = DblVarIndex (fb.snap, name);
+    if (nvb < 0){
+      printf ("  %-10s  %14s\n", name, "missing");
+      nfail++;
+      continue;
+    }
+
+    for (dir = 0; dir < 3; dir++) np[dir] = arc[0].grid.np[dir] + (fa.snap->stag[nv] == dir);
+    sd = sa = dmax = 0.0;
+    for (k = 0; k < np[2]; k++){
+    for (j = 0; j < np[1]; j++){
+    for (i = 0; i < np[0]; i++){
+      a = DblValue (&fa, nv, k, j, i);
+      b = DblValue (&fb, nvb, k, j, i);
+      sd  += fabs(a - b);
+      sa  += fabs(a);
+      dmax = fabs(a - b) > dmax ? fabs(a - b):dmax;
+    }}}
+    if (sa > 0.0) sd /= sa;
+    printf ("  %-10s  %14.6e  %14.6e%s\n", name, sd, dmax, sd > tol ? "  *":"");
+    if (sd > tol) nfail++;
+  }
+
+  DblFileUnmap (&fa);
+  DblFileUnmap (&fb);
+  DblArchiveClose (&arc[0]);
+  DblArchiveClose (&arc[1]);
+
+  if (nfail > 0){
+    printf ("# %d variable(s) differ by more than %g\n", nfail, tol);
+    return 2;
+  }
+  return 0;
+}
+
+/* ********************************************************************* */
+void Usage (void)
+/*!
+ * Print a short summary of the options.
+ *********************************************************************** */
+{
+  printf ("Usage: dbl-compare [options] dir_a dir_b\n\n");
+  printf (" -n nfile         file number (default: last one in both)\n");
+  printf (" -vars v1,v2,...  variables (default: all)\n");
+  printf (" -tol x           largest relative L1 difference (default: 0)\n");
+  printf (" -flt             compare .flt files\n");
+}
+
+/* ********************************************************************* */
+int FindFile (const DblArchive *arc, int nfile)
+/*!
+ * Return the position of file number nfile in arc->snap, or -1.
+ *********************************************************************** */
+{
+  int n;
+
+  for (n = 0; n < arc->nsnap; n++) if (arc->snap[n].nfile == nfile) return n;
+  return -1;
+}
@@ -0,0 +1,282 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Extract point and box time series from an archive of .dbl files.
+
+  \c dbl-extract reads only the zones it needs from each
+  <tt> data.nnnn.dbl </tt> file (memory-mapped, see dbl_map.c), so
+  that a time series over months of snapshots costs a few pages per
+  file rather than a full read pass.
+  Files are distributed among threads.
+  \verbatim
+   ./dbl-extract -d ./out -vars rho,vx1,prs -at 1.0 0.0 0.0 > earth.dat
+   ./dbl-extract -d ./out -vars all -track ephem/stereoa.txt -range 100 820
+   ./dbl-extract -d ./out -vars rho -box 0 511 30 30 0 179 -o ecl.bin
+  \endverbatim
+  Options:
+
+  - <tt> -d dir </tt>: directory with grid.out, dbl.out and the .dbl
+    files (default: current directory);
+  - <tt> -vars v1,v2,... | all </tt>: variables (default: all);
+  - <tt> -zone i j k </tt>: a single zone, given by its global 0-based
+    interior indices;
+  - <tt> -at x1 x2 x3 </tt>: the zone whose center is closest to the
+    given position;
+  - <tt> -track file </tt>: a moving point, from a table with columns
+    <tt> t x1 x2 x3 </tt> linearly interpolated at the time of each
+    file (as for probes, see probes.c);
+  - <tt> -box i0 i1 j0 j1 k0 k1 </tt>: a box of zones (inclusive
+    ranges); requires \c -o;
+  - <tt> -range n0 n1 </tt>: file numbers n0 to n1 only;
+  - <tt> -threads n </tt>: number of threads (default: number of cores);
+  - <tt> -o file </tt>: output file (default: standard output);
+  - <tt> -phi0 deg </tt>: as \c probe_phi0, see below.
+
+  In spherical geometry, positions given with \c -at and \c -track are
+  \f$(r,\,{\rm lat},\,{\rm lon})\f$ with angles in degrees, mapped to
+  \f$\theta = 90 - {\rm lat}\f$ and \f$\phi = {\rm lon} + \phi_0\f$;
+  otherwise they are grid coordinates.
+  Point and track series are written as an ascii table (file number,
+  time, zone center coordinates and one column per variable); boxes
+  are written as raw native doubles ordered as [file][var][k][j][i],
+  with a one-line description on standard output.
+  Values are taken at zone centers without interpolation.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include "dbl_map.h"
+
+static void Usage (void);
+static int  ReadTrack (const char *, double **, double *[3]);
+static void ToGrid (const DblGrid *, double *, double, int (*)[2]);
+
+/* ********************************************************************* */
+int main (int argc, char *argv[])
+/*!
+ * Parse the command line, gather and write the time series.
+ *********************************************************************** */
+{
+  int    n, m, nv, dir, n0, n1, nf, nvar = 0, ntab = 0, nthreads;
+  int    mode = 0, moving = 0, at = 0;   /* mode: 1 = point, 2 = track, 3 = box */
+  int    range[2] = {0, 1 << 30}, zbox[3][2], (*box)[3][2];
+  char   dir_name[256] = ".", *out_name = NULL, vlist[1024] = "all";
+  char   (*var)[DBL_NAME_LEN], *tok;
+  long   nbox;
+  double x[3], phi0 = 0.0, w, *tt = NULL, *xt[3], *out;
+  DblArchive arc;
+  FILE   *fp;
+
+  nthreads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+  for (n = 1; n < argc; n++){
+    if      (!strcmp(argv[n], "-d") && n + 1 < argc) snprintf (dir_name, 256, "%s", argv[++n]);
+    else if (!strcmp(argv[n], "-o") && n + 1 < argc) out_name = argv[++n];
+    else if (!strcmp(argv[n], "-vars") && n + 1 < argc) snprintf (vlist, 1024, "%s", argv[++n]);
+    else if (!strcmp(argv[n], "-threads") && n + 1 < argc) nthreads = atoi(argv[++n]);
+    else if (!strcmp(argv[n], "-phi0") && n + 1 < argc) phi0 = atof(argv[++n]);
+    else if (!strcmp(argv[n], "-range") && n + 2 < argc){
+      range[0] = atoi(argv[++n]);
+      range[1] = atoi(argv[++n]);
+    }else if (!strcmp(argv[n], "-zone") && n + 3 < argc){
+      mode = 1;
+      for (dir = 0; dir < 3; dir++) zbox[dir][0] = zbox[dir][1] = atoi(argv[++n]);
+    }else if (!strcmp(argv[n], "-at") && n + 3 < argc){
+      mode = at = 1;
+      for (dir = 0; dir < 3; dir++) x[dir] = atof(argv[++n]);
+    }else if (!strcmp(argv[n], "-track") && n + 1 < argc){
+      mode = 2;
+      ntab = ReadTrack (argv[++n], &tt, xt);
+      if (ntab <= 0) return 1;
+    }else if (!strcmp(argv[n], "-box") && n + 6 < argc){
+      mode = 3;
+      for (dir = 0; dir < 3; dir++){
+        zbox[dir][0] = atoi(argv[++n]);
+        zbox[dir][1] = atoi(argv[++n]);
+      }
+    }else{
+      Usage();
+      return strcmp(argv[n], "-h") != 0;
+    }
+  }
+  if (mode == 0 || (mode == 3 && out_name == NULL)){
+    Usage();
+    return 1;
+  }
+
+  if (DblArchiveOpen (&arc, dir_name, "dbl") != 0) return 1;
+
+/* -- Range of files (positions in arc.snap) -- */
+
+  for (n0 = 0; n0 < arc.nsnap && arc.snap[n0].nfile < range[0]; n0++);
+  for (n1 = arc.nsnap - 1; n1 >= 0 && arc.snap[n1].nfile > range[1]; n1--);
+  if (n0 > n1){
+    fprintf (stderr, "! No files in the given range\n");
+    return 1;
+  }
+  nf = n1 - n0 + 1;
+
+/* -- Variables -- */
+
+  var = (char (*)[DBL_NAME_LEN]) malloc (DBL_MAX_VARS*DBL_NAME_LEN);
+  if (!strcmp(vlist, "all")){
+    for (nv = 0; nv < arc.snap[n0].nvar; nv++){
+      if (arc.snap[n0].stag[nv] < 0) strcpy (var[nvar++], arc.snap[n0].var_name[nv]);
+    }
+  }else{
+    for (tok = strtok(vlist, ","); tok != NULL && nvar < DBL_MAX_VARS;
+         tok = strtok(NULL, ",")){
+      snprintf (var[nvar++], DBL_NAME_LEN, "%s", tok);
+    }
+  }
+
+/* -- Zones: one box, or one zone per file for a track -- */
+
+  if (at) ToGrid (&arc.grid, x, phi0, zbox);
+  moving = (mode == 2);
+  box = (int (*)[3][2]) malloc ((moving ? nf:1)*sizeof(*box));
+  if (moving){
+    for (n = n0; n <= n1; n++){
+      double t = arc.snap[n].t;
+      for (m = 0; m < ntab - 2 && tt[m + 1] < t; m++);
+      w = (ntab == 1 || t <= tt[0]) ? 0.0:(t - tt[m])/(tt[m + 1] - tt[m]);
+      if (w > 1.0) w = 1.0;
+      for (dir = 0; dir < 3; dir++){
+        x[dir] = xt[dir][m] + (ntab > 1 ? w*(xt[dir][m + 1] - xt[dir][m]):0.0);
+      }
+      ToGrid (&arc.grid, x, phi0, box[n - n0]);
+    }
+  }else{
+    memcpy (box[0], zbox, sizeof(zbox));
+  }
+  for (dir = 0; dir < 3; dir++){
+    if (box[0][dir][0] < 0 || box[0][dir][1] >= arc.grid.np[dir] ||
+        box[0][dir][0] > box[0][dir][1]){
+      fprintf (stderr, "! Zone indices out of the domain in direction %d\n", dir + 1);
+      return 1;
+    }
+  }
+  nbox = 1;
+  for (dir = 0; dir < 3; dir++) nbox *= box[0][dir][1] - box[0][dir][0] + 1;
+
+/* -- Gather and write -- */
+
+  out = (double *) malloc ((size_t)nf*nvar*nbox*sizeof(double));
+  if (DblGather (&arc, n0, n1, nvar, var, box, moving, nthreads, out) != 0) return 1;
+
+  fp = (out_name == NULL ? stdout:fopen (out_name, mode == 3 ? "wb":"w"));
+  if (fp == NULL){
+    fprintf (stderr, "! Cannot open %s\n", out_name);
+    return 1;
+  }
+  if (mode == 3){
+    fwrite (out, sizeof(double), (size_t)nf*nvar*nbox, fp);
+    printf ("# %s: %d file(s) [%d-%d], %d var(s), box %d %d %d %d %d %d\n",
+            out_name, nf, arc.snap[n0].nfile, arc.snap[n1].nfile, nvar,
+            box[0][0][0], box[0][0][1], box[0][1][0], box[0][1][1],
+            box[0][2][0], box[0][2][1]);
+  }else{
+    fprintf (fp, "# %4s  %14s  %14s  %14s  %14s", "file", "t", "x1", "x2", "x3");
+    for (m = 0; m < nvar; m++) fprintf (fp, "  %14s", var[m]);
+    fprintf (fp, "\n");
+    for (n = n0; n <= n1; n++){
+      int (*b)[2] = box[moving ? n - n0:0];
+      fprintf (fp, "  %4d  %14.7e  %14.7e  %14.7e  %14.7e", arc.snap[n].nfile,
+               arc.snap[n].t, arc.grid.x[0][b[0][0]], arc.grid.x[1][b[1][0]],
+               arc.grid.x[2][b[2][0]]);
+      for (m = 0; m < nvar; m++) fprintf (fp, "  %14.7e", out[(n - n0)*nvar + m]);
+      fprintf (fp, "\n");
+    }
+  }
+  if (fp != stdout) fclose (fp);
+
+  free (out);
+  free (box);
+  free (var);
+  DblArchiveClose (&arc);
+  return 0;
+}
+
+/* ********************************************************************* */
+void Usage (void)
+/*!
+ * Print a short summary of the options.
+ *********************************************************************** */
+{
+  printf ("Usage: dbl-extract [options] -zone i j k | -at x1 x2 x3 | -track file\n");
+  printf ("                             | -box i0 i1 j0 j1 k0 k1 -o file\n\n");
+  printf (" -d dir           input directory (grid.out, dbl.out, data.*.dbl)\n");
+  printf (" -vars v1,v2,...  variables (default: all)\n");
+  printf (" -range n0 n1     file numbers n0 to n1 only\n");
+  printf (" -threads n       number of threads (default: number of cores)\n");
+  printf (" -o file          output file (default: standard output)\n");
+  printf (" -phi0 deg        longitude of the HEEQ x-axis (spherical)\n");
+}
+
+/* ********************************************************************* */
+int ReadTrack (const char *fname, double **t, double *x[3])
+/*!
+ * Read a table with columns t x1 x2 x3 (lines starting with '#' are
+ * skipped). Return the number of rows, or -1 on error.
+ *********************************************************************** */
+{
+  int    n = 0, nmax = 0, dir;
+  char   line[512];
+  double v[4];
+  FILE   *fp;
+
+  fp = fopen (fname, "r");
+  if (fp == NULL){
+    fprintf (stderr, "! ReadTrack(): cannot open %s\n", fname);
+    return -1;
+  }
+  *t = NULL;
+  for (dir = 0; dir < 3; dir++) x[dir] = NULL;
+  while (fgets(line, sizeof(line), fp) != NULL){
+    if (line[0] == '#') continue;
+    if (sscanf(line, "%lf %lf %lf %lf", v, v + 1, v + 2, v + 3) != 4) continue;
+    if (n == nmax){
+      nmax = 2*nmax + 256;
+      *t = (double *) realloc (*t, nmax*sizeof(double));
+      for (dir = 0; dir < 3; dir++) x[dir] = (double *) realloc (x[dir], nmax*sizeof(double));
+    }
+    (*t)[n] = v[0];
+    for (dir = 0; dir < 3; dir++) x[dir][n] = v[dir + 1];
+    n++;
+  }
+  fclose (fp);
+  if (n == 0){
+    fprintf (stderr, "! ReadTrack(): no data in %s\n", fname);
+    return -1;
+  }
+  return n;
+}
+
+/* ********************************************************************* */
+void ToGrid (const DblGrid *g, double *x, double phi0, int (*box)[2])
+/*!
+ * Find the zone closest to the position x and store its indices as
+ * a one-zone box.
+ *********************************************************************** */
+{
+  int    dir;
+  double y[3];
+
+  y[0] = x[0];
+  y[1] = x[1];
+  y[2] = x[2];
+  if (!strcmp(g->geometry, "SPHERICAL")){
+    y[1] = (90.0 - x[1])*M_PI/180.0;
+    y[2] = fmod((x[2] + phi0)*M_PI/180.0, 2.0*M_PI);
+    if (y[2] < 0.0) y[2] += 2.0*M_PI;
+  }
+  for (dir = 0; dir < 3; dir++){
+    box[dir][0] = box[dir][1] = DblNearestIndex (g, dir, y[dir]);
+  }
+}
@@ -0,0 +1,447 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Memory-mapped access to PLUTO .dbl / .flt output archives.
+
+  See dbl_map.h for a description of the layout.
+  Functions return 0 on success and -1 (after printing a message to
+  \c stderr) on failure, so that callers can decide whether to abort.
+  DblGather() uses POSIX threads.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "dbl_map.h"
+
+#ifndef DBL_RANDOM_ACCESS     /* Boxes with fewer zones disable read-ahead */
+ #define DBL_RANDOM_ACCESS  4096
+#endif
+
+typedef struct DblTask_{
+  const DblArchive *arc;
+  int    n0, n1, nvar, moving, nthreads, id, err;
+  char   (*var)[DBL_NAME_LEN];
+  int    (*box)[3][2];
+  double *out;
+} DblTask;
+
+static int   DblReadGrid (DblArchive *);
+static int   DblReadOut  (DblArchive *);
+static void *DblGatherThread (void *);
+
+/* ********************************************************************* */
+int DblArchiveOpen (DblArchive *arc, const char *dir, const char *ext)
+/*!
+ * Parse grid.out and <ext>.out in the given directory.
+ *
+ * \param [out] arc  the archive descriptor
+ * \param [in]  dir  the PLUTO output directory
+ * \param [in]  ext  the file extension, "dbl" or "flt"
+ *********************************************************************** */
+{
+  memset (arc, 0, sizeof(DblArchive));
+  if (strcmp(ext, "dbl") && strcmp(ext, "flt")){
+    fprintf (stderr, "! DblArchiveOpen(): unsupported format '%s'\n", ext);
+    return -1;
+  }
+  snprintf (arc->dir, sizeof(arc->dir), "%s", dir);
+  strcpy (arc->ext, ext);
+  arc->elsize = (strcmp(ext, "dbl") == 0 ? 8:4);
+
+  if (DblReadGrid (arc) != 0) return -1;
+  return DblReadOut (arc);
+}
+
+/* ********************************************************************* */
+int DblArchiveUpdate (DblArchive *arc)
+/*!
+ * Parse the .out file again to pick up files written since the last
+ * call (e.g. while the run is in progress).
+ *********************************************************************** */
+{
+  return DblReadOut (arc);
+}
+
+/* ********************************************************************* */
+void DblArchiveClose (DblArchive *arc)
+/*!
+ * Free memory allocated by DblArchiveOpen().
+ *********************************************************************** */
+{
+  int dir;
+
+  for (dir = 0; dir < 3; dir++){
+    free (arc->grid.xl[dir]);
+    free (arc->grid.xr[dir]);
+    free (arc->grid.x[dir]);
+  }
+  free (arc->snap);
+  memset (arc, 0, sizeof(DblArchive));
+}
+
+/* ********************************************************************* */
+int DblReadGrid (DblArchive *arc)
+/*!
+ * Read dimensions, geometry and zone interfaces from grid.out.
+ *********************************************************************** */
+{
+  int    dir, i, n, np;
+  char   fname[512], line[512], *s;
+  DblGrid *g = &arc->grid;
+  FILE   *fp;
+
+  snprintf (fname, sizeof(fname), "%s/grid.out", arc->dir);
+  fp = fopen (fname, "r");
+  if (fp == NULL){
+    fprintf (stderr, "! DblReadGrid(): cannot open %s\n", fname);
+    return -1;
+  }
+
+/* -- Header: comment lines starting with '#' -- */
+
+  strcpy (g->geometry, "CARTESIAN");
+  g->dimensions = 3;
+  while (fgets(line, sizeof(line), fp) != NULL && line[0] == '#'){
+    if ((s = strstr(line, "DIMENSIONS:")) != NULL) {
+      g->dimensions = atoi(s + 11);
+    }
+    if ((s = strstr(line, "GEOMETRY:")) != NULL) {
+      sscanf (s + 9, "%15s", g->geometry);
+    }
+  }
+
+/* -- One block per direction: count, then "i xl xr" -- */
+
+  for (dir = 0; dir < 3; dir++){
+    if (dir > 0 && fgets(line, sizeof(line), fp) == NULL) break;
+    np = atoi(line);
+    if (np <= 0) break;
+    g->np[dir] = np;
+    g->xl[dir] = (double *) malloc (np*sizeof(double));
+    g->xr[dir] = (double *) malloc (np*sizeof(double));
+    g->x[dir]  = (double *) malloc (np*sizeof(double));
+    for (i = 0; i < np; i++){
+      if (fgets(line, sizeof(line), fp) == NULL ||
+          sscanf(line, "%d %lf %lf", &n, g->xl[dir] + i, g->xr[dir] + i) != 3){
+        fclose (fp);
+        fprintf (stderr, "! DblReadGrid(): %s is truncated\n", fname);
+        return -1;
+      }
+      g->x[dir][i] = 0.5*(g->xl[dir][i] + g->xr[dir][i]);
+    }
+  }
+  fclose (fp);
+
+  if (dir < 3){
+    fprintf (stderr, "! DblReadGrid(): cannot parse %s\n", fname);
+    return -1;
+  }
+  return 0;
+}
+
+/* ********************************************************************* */
+int DblReadOut (DblArchive *arc)
+/*!
+ * Read the list of files from <ext>.out.
+ * Incomplete (not yet newline-terminated) lines are ignored, and so are
+ * stale lines left after a restart from an earlier file.
+ *********************************************************************** */
+{
+  int    nv, dir, pos, nmax = 0, little = 1;
+  char   fname[512], line[4096], layout[32], order[16], *tok, *name;
+  size_t nelem, offset;
+  DblSnap *sn;
+  FILE   *fp;
+
+  little = (*(char *)&little == 1);  /* local byte order */
+
+  snprintf (fname, sizeof(fname), "%s/%s.out", arc->dir, arc->ext);
+  fp = fopen (fname, "r");
+  if (fp == NULL){
+    fprintf (stderr, "! DblReadOut(): cannot open %s\n", fname);
+    return -1;
+  }
+
+  arc->nsnap = 0;
+  while (fgets(line, sizeof(line), fp) != NULL){
+    if (line[strlen(line) - 1] != '\n') break;
+    if (arc->nsnap == nmax){
+      nmax = 2*nmax + 64;
+      arc->snap = (DblSnap *) realloc (arc->snap, nmax*sizeof(DblSnap));
+    }
+    sn = arc->snap + arc->nsnap;
+    memset (sn, 0, sizeof(DblSnap));
+
+    if (sscanf(line, "%d %lf %lf %ld %31s %15s%n", &sn->nfile, &sn->t,
+               &sn->dt, &sn->step, layout, order, &pos) != 6) break;
+    if (arc->nsnap > 0 && sn->nfile != sn[-1].nfile + 1) break;
+    if (strcmp(layout, "single_file")){
+      fclose (fp);
+      fprintf (stderr, "! DblReadOut(): only single_file output is supported\n");
+      return -1;
+    }
+    sn->swap = (strcmp(order, "little") == 0) != little;
+
+  /* -- Variable names follow the first six fields -- */
+
+    for (tok = strtok(line + pos, " \t\n"); tok != NULL;
+         tok = strtok(NULL, " \t\n")){
+      if (sn->nvar == DBL_MAX_VARS) break;
+      snprintf (sn->var_name[sn->nvar++], DBL_NAME_LEN, "%s", tok);
+    }
+
+  /* -- Byte offsets (staggered fields: one more zone) -- */
+
+    offset = 0;
+    for (nv = 0; nv < sn->nvar; nv++){
+      name = sn->var_name[nv];
+      sn->stag[nv] = -1;
+      if (strlen(name) == 4 && name[3] == 's' && name[2] >= '1' && name[2] <= '3'){
+        sn->stag[nv] = name[2] - '1';
+      }
+      nelem = 1;
+      for (dir = 0; dir < 3; dir++){
+        nelem *= arc->grid.np[dir] + (sn->stag[nv] == dir);
+      }
+      sn->offset[nv] = offset;
+      offset += nelem*arc->elsize;
+    }
+    sn->size = offset;
+    arc->nsnap++;
+  }
+  fclose (fp);
+  return 0;
+}
+
+/* ********************************************************************* */
+int DblFileMap (const DblArchive *arc, int n, DblFile *f)
+/*!
+ * Map the n-th file of the archive (n is the position in the .out
+ * list, not the file number) read-only in memory.
+ *
+ * \param [in]  arc  the archive descriptor
+ * \param [in]  n    index of the file in arc->snap
+ * \param [out] f    the mapped file
+ *********************************************************************** */
+{
+  int    fd;
+  char   fname[512];
+  struct stat st;
+
+  memset (f, 0, sizeof(DblFile));
+  if (n < 0 || n >= arc->nsnap){
+    fprintf (stderr, "! DblFileMap(): file index %d out of range\n", n);
+    return -1;
+  }
+  f->arc  = arc;
+  f->snap = arc->snap + n;
+
+  snprintf (fname, sizeof(fname), "%s/data.%04d.%s", arc->dir,
+            f->snap->nfile, arc->ext);
+  fd = open (fname, O_RDONLY);
+  if (fd < 0){
+    fprintf (stderr, "! DblFileMap(): cannot open %s\n", fname);
+    return -1;
+  }
+  if (fstat(fd, &st) != 0 || (size_t)st.st_size < f->snap->size){
+    close (fd);
+    fprintf (stderr, "! DblFileMap(): %s is smaller than expected (%zu bytes)\n",
+             fname, f->snap->size);
+    return -1;
+  }
+  f->len  = f->snap->size;
+  f->addr = mmap (NULL, f->len, PROT_READ, MAP_SHARED, fd, 0);
+  close (fd);
+  if (f->addr == MAP_FAILED){
+    f->addr = NULL;
+    fprintf (stderr, "! DblFileMap(): cannot map %s\n", fname);
+    return -1;
+  }
+  return 0;
+}
+
+/* ********************************************************************* */
+void DblFileUnmap (DblFile *f)
+/*!
+ * Release a file mapped with DblFileMap().
+ *********************************************************************** */
+{
+  if (f->addr != NULL) munmap (f->addr, f->len);
+  f->addr = NULL;
+  f->len  = 0;
+}
+
+/* ********************************************************************* */
+int DblVarIndex (const DblSnap *sn, const char *name)
+/*!
+ * Return the position of the variable in the file, or -1 if absent.
+ *********************************************************************** */
+{
+  int nv;
+
+  for (nv = 0; nv < sn->nvar; nv++){
+    if (strcmp(sn->var_name[nv], name) == 0) return nv;
+  }
+  return -1;
+}
+
+/* ********************************************************************* */
+int DblNearestIndex (const DblGrid *g, int dir, double x)
+/*!
+ * Return the 0-based index of the zone center closest to x in
+ * direction dir.
+ *********************************************************************** */
+{
+  int i, imin = 0;
+
+  for (i = 1; i < g->np[dir]; i++){
+    if (fabs(g->x[dir][i] - x) < fabs(g->x[dir][imin] - x)) imin = i;
+  }
+  return imin;
+}
+
+/* ********************************************************************* */
+size_t DblOffset (const DblArchive *arc, const DblSnap *sn, int nv,
+                  long k, long j, long i)
+/*!
+ * Return the byte offset of zone (k,j,i) of variable nv in the file.
+ * Indices are 0-based and refer to the interior zones only.
+ *********************************************************************** */
+{
+  size_t ni = arc->grid.np[0] + (sn->stag[nv] == 0);
+  size_t nj = arc->grid.np[1] + (sn->stag[nv] == 1);
+
+  return sn->offset[nv] + (((size_t)k*nj + j)*ni + i)*arc->elsize;
+}
+
+/* ********************************************************************* */
+double DblValue (const DblFile *f, int nv, long k, long j, long i)
+/*!
+ * Return the value of variable nv at zone (k,j,i), converted to
+ * double precision and to the local byte order.
+ *********************************************************************** */
+{
+  int    b;
+  unsigned char c[8], *p;
+  float  xf;
+  double xd;
+
+  p = (unsigned char *)f->addr + DblOffset(f->arc, f->snap, nv, k, j, i);
+  if (f->snap->swap){
+    for (b = 0; b < f->arc->elsize; b++) c[b] = p[f->arc->elsize - 1 - b];
+    p = c;
+  }
+  if (f->arc->elsize == 8){
+    memcpy (&xd, p, 8);
+    return xd;
+  }
+  memcpy (&xf, p, 4);
+  return (double)xf;
+}
+
+/* ********************************************************************* */
+int DblGather (const DblArchive *arc, int n0, int n1, int nvar,
+               char (*var)[DBL_NAME_LEN], int (*box)[3][2], int moving,
+               int nthreads, double *out)
+/*!
+ * Extract a box of zones of the given variables from files n0 to n1
+ * (positions in arc->snap, inclusive).
+ *
+ * \param [in]  arc      the archive descriptor
+ * \param [in]  n0,n1    range of files
+ * \param [in]  nvar     number of variables
+ * \param [in]  var      names of the variables
+ * \param [in]  box      0-based index range box[dir][0..1]; when
+ *                       \c moving is 1, one box per file (all with the
+ *                       same size), otherwise a single box
+ * \param [in]  moving   see above
+ * \param [in]  nthreads number of threads
+ * \param [out] out      values, ordered as [file][var][k][j][i]
+ *
+ * \return 0 on success, -1 if a file or variable is missing.
+ *********************************************************************** */
+{
+  int    t, err = 0;
+  DblTask   *task;
+  pthread_t *tid;
+
+  if (n0 < 0 || n1 >= arc->nsnap || n0 > n1){
+    fprintf (stderr, "! DblGather(): invalid file range %d-%d\n", n0, n1);
+    return -1;
+  }
+  if (nthreads < 1) nthreads = 1;
+  if (nthreads > n1 - n0 + 1) nthreads = n1 - n0 + 1;
+
+  task = (DblTask *) malloc (nthreads*sizeof(DblTask));
+  tid  = (pthread_t *) malloc (nthreads*sizeof(pthread_t));
+  for (t = 0; t < nthreads; t++){
+    task[t].arc      = arc;
+    task[t].n0       = n0;
+    task[t].n1       = n1;
+    task[t].nvar     = nvar;
+    task[t].var      = var;
+    task[t].box      = box;
+    task[t].moving   = moving;
+    task[t].nthreads = nthreads;
+    task[t].id       = t;
+    task[t].out      = out;
+    task[t].err      = 0;
+    if (t > 0) pthread_create (tid + t, NULL, DblGatherThread, task + t);
+  }
+  DblGatherThread (task);
+  for (t = 1; t < nthreads; t++) pthread_join (tid[t], NULL);
+  for (t = 0; t < nthreads; t++) err = err || task[t].err;
+
+  free (task);
+  free (tid);
+  return err ? -1:0;
+}
+
+/* ********************************************************************* */
+void *DblGatherThread (void *arg)
+/*!
+ * Gather the values of files n0 + id, n0 + id + nthreads, ...
+ *********************************************************************** */
+{
+  DblTask *tk = (DblTask *)arg;
+  int    n, m, nv, i, j, k, (*b)[2];
+  long   nbox, ind;
+  DblFile f;
+
+  b    = tk->box[0];
+  nbox = (long)(b[0][1] - b[0][0] + 1)*(b[1][1] - b[1][0] + 1)
+                                      *(b[2][1] - b[2][0] + 1);
+
+  for (n = tk->n0 + tk->id; n <= tk->n1; n += tk->nthreads){
+    if (DblFileMap (tk->arc, n, &f) != 0) {tk->err = 1; continue;}
+    if (nbox < DBL_RANDOM_ACCESS) madvise (f.addr, f.len, MADV_RANDOM);
+    b   = tk->box[tk->moving ? n - tk->n0:0];
+    ind = (long)(n - tk->n0)*tk->nvar*nbox;
+    for (m = 0; m < tk->nvar; m++){
+      nv = DblVarIndex (f.snap, tk->var[m]);
+      if (nv < 0){
+        fprintf (stderr, "! DblGather(): no variable '%s' in file %d\n",
+                 tk->var[m], f.snap->nfile);
+        tk->err = 1;
+        break;
+      }
+      for (k = b[2][0]; k <= b[2][1]; k++){
+      for (j = b[1][0]; j <= b[1][1]; j++){
+      for (i = b[0][0]; i <= b[0][1]; i++){
+        tk->out[ind++] = DblValue (&f, nv, k, j, i);
+      }}}
+    }
+    DblFileUnmap (&f);
+  }
+  return NULL;
+}
@@ -0,0 +1,85 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Memory-mapped access to PLUTO .dbl / .flt output archives.
+
+  A PLUTO output directory is described by \c grid.out (zone
+  interfaces and geometry) and by \c dbl.out (or \c flt.out), listing
+  for every file its number, time, step, byte order and variable names.
+  DblArchiveOpen() parses both; DblFileMap() maps one
+  <tt> data.nnnn.dbl </tt> file in memory so that any value can be
+  addressed directly without reading the file.
+
+  Only the \c single_file layout is supported: variables are stored one
+  after the other, each as a 3D array with the x1 index running fastest.
+  Staggered fields (e.g. \c Bx1s) have one more zone in their staggered
+  direction.
+
+  DblGather() extracts the same box of zones (a single zone for a point
+  time series) from a range of files using several threads, each one
+  mapping its own files: only the pages containing the requested zones
+  are read from disk.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#ifndef DBL_MAP_H
+#define DBL_MAP_H
+
+#include <stddef.h>
+
+#define DBL_MAX_VARS    64
+#define DBL_NAME_LEN    32
+
+typedef struct DblGrid_{
+  int    dimensions;
+  char   geometry[16];     /**< As in grid.out, e.g. "SPHERICAL" */
+  int    np[3];            /**< Number of interior zones */
+  double *xl[3];           /**< Left zone interfaces */
+  double *xr[3];           /**< Right zone interfaces */
+  double *x[3];            /**< Zone centers */
+} DblGrid;
+
+typedef struct DblSnap_{
+  int    nfile;
+  long   step;
+  double t;
+  double dt;
+  int    swap;             /**< 1 if byte order differs from this machine */
+  int    nvar;
+  char   var_name[DBL_MAX_VARS][DBL_NAME_LEN];
+  int    stag[DBL_MAX_VARS];    /**< Staggered direction or -1 */
+  size_t offset[DBL_MAX_VARS];  /**< Byte offset of each variable */
+  size_t size;                  /**< Expected file size (bytes) */
+} DblSnap;
+
+typedef struct DblArchive_{
+  char    dir[256];
+  char    ext[4];          /**< "dbl" or "flt" */
+  int     elsize;          /**< 8 (dbl) or 4 (flt) */
+  DblGrid grid;
+  int     nsnap;
+  DblSnap *snap;
+} DblArchive;
+
+typedef struct DblFile_{
+  const DblArchive *arc;
+  const DblSnap    *snap;
+  void   *addr;
+  size_t len;
+} DblFile;
+
+int    DblArchiveOpen (DblArchive *, const char *, const char *);
+int    DblArchiveUpdate (DblArchive *);
+void   DblArchiveClose (DblArchive *);
+int    DblFileMap (const DblArchive *, int, DblFile *);
+void   DblFileUnmap (DblFile *);
+int    DblVarIndex (const DblSnap *, const char *);
+int    DblNearestIndex (const DblGrid *, int, double);
+size_t DblOffset (const DblArchive *, const DblSnap *, int, long, long, long);
+double DblValue (const DblFile *, int, long, long, long);
+int    DblGather (const DblArchive *, int, int, int, char (*)[DBL_NAME_LEN],
+                  int (*)[3][2], int, int, double *);
+
+#endif /* DBL_MAP_H */
@@ -0,0 +1,729 @@
+/* ///////////////////////////////////////////////////////////////////// */
+/*!
+  \file
+  \brief Offline conversion of .dbl output files to VTK, NetCDF and
+         slice products.
+
+  \c pluto-convert lets a run write double-precision \c .dbl files only
+  and produces the visualization / distribution formats afterwards (or
+  alongside the run, see \c -watch) on a different set of processors:
+  \verbatim
+   mpirun -n 16 ./pluto-convert -d ./out -vtk -nc -flt
+   mpirun -n 4  ./pluto-convert -d ./out -slice ecliptic theta 90 rho,vx1 -watch 600
+  \endverbatim
+  Options:
+
+  - <tt> -d dir </tt>: directory containing grid.out, dbl.out and the
+    .dbl files (default: current directory);
+  - <tt> -o dir </tt>: directory for the converted files (default: same
+    as \c -d);
+  - \c -vtk : legacy VTK files <tt> data.nnnn.vtk </tt>, identical to
+    those written by PLUTO with \c VTK_VECTOR_DUMP and \c VTK_TIME_INFO
+    enabled (use \c -novec to write vector components as scalars and
+    \c -notime to omit the time field);
+  - \c -nc : one NetCDF-4 file per snapshot, <tt> data.nnnn.nc </tt>,
+    with the same layout as the \c nc output (available when compiled
+    with \c USE_NETCDF);
+  - <tt> -slice name kind params vars </tt>: slice or box products
+    <tt> name.nnnn.dbl </tt> (or \c .flt) plus the list <tt> name.out
+    </tt>, with the same kinds and format as the <tt> [Slices] </tt>
+    section of pluto.ini (see slices.c); may be repeated;
+  - <tt> -vars v1,v2,... </tt>: restrict VTK and NetCDF output to the
+    given variables;
+  - \c -flt : single precision for NetCDF and slice products;
+  - <tt> -range n0 n1 </tt>: convert only file numbers n0 to n1;
+  - \c -force : convert again files whose products are already more
+    recent than the .dbl file (these are skipped by default);
+  - <tt> -watch sec </tt>: after converting the existing files, keep
+    polling dbl.out and convert new files as they are written, until
+    none appears for \c sec seconds.
+
+  Files are memory-mapped (see dbl_map.c) and assigned round-robin to
+  processes according to their file number, each process converting
+  whole snapshots independently: no communication is needed apart from
+  synchronization in watch mode.
+  Values are written in code units.
+
+  \author pluto-solarwind developers
+  \date   Oct 19, 2026
+*/
+/* ///////////////////////////////////////////////////////////////////// */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <ctype.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#ifdef PARALLEL
+ #include <mpi.h>
+#endif
+#ifdef USE_NETCDF
+ #include <netcdf.h>
+#endif
+#include "dbl_map.h"
+
+#ifndef PLUTO_VERSION
+ #define PLUTO_VERSION  "4.4-patch2"
+#endif
+
+#define MAX_SLICES   16
+
+typedef struct Slice_{
+  char name[64];
+  int  box[3][2];              /**< Global 0-based index range */
+  int  nvar;                   /**< 0 means all variables */
+  char var[DBL_MAX_VARS][DBL_NAME_LEN];
+} Slice;
+
+static int    prank = 0, nproc = 1;
+static int    do_vtk = 0, do_nc = 0, vectors = 1, time_info = 1;
+static int    single = 0, force = 0;
+static int    nsel = 0;
+static char   sel_var[DBL_MAX_VARS][DBL_NAME_LEN];
+static char   out_dir[256];
+static Slice  slice[MAX_SLICES];
+static int    nslices = 0;
+
+static void   Quit (int);
+static void   Usage (void);
+static int    ParseSlice (char **, int, int, DblGrid *, Slice *);
+static int    ParseVarList (char *, char (*)[DBL_NAME_LEN]);
+static int    Selected (const char *);
+static int    UpToDate (const char *, const char *);
+static int    ConvertFile (DblArchive *, int);
+static void   WriteVTK (DblFile *, const char *);
+static void   WriteSlice (DblFile *, Slice *, const char *);
+static void   WriteSliceList (DblArchive *, Slice *, int);
+#ifdef USE_NETCDF
+static void   WriteNetCDF (DblFile *, const char *);
+#endif
+
+/* ********************************************************************* */
+int main (int argc, char *argv[])
+/*!
+ * Parse the command line and convert files.
+ *********************************************************************** */
+{
+  int    n, nc, nsnap, nnew, ns;
+  int    range[2] = {0, 1 << 30};
+  double watch = -1.0, idle;
+  char   in_dir[256] = ".";
+  DblArchive arc;
+
+  #ifdef PARALLEL
+  MPI_Init (&argc, &argv);
+  MPI_Comm_rank (MPI_COMM_WORLD, &prank);
+  MPI_Comm_size (MPI_COMM_WORLD, &nproc);
+  #endif
+
+  out_dir[0] = '\0';
+  for (n = 1; n < argc; n++){
+    if      (!strcmp(argv[n], "-d") && n + 1 < argc) snprintf (in_dir, 256, "%s", argv[++n]);
+    else if (!strcmp(argv[n], "-o") && n + 1 < argc) snprintf (out_dir, 256, "%s", argv[++n]);
+    else if (!strcmp(argv[n], "-vtk"))   do_vtk  = 1;
+    else if (!strcmp(argv[n], "-nc"))    do_nc   = 1;
+    else if (!strcmp(argv[n], "-novec")) vectors = 0;
+    else if (!strcmp(argv[n], "-notime")) time_info = 0;
+    else if (!strcmp(argv[n], "-flt"))   single  = 1;
+    else if (!strcmp(argv[n], "-force")) force   = 1;
+    else if (!strcmp(argv[n], "-vars") && n + 1 < argc){
+      nsel = ParseVarList (argv[++n], sel_var);
+    }else if (!strcmp(argv[n], "-range") && n + 2 < argc){
+      range[0] = atoi(argv[++n]);
+      range[1] = atoi(argv[++n]);
+    }else if (!strcmp(argv[n], "-watch") && n + 1 < argc){
+      watch = atof(argv[++n]);
+    }else if (!strcmp(argv[n], "-slice") && n + 4 < argc){
+      if (nslices == MAX_SLICES){
+        if (prank == 0) fprintf (stderr, "! Too many slices (max %d)\n", MAX_SLICES);
+        Quit (1);
+      }
+      nslices++;    /* parsed below, once the grid is known */
+      n += (strcmp(argv[n + 2], "box") == 0 ? 9:4);
+    }else{
+      if (prank == 0) Usage();
+      Quit (strcmp(argv[n], "-h") != 0);
+    }
+  }
+  if (out_dir[0] == '\0') strcpy (out_dir, in_dir);
+
+  #ifndef USE_NETCDF
+  if (do_nc){
+    if (prank == 0) fprintf (stderr, "! NetCDF output requires USE_NETCDF\n");
+    Quit (1);
+  }
+  #endif
+  if (!do_vtk && !do_nc && nslices == 0){
+    if (prank == 0) Usage();
+    Quit (1);
+  }
+
+  if (DblArchiveOpen (&arc, in_dir, "dbl") != 0) Quit (1);
+
+/* -- Slices: parse now that the grid is known -- */
+
+  ns = 0;
+  for (n = 1; n < argc && ns < nslices; n++){
+    if (strcmp(argv[n], "-slice")) continue;
+    if (ParseSlice (argv, n + 1, argc, &arc.grid, slice + ns) != 0) Quit (1);
+    ns++;
+  }
+
+/* --------------------------------------------------------
+   Convert the files owned by this process (nfile % nproc),
+   then in watch mode wait for new ones.
+   -------------------------------------------------------- */
+
+  nsnap = 0;
+  idle  = 0.0;
+  while (1){
+    nnew = arc.nsnap;
+    #ifdef PARALLEL
+    MPI_Allreduce (&arc.nsnap, &nnew, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    #endif
+    if (nnew > nsnap){
+      nc = 0;
+      for (n = nsnap; n < nnew; n++){
+        int nfile = arc.snap[n].nfile;
+        if (nfile < range[0] || nfile > range[1]) continue;
+        if (nfile % nproc != prank) continue;
+        nc += ConvertFile (&arc, n);
+      }
+      #ifdef PARALLEL
+      MPI_Barrier (MPI_COMM_WORLD);
+      #endif
+      for (ns = 0; ns < nslices; ns++){
+        if (prank == 0) WriteSliceList (&arc, slice + ns, nnew);
+      }
+      if (nc > 0) printf ("> [rank %d] %d file(s) converted\n", prank, nc);
+      nsnap = nnew;
+      idle  = 0.0;
+    }
+
+    if (watch < 0.0 || idle >= watch) break;
+    sleep (1);
+    idle += 1.0;
+    if (DblArchiveUpdate (&arc) != 0) Quit (1);
+  }
+
+  DblArchiveClose (&arc);
+  Quit (0);
+  return 0;
+}
+
+/* ********************************************************************* */
+void Quit (int err)
+/*!
+ * Terminate (all processes on error).
+ *********************************************************************** */
+{
+  #ifdef PARALLEL
+  if (err) MPI_Abort (MPI_COMM_WORLD, err);
+  MPI_Finalize ();
+  #endif
+  exit (err);
+}
+
+/* ********************************************************************* */
+void Usage (void)
+/*!
+ * Print a short summary of the options.
+ *********************************************************************** */
+{
+  printf ("Usage: pluto-convert [options]\n\n");
+  printf (" -d dir           input directory (grid.out, dbl.out, data.*.dbl)\n");
+  printf (" -o dir           output directory (default: input directory)\n");
+  printf (" -vtk             write legacy VTK files\n");
+  printf (" -nc              write one NetCDF-4 file per snapshot\n");
+  printf (" -slice name kind params vars\n");
+  printf ("                  write slice products (kind = x1|x2|x3|shell|\n");
+  printf ("                  theta|phi value, or box i0 i1 j0 j1 k0 k1)\n");
+  printf (" -vars v1,v2,...  restrict VTK/NetCDF output to these variables\n");
+  printf (" -novec           write vector components as VTK scalars\n");
+  printf (" -notime          do not write the time field in VTK files\n");
+  printf (" -flt             single precision NetCDF / slice output\n");
+  printf (" -range n0 n1     convert file numbers n0 to n1 only\n");
+  printf (" -force           convert files that are already up to date\n");
+  printf (" -watch sec       convert new files until none appears for sec s\n");
+}
+
+/* ********************************************************************* */
+int ParseSlice (char **argv, int n, int argc, DblGrid *g, Slice *s)
+/*!
+ * Parse "name kind params vars" starting at argv[n], as in the
+ * [Slices] section of pluto.ini (without cadence and precision).
+ *********************************************************************** */
+{
+  int    dir;
+  char   *kind = argv[n + 1];
+  double x;
+
+  snprintf (s->name, sizeof(s->name), "%s", argv[n]);
+  for (dir = 0; dir < 3; dir++){
+    s->box[dir][0] = 0;
+    s->box[dir][1] = g->np[dir] - 1;
+  }
+
+  dir = -1;
+  if      (!strcmp(kind,"x1") || !strcmp(kind,"shell")) dir = 0;
+  else if (!strcmp(kind,"x2") || !strcmp(kind,"theta")) dir = 1;
+  else if (!strcmp(kind,"x3") || !strcmp(kind,"phi"))   dir = 2;
+  else if (!strcmp(kind,"box")){
+    if (n + 8 >= argc) goto bad;
+    for (dir = 0; dir < 3; dir++){
+      s->box[dir][0] = atoi(argv[n + 2 + 2*dir]);
+      s->box[dir][1] = atoi(argv[n + 3 + 2*dir]);
+      if (s->box[dir][0] < 0) s->box[dir][0] = 0;
+      if (s->box[dir][1] > g->np[dir] - 1) s->box[dir][1] = g->np[dir] - 1;
+      if (s->box[dir][0] > s->box[dir][1]) goto bad;
+    }
+    s->nvar = ParseVarList (argv[n + 8], s->var);
+    return 0;
+  }else goto bad;
+
+  x = atof(argv[n + 2]);
+  if (!strcmp(kind,"theta") || !strcmp(kind,"phi")) x *= M_PI/180.0;
+  s->box[dir][0] = s->box[dir][1] = DblNearestIndex (g, dir, x);
+  s->nvar = ParseVarList (argv[n + 3], s->var);
+  return 0;
+
+bad:
+  if (prank == 0) fprintf (stderr, "! Invalid slice '%s'\n", argv[n]);
+  return -1;
+}
+
+/* ********************************************************************* */
+int ParseVarList (char *list, char (*var)[DBL_NAME_LEN])
+/*!
+ * Split a comma-separated list of names; "all" gives an empty list.
+ *********************************************************************** */
+{
+  int  nv = 0;
+  char *tok;
+
+  for (tok = strtok(list, ","); tok != NULL; tok = strtok(NULL, ",")){
+    if (!strcmp(tok, "all")) return 0;
+    if (nv < DBL_MAX_VARS) snprintf (var[nv++], DBL_NAME_LEN, "%s", tok);
+  }
+  return nv;
+}
+
+/* ********************************************************************* */
+int Selected (const char *name)
+/*!
+ * Return 1 if the variable is to be written in VTK / NetCDF files.
+ *********************************************************************** */
+{
+  int n;
+
+  if (nsel == 0) return 1;
+  for (n = 0; n < nsel; n++) if (!strcmp(sel_var[n], name)) return 1;
+  return 0;
+}
+
+/* ********************************************************************* */
+int UpToDate (const char *src, const char *dst)
+/*!
+ * Return 1 if dst exists and is not older than src.
+ *********************************************************************** */
+{
+  struct stat s1, s2;
+
+  if (force || stat(src, &s1) != 0 || stat(dst, &s2) != 0) return 0;
+  return s2.st_mtime >= s1.st_mtime;
+}
+
+/* ********************************************************************* */
+int ConvertFile (DblArchive *arc, int n)
+/*!
+ * Write all requested products of the n-th file of the archive.
+ * Return 1 if anything was written.
+ *********************************************************************** */
+{
+  int    ns, nw = 0, nfile = arc->snap[n].nfile;
+  char   src[512], dst[512];
+  DblFile f;
+
+  snprintf (src, sizeof(src), "%s/data.%04d.dbl", arc->dir, nfile);
+  f.addr = NULL;
+
+  #define MAP_ONCE  if (f.addr == NULL && DblFileMap (arc, n, &f) != 0) Quit (1);
+
+  if (do_vtk){
+    snprintf (dst, sizeof(dst), "%s/data.%04d.vtk", out_dir, nfile);
+    if (!UpToDate (src, dst)) {MAP_ONCE; WriteVTK (&f, dst); nw = 1;}
+  }
+  #ifdef USE_NETCDF
+  if (do_nc){
+    snprintf (dst, sizeof(dst), "%s/data.%04d.nc", out_dir, nfile);
+    if (!UpToDate (src, dst)) {MAP_ONCE; WriteNetCDF (&f, dst); nw = 1;}
+  }
+  #endif
+  for (ns = 0; ns < nslices; ns++){
+    snprintf (dst, sizeof(dst), "%s/%s.%04d.%s", out_dir, slice[ns].name,
+              nfile, single ? "flt":"dbl");
+    if (!UpToDate (src, dst)) {MAP_ONCE; WriteSlice (&f, slice + ns, dst); nw = 1;}
+  }
+  #undef MAP_ONCE
+
+  DblFileUnmap (&f);
+  return nw;
+}
+
+/* ********************************************************************* */
+static void SwapBigEndian (float *v, long n)
+/*!
+ * Convert an array of floats to big endian order (VTK) in place.
+ *********************************************************************** */
+{
+  long i;
+  int  little = 1;
+  unsigned char *p, c;
+
+  if (*(char *)&little != 1) return;
+  for (i = 0; i < n; i++){
+    p = (unsigned char *)(v + i);
+    c = p[0]; p[0] = p[3]; p[3] = c;
+    c = p[1]; p[1] = p[2]; p[2] = c;
+  }
+}
+
+/* ********************************************************************* */
+void WriteVTK (DblFile *f, const char *fname)
+/*!
+ * Write a legacy VTK file with the same layout as write_vtk.c:
+ * big endian single precision, rectilinear grid for Cartesian and
+ * cylindrical geometries, structured grid (Cartesian node coordinates)
+ * otherwise; optional time field; velocity and magnetic field as
+ * vectors first, then scalars.
+ *********************************************************************** */
+{
+  int    i, j, k, c, nv, dir, nvec, vec[2][3];
+  int    dims = f->arc->grid.dimensions, incl[3], nx[3];
+  int    rectilinear, polar, spherical, little = 1;
+  char   *gname = (char *)f->arc->grid.geometry, *vname[2] = {"vx", "Bx"};
+  char   label[DBL_NAME_LEN];
+  long   n, ncell, nnode;
+  float  *buf;
+  double v[3], w[3], xn[3], st, ct, t;
+  const DblGrid *g = &f->arc->grid;
+  const DblSnap *sn = f->snap;
+  FILE   *fp;
+
+  for (dir = 0; dir < 3; dir++){
+    incl[dir] = (dir < dims);
+    nx[dir]   = g->np[dir];
+  }
+  rectilinear = !strcmp(gname, "CARTESIAN") || !strcmp(gname, "CYLINDRICAL");
+  polar       = !strcmp(gname, "POLAR");
+  spherical   = !strcmp(gname, "SPHERICAL");
+  ncell = (long)nx[0]*nx[1]*nx[2];
+  nnode = (long)(nx[0] + incl[0])*(nx[1] + incl[1])*(nx[2] + incl[2]);
+  buf   = (float *) malloc (3*(ncell > nnode ? ncell:nnode)*sizeof(float));
+
+  fp = fopen (fname, "wb");
+  if (fp == NULL){
+    fprintf (stderr, "! WriteVTK(): cannot open %s\n", fname);
+    Quit (1);
+  }
+  fprintf (fp, "# vtk DataFile Version 2.0\n");
+  fprintf (fp, "PLUTO %s VTK Data\n", PLUTO_VERSION);
+  fprintf (fp, "BINARY\n");
+  fprintf (fp, "DATASET %s\n", rectilinear ? "RECTILINEAR_GRID":"STRUCTURED_GRID");
+  if (time_info){
+    unsigned char *p = (unsigned char *)&t, b;
+    t = sn->t;
+    if (*(char *)&little == 1){
+      for (i = 0; i < 4; i++) {b = p[i]; p[i] = p[7-i]; p[7-i] = b;}
+    }
+    fprintf (fp, "FIELD FieldData 1\n");
+    fprintf (fp, "TIME 1 1 double\n");
+    fwrite (&t, sizeof(double), 1, fp);
+    fprintf (fp, "\n");
+  }
+  fprintf (fp, "DIMENSIONS %d %d %d\n", nx[0] + incl[0], nx[1] + incl[1],
+                                         nx[2] + incl[2]);
+
+  #define NODE(d,i)  ((i) < nx[d] ? g->xl[d][i]:g->xr[d][nx[d]-1])
+
+/* -- Grid -- */
+
+  if (rectilinear){
+    for (dir = 0; dir < 3; dir++){
+      for (i = 0; i < nx[dir] + incl[dir]; i++) {
+        buf[i] = (dir == 2 && !incl[2]) ? 0.0:(float)NODE(dir,i);
+      }
+      SwapBigEndian (buf, nx[dir] + incl[dir]);
+      fprintf (fp, "%c_COORDINATES %d float\n", 'X' + dir, nx[dir] + incl[dir]);
+      fwrite (buf, sizeof(float), nx[dir] + incl[dir], fp);
+      if (dir < 2) fprintf (fp, "\n");
+    }
+  }else{
+    fprintf (fp, "POINTS %ld float\n", nnode);
+    n = 0;
+    xn[0] = xn[1] = xn[2] = 0.0;
+    for (k = 0; k < nx[2] + incl[2]; k++){
+    for (j = 0; j < nx[1] + incl[1]; j++){
+    for (i = 0; i < nx[0] + incl[0]; i++){
+      if (incl[0]) xn[0] = (float)NODE(0,i);  /* single precision nodes, */
+      if (incl[1]) xn[1] = (float)NODE(1,j);  /* as in write_vtk.c        */
+      if (incl[2]) xn[2] = (float)NODE(2,k);
+      if (polar){
+        buf[n++] = xn[0]*cos(xn[1]);
+        buf[n++] = xn[0]*sin(xn[1]);
+        buf[n++] = xn[2];
+      }else if (spherical && dims == 2){
+        buf[n++] = xn[0]*sin(xn[1]);
+        buf[n++] = xn[0]*cos(xn[1]);
+        buf[n++] = 0.0;
+      }else if (spherical){
+        buf[n++] = xn[0]*sin(xn[1])*cos(xn[2]);
+        buf[n++] = xn[0]*sin(xn[1])*sin(xn[2]);
+        buf[n++] = xn[0]*cos(xn[1]);
+      }
+    }}}
+    SwapBigEndian (buf, n);
+    fwrite (buf, sizeof(float), n, fp);
+  }
+  #undef NODE
+  fprintf (fp, "\nCELL_DATA %ld\n", ncell);
+
+/* -- Vectors: the first DIMENSIONS components of vx and Bx -- */
+
+  nvec = 0;
+  for (c = 0; c < 2 && vectors; c++){
+    sprintf (label, "%s1", vname[c]);
+    if (DblVarIndex(sn, label) < 0 || !Selected(label)) continue;
+    for (dir = 0; dir < 3; dir++){
+      sprintf (label, "%s%d", vname[c], dir + 1);
+      vec[nvec][dir] = (dir < dims ? DblVarIndex(sn, label):-1);
+    }
+
+    n = 0;
+    xn[0] = xn[1] = xn[2] = 0.0;
+    for (k = 0; k < nx[2]; k++){
+    for (j = 0; j < nx[1]; j++){
+    for (i = 0; i < nx[0]; i++){
+      for (dir = 0; dir < 3; dir++){
+        v[dir] = (vec[nvec][dir] >= 0 ? DblValue(f, vec[nvec][dir], k, j, i):0.0);
+      }
+      if (incl[0]) xn[0] = g->x[0][i];
+      if (incl[1]) xn[1] = g->x[1][j];
+      if (incl[2]) xn[2] = g->x[2][k];
+      w[0] = v[0]; w[1] = v[1]; w[2] = v[2];
+      if (polar){
+        w[0] = v[0]*cos(xn[1]) - v[1]*sin(xn[1]);
+        w[1] = v[0]*sin(xn[1]) + v[1]*cos(xn[1]);
+      }else if (spherical && dims == 2){
+        w[0] = v[0]*sin(xn[1]) + v[1]*cos(xn[1]);
+        w[1] = v[0]*cos(xn[1]) - v[1]*sin(xn[1]);
+      }else if (spherical){
+        st = v[0]*sin(xn[1]) + v[1]*cos(xn[1]);
+        ct = v[0]*cos(xn[1]) - v[1]*sin(xn[1]);
+        w[0] = st*cos(xn[2]) - v[2]*sin(xn[2]);
+        w[1] = st*sin(xn[2]) + v[2]*cos(xn[2]);
+        w[2] = ct;
+      }
+      buf[n++] = (float)w[0];
+      buf[n++] = (float)w[1];
+      buf[n++] = (float)w[2];
+    }}}
+    SwapBigEndian (buf, n);
+    fprintf (fp, "\nVECTORS %dD_%s_Field float\n", dims,
+             c == 0 ? "Velocity":"Magnetic");
+    fwrite (buf, sizeof(float), n, fp);
+    nvec++;
+  }
+
+/* -- Scalars: everything else except staggered fields -- */
+
+  for (nv = 0; nv < sn->nvar; nv++){
+    if (sn->stag[nv] >= 0 || !Selected(sn->var_name[nv])) continue;
+    for (c = 0; c < nvec; c++){
+      for (dir = 0; dir < 3; dir++) if (vec[c][dir] == nv) break;
+      if (dir < 3) break;
+    }
+    if (c < nvec) continue;
+
+    n = 0;
+    for (k = 0; k < nx[2]; k++){
+    for (j = 0; j < nx[1]; j++){
+    for (i = 0; i < nx[0]; i++){
+      buf[n++] = (float)DblValue(f, nv, k, j, i);
+    }}}
+    SwapBigEndian (buf, n);
+    fprintf (fp, "\nSCALARS %s float\n", sn->var_name[nv]);
+    fprintf (fp, "LOOKUP_TABLE default\n");
+    fwrite (buf, sizeof(float), n, fp);
+  }
+
+  fclose (fp);
+  free (buf);
+}
+
+#ifdef USE_NETCDF
+#define NC_CHECK(f)  {int nc_err_ = (f); if (nc_err_ != NC_NOERR) { \
+                       fprintf (stderr, "! WriteNetCDF(): %s (line %d)\n", \
+                                nc_strerror(nc_err_), __LINE__);  \
+                       Quit(1);}}
+/* ********************************************************************* */
+void WriteNetCDF (DblFile *f, const char *fname)
+/*!
+ * Write one snapshot to a NetCDF-4 file with the same layout as
+ * nc_io.c: var(time, x3, x2, x1), coordinate variables and time.
+ *********************************************************************** */
+{
+  int    i, j, k, nv, dir, ncid, varid, dimid[4];
+  char   *dname[] = {"x1", "x2", "x3"}, geom[16];
+  long   n;
+  size_t start[4] = {0, 0, 0, 0}, count[4];
+  float  *fbuf;
+  double *dbuf;
+  const DblGrid *g  = &f->arc->grid;
+  const DblSnap *sn = f->snap;
+
+  NC_CHECK(nc_create(fname, NC_NETCDF4|NC_CLOBBER, &ncid));
+  NC_CHECK(nc_def_dim(ncid, "time", NC_UNLIMITED, dimid));
+  NC_CHECK(nc_def_var(ncid, "time", NC_DOUBLE, 1, dimid, &varid));
+  for (dir = 0; dir < 3; dir++){
+    NC_CHECK(nc_def_dim(ncid, dname[dir], g->np[dir], dimid + 3 - dir));
+    NC_CHECK(nc_def_var(ncid, dname[dir], NC_DOUBLE, 1, dimid + 3 - dir, &varid));
+  }
+  for (i = 0; g->geometry[i] != '\0'; i++) geom[i] = tolower(g->geometry[i]);
+  geom[i] = '\0';
+  NC_CHECK(nc_put_att_text(ncid, NC_GLOBAL, "geometry", strlen(geom), geom));
+  NC_CHECK(nc_put_att_text(ncid, NC_GLOBAL, "units", 4, "code"));
+  for (nv = 0; nv < sn->nvar; nv++){
+    if (sn->stag[nv] >= 0 || !Selected(sn->var_name[nv])) continue;
+    NC_CHECK(nc_def_var(ncid, sn->var_name[nv], single ? NC_FLOAT:NC_DOUBLE,
+                        4, dimid, &varid));
+  }
+  NC_CHECK(nc_enddef(ncid));
+
+/* -- Time and coordinates -- */
+
+  count[0] = 1;
+  NC_CHECK(nc_inq_varid (ncid, "time", &varid));
+  NC_CHECK(nc_put_vara_double(ncid, varid, start, count, &sn->t));
+  for (dir = 0; dir < 3; dir++){
+    count[0] = g->np[dir];
+    NC_CHECK(nc_inq_varid (ncid, dname[dir], &varid));
+    NC_CHECK(nc_put_vara_double(ncid, varid, start, count, g->x[dir]));
+  }
+
+/* -- Variables -- */
+
+  count[0] = 1;
+  count[1] = g->np[2];
+  count[2] = g->np[1];
+  count[3] = g->np[0];
+  n    = (long)g->np[0]*g->np[1]*g->np[2];
+  fbuf = (float *)  malloc (n*sizeof(float));
+  dbuf = (double *) malloc (n*sizeof(double));
+  for (nv = 0; nv < sn->nvar; nv++){
+    if (sn->stag[nv] >= 0 || !Selected(sn->var_name[nv])) continue;
+    NC_CHECK(nc_inq_varid (ncid, sn->var_name[nv], &varid));
+    n = 0;
+    for (k = 0; k < g->np[2]; k++){
+    for (j = 0; j < g->np[1]; j++){
+    for (i = 0; i < g->np[0]; i++){
+      dbuf[n] = DblValue(f, nv, k, j, i);
+      fbuf[n] = (float)dbuf[n];
+      n++;
+    }}}
+    if (single) NC_CHECK(nc_put_vara_float (ncid, varid, start, count, fbuf))
+    else        NC_CHECK(nc_put_vara_double(ncid, varid, start, count, dbuf))
+  }
+  NC_CHECK(nc_close(ncid));
+  free (fbuf);
+  free (dbuf);
+}
+#undef NC_CHECK
+#endif /* USE_NETCDF */
+
+/* ********************************************************************* */
+void WriteSlice (DblFile *f, Slice *s, const char *fname)
+/*!
+ * Write the slice box of the selected variables, one after the other
+ * with the x1 index running fastest, in local byte order.
+ *********************************************************************** */
+{
+  int    i, j, k, m, nv;
+  long   n, nelem = 1;
+  float  *fbuf;
+  double *dbuf;
+  const DblSnap *sn = f->snap;
+  FILE   *fp;
+
+  for (m = 0; m < 3; m++) nelem *= s->box[m][1] - s->box[m][0] + 1;
+  fbuf = (float *)  malloc (nelem*sizeof(float));
+  dbuf = (double *) malloc (nelem*sizeof(double));
+
+  fp = fopen (fname, "wb");
+  if (fp == NULL){
+    fprintf (stderr, "! WriteSlice(): cannot open %s\n", fname);
+    Quit (1);
+  }
+  for (m = 0; m < (s->nvar > 0 ? s->nvar:sn->nvar); m++){
+    nv = (s->nvar > 0 ? DblVarIndex(sn, s->var[m]):m);
+    if (nv < 0){
+      fprintf (stderr, "! WriteSlice(): unknown variable '%s' in %s\n",
+               s->var[m], s->name);
+      Quit (1);
+    }
+    if (sn->stag[nv] >= 0) continue;
+    n = 0;
+    for (k = s->box[2][0]; k <= s->box[2][1]; k++){
+    for (j = s->box[1][0]; j <= s->box[1][1]; j++){
+    for (i = s->box[0][0]; i <= s->box[0][1]; i++){
+      dbuf[n] = DblValue(f, nv, k, j, i);
+      fbuf[n] = (float)dbuf[n];
+      n++;
+    }}}
+    if (single) fwrite (fbuf, sizeof(float),  n, fp);
+    else        fwrite (dbuf, sizeof(double), n, fp);
+  }
+  fclose (fp);
+  free (fbuf);
+  free (dbuf);
+}
+
+/* ********************************************************************* */
+void WriteSliceList (DblArchive *arc, Slice *s, int nsnap)
+/*!
+ * Write <tt> name.out </tt> listing the slice files found on disk
+ * for the first nsnap files of the archive, in the same format used
+ * by slices.c.
+ *********************************************************************** */
+{
+  int    n, m, nv, little = 1;
+  char   fname[512];
+  struct stat st;
+  DblSnap *sn;
+  FILE   *fp;
+
+  little = (*(char *)&little == 1);
+  snprintf (fname, sizeof(fname), "%s/%s.out", out_dir, s->name);
+  fp = fopen (fname, "w");
+  if (fp == NULL){
+    fprintf (stderr, "! WriteSliceList(): cannot open %s\n", fname);
+    Quit (1);
+  }
+  for (n = 0; n < nsnap; n++){
+    sn = arc->snap + n;
+    snprintf (fname, sizeof(fname), "%s/%s.%04d.%s", out_dir, s->name,
+              sn->nfile, single ? "flt":"dbl");
+    if (stat(fname, &st) != 0) continue;
+    fprintf (fp, "%d %12.6e %12.6e %ld  %d %d %d %d %d %d  %s ",
+             sn->nfile, sn->t, sn->dt, sn->step,
+             s->box[0][0], s->box[0][1], s->box[1][0], s->box[1][1],
+             s->box[2][0], s->box[2][1], little ? "little":"big");
+    for (m = 0; m < (s->nvar > 0 ? s->nvar:sn->nvar); m++){
+      nv = (s->nvar > 0 ? DblVarIndex(sn, s->var[m]):m);
+      if (nv >= 0 && sn->stag[nv] < 0) fprintf (fp, "%s ", sn->var_name[nv]);
+    }
+    fprintf (fp, "\n");
+  }
+  fclose (fp);
+}
@@ -7,7 +7,7 @@
 #define  TIME_STEPPING                  EULER
 #define  NTRACER                        0
 #define  PARTICLES                      NO
-#define  USER_DEF_PARAMETERS            2
+#define  USER_DEF_PARAMETERS            4
 
 /* -- physics dependent declarations -- */
 
@@ -31,6 +31,7 @@
 #define  DATESHIFT                      0
 #define  DAILYBC                        1
 #define  USE_POLARITY                   2
+#define  ECLIPTIC                       3
 
 /* [Beg] user-defined constants (do not change this line) */
 
@@ -38,4 +39,6 @@
 #define UNIT_VELOCITY (CONST_au / 86400.0) // au/day
 #define UNIT_DENSITY (CONST_mp)   // assume protons
 
+#define CARRINGTON_FRAME NO // YES: frame rotating with the Sun, NO: with the Earth
+
 /* [End] user-defined constants (do not change this line) */
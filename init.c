@@ -83,16 +83,39 @@ void Init (double *v, double x1, double x2, double x3)
  *
  *********************************************************************** */
 {
-    const double coef1 = 0.1 / (x1);
-    const double coef2 = 0.1 * 0.1 / (x1 * x1);
-    const double coef3 = 0.1 * 0.1 * 0.1 / (x1 * x1 * x1);
+    const double r0 = boundary_radius();
+    const double coef1 = r0 / (x1);
+    const double coef2 = r0 * r0 / (x1 * x1);
+    const double coef3 = r0 * r0 * r0 / (x1 * x1 * x1);
 
     read_bnds();
 
+    // Frame rotating with the Sun (Carrington) or with the Earth (HEEQ).
+    // VTK files and probes are given in HEEQ, which coincides with the
+    // computational frame at the starting date.
+    #if CARRINGTON_FRAME == YES
+    g_OmegaZ = +2.0 * CONST_PI / SUN_ROTATION_PERIOD;
+    #else
+    g_OmegaZ = +2.0 * CONST_PI / EARTH_ORBITAL_PERIOD;
+    #endif
+    g_OmegaZout  = g_OmegaZ - 2.0 * CONST_PI / EARTH_ORBITAL_PERIOD;
+    g_tOmegaZout = -g_inputParam[DATESHIFT];
+    // The ambient wind pattern turns with the Sun
+    g_OmegaZsteady = 2.0 * CONST_PI / SUN_ROTATION_PERIOD - g_OmegaZ;
+
     v[RHO] = today_solarwind_data->mean_D / CONST_mp / 1000.0 * coef2;
     v[VX1] = today_solarwind_data->mean_V1 / 1000.0 / 149597870.7 * 86400;
     v[VX2] = 0;
     v[VX3] = 0;
+    #if CARRINGTON_FRAME == YES
+    // radial in the inertial frame, as at the inner boundary
+    v[VX3] = -g_OmegaZ * x1 * sin(x2);
+    #endif
+    #ifdef FARGO
+    // orbital velocity, VX3 holds the residual
+    v[FARGO_W] = v[VX3];
+    v[VX3] = 0.0;
+    #endif
 
     double mu = MeanMolecularWeight(v);
     #if HAVE_ENERGY
@@ -109,7 +132,6 @@ void Init (double *v, double x1, double x2, double x3)
     v[AX3] = 0.0;
     #endif
 
-    g_OmegaZ = +2.0 * CONST_PI / 365.25;
     g_gamma = 1.5;
 }
 
@@ -184,6 +206,9 @@ void UserDefBoundary (const Data *d, RBox *box, int side, Grid *grid)
     const double* x1 = grid->x[IDIR];
     const double* x2 = grid->x[JDIR];
     const double* x3 = grid->x[KDIR];
+    #ifdef FARGO
+    double **wA = FARGO_Velocity();
+    #endif
 
     int i, j, k;
     if (side == X1_BEG && box->vpos == CENTER) {
@@ -207,6 +232,9 @@ void UserDefBoundary (const Data *d, RBox *box, int side, Grid *grid)
             // take into account frame rotation
             // (the velocity is radial in the inertial frame but not in rotating frame)
             d->Vc[VX3][k][j][i] = -g_OmegaZ * x1[i] * sin(x2[j]);
+            #ifdef FARGO
+            d->Vc[VX3][k][j][i] -= wA[j][i];
+            #endif
             #if HAVE_ENERGY
             double mu = MeanMolecularWeight(NULL);
             d->Vc[PRS][k][j][i] = d->Vc[RHO][k][j][i] * T /(KELVIN * mu);
@@ -10,10 +10,10 @@ void average_boundary(boundary_data* today_solarwind_data, boundary_data** daily
                       cme_timeline_t* cme_timeline,
                       Grid* grid, int local_j, int local_k,
                       double* D, double* V1, double* T, double* B1, double* B3, double x1, int step_count) {
-    double j, k;
-    map_to_global_indexes(local_j, local_k, &j, &k);
-
     double t = g_time + g_inputParam[DATESHIFT];
+
+    double j, k;
+    map_to_global_indexes(grid, local_j, local_k, equator_latitude(today_solarwind_data, t), &j, &k);
     int cme_index = get_cme_index_by_pluto_time(cme_timeline, t);
 
     if (cme_index >= 0 && cme_index < (int) cme_timeline->len) {
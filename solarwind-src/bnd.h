@@ -36,6 +36,7 @@ typedef struct {
     int mode;
 
     int obsdate_hour;
+    double obsdate_doy;
     double pluto_time_from_main_bnd;
 } boundary_data;
 
@@ -199,6 +200,7 @@ boundary_data* read_bnd(const char* path) {
 	nc_get_att_text(nc_id, NC_GLOBAL, "obsdate_cal", obsdate_cal);
     char hour[3] = {obsdate_cal[11], obsdate_cal[12], '\0'};
     data->obsdate_hour = atoi(hour);
+    data->obsdate_doy = obsdate_cal_to_day_of_year(obsdate_cal);
 
     data->pluto_time_from_main_bnd = 0;
 
@@ -89,10 +89,10 @@ void process_daily_ambient(
 void daily_boundary(boundary_data** daily_solarwind_data, cme_timeline_t* cme_timeline,
                     Grid* grid, int _i, int local_j, int local_k,
                     double* D, double* V1, double* T, double* B1, double* B3, double x1, int step_count) {
-    double j, k;
-    map_to_global_indexes(local_j, local_k, &j, &k);
-
     double t = g_time + g_inputParam[DATESHIFT];
+
+    double j, k;
+    map_to_global_indexes(grid, local_j, local_k, equator_latitude(daily_solarwind_data[0], t), &j, &k);
     int daily_idx = get_daily_idx_by_time(daily_solarwind_data, t);
 
     double daily_solarwind_time;
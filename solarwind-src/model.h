@@ -6,12 +6,46 @@
 #include "solarwind-src/bnd.h"
 #include "solarwind-src/utils.h"
 
-double rotate_bc(double k, const double t) {
+// Sidereal rotation period of the Sun (Carrington) and orbital period
+// of the Earth, days
+#define SUN_ROTATION_PERIOD   25.38
+#define EARTH_ORBITAL_PERIOD  365.25
+
+// Inclination of the solar equator to the ecliptic, deg, and day of the
+// year at which the Earth crosses the solar equator northwards (7 June)
+#define SOLAR_EQUATOR_INCLINATION  7.25
+#define EARTH_NODE_DAY             157.0
+
+// Heliographic latitude of the Earth (B0 angle), deg, on day doy of the
+// year (see obsdate_cal_to_day_of_year())
+double earth_latitude(const double doy) {
+  return SOLAR_EQUATOR_INCLINATION * sin(2 * CONST_PI * (doy - EARTH_NODE_DAY) / EARTH_ORBITAL_PERIOD);
+}
+
+// Heliographic latitude of the grid equator at time t (days from the
+// date of the maps in data), deg. In ecliptic mode the grid equator is
+// the plane of the Earth, otherwise it is the solar equator.
+double equator_latitude(const boundary_data* data, const double t) {
+  if (!g_inputParam[ECLIPTIC]) {
+    return 0.0;
+  }
+  return earth_latitude(data->obsdate_doy + t);
+}
+
+// Longitude index of the map made at time tau (in HEEQ of that date) that
+// is seen at time t by the zone with longitude index k.
+// The computational frame coincides with HEEQ at t = 0.
+double rotate_bc(double k, const double t, const double tau) {
+  const double omega_earth = 2.0 * CONST_PI / EARTH_ORBITAL_PERIOD;
+
   // Carrington sidereal rotation rate
-  k -= (180 * t / 25.38);
+  k -= (180 * (t - tau) / SUN_ROTATION_PERIOD);
   // Take into account frame rotation and get synodic rotation rate (27.2753)
-  k += (t * 180 * g_OmegaZ / (2 * CONST_PI));
-  
+  k += ((t - tau) * 180 * g_OmegaZ / (2 * CONST_PI));
+  // Angle between the frame and HEEQ at time tau (zero if the frame
+  // rotates with the Earth)
+  k += (tau * 180 * (g_OmegaZ - omega_earth) / (2 * CONST_PI));
+
   while (k < 0) k += 180;
   while (k >= 180) k -= 180;
 
@@ -26,10 +60,18 @@ double normalize_time(double t, double left, double right) {
   return (t - left) / (right - left);
 }
 
+// Radius at which the boundary maps are given (0.1 au for WSA maps):
+// the inner radius of the domain, as set by X1-grid in pluto.ini
+double boundary_radius() {
+  return g_domBeg[IDIR];
+}
+
+// Scale map values from the boundary radius to radius x1
 void normalize(double *D, double *T, double *B1, double *B3, const double x1) {
-  const double coef1 = 0.1 / (x1);
-  const double coef2 = 0.1 * 0.1 / (x1 * x1);
-  const double coef3 = 0.1 * 0.1 * 0.1 / (x1 * x1 * x1);
+  const double r0 = boundary_radius();
+  const double coef1 = r0 / (x1);
+  const double coef2 = r0 * r0 / (x1 * x1);
+  const double coef3 = r0 * r0 * r0 / (x1 * x1 * x1);
 
   *D *= coef2;
   *T *= coef1;
@@ -52,11 +94,11 @@ void interpolate_vars(const boundary_data* solarwind_data, const double kk, cons
   *B3 = lerp(solarwind_data->B3[idx0], solarwind_data->B3[idx1], s);
 }
 
-void interpolate_ambient(const boundary_data* solarwind_data, const int k, const int j,
+void interpolate_ambient(const boundary_data* solarwind_data, const double k, const int j,
                          const double t, const double x1,
                          double* D, double* V1, double* T, double* B1, double* B3) {
   const double bkg_frame_time = convert_to_pluto_time(solarwind_data->TIME[solarwind_data->bkg_frame]);
-	const double kk = rotate_bc(k, -bkg_frame_time + t);
+	const double kk = rotate_bc(k, t, bkg_frame_time);
 
   int kk0 = (int) kk;
   int kk1 = min(179, kk0 + 1);
@@ -73,13 +115,13 @@ void interpolate_ambient(const boundary_data* solarwind_data, const int k, const
 }
 
 void interpolate_cme(const boundary_data* solarwind_data, const int left_frame, const int right_frame,
-                     const int k, const int j, const double t, const double x1,
+                     const double k, const int j, const double t, const double x1,
                      double* D, double* V1, double* T, double* B1, double* B3) {
   const double left_time = convert_to_pluto_time(solarwind_data->TIME[left_frame]);
   const double right_time = convert_to_pluto_time(solarwind_data->TIME[right_frame]);
 
-  const double kk_cur = rotate_bc(k, t - left_time);
-  const double kk_next = rotate_bc(k, -right_time + t);
+  const double kk_cur = rotate_bc(k, t, left_time);
+  const double kk_next = rotate_bc(k, t, right_time);
 
   double Dcur, V1cur, Tcur, B1cur, B3cur;
   interpolate_vars(solarwind_data, kk_cur, j, left_frame, &Dcur, &V1cur, &Tcur, &B1cur, &B3cur);
@@ -24,10 +24,30 @@ int obsdate_cal_to_seconds_from_midnight(const char* date) {
     return atoi(hour) * 60 * 60;
 }
 
-void map_to_global_indexes(const int local_j, const int local_k, double* global_j, double* global_k) {
-    int total_pieces_k = 180 / NX3;
-    *global_j = local_j - 2 + prank / total_pieces_k * NX2;
-    *global_k = local_k - 2 + prank % total_pieces_k * NX3;
+// Day of the year (0 on 1 January at midnight) of an obsdate_cal
+// string "YYYY-MM-DDTHH:MM:SS"
+double obsdate_cal_to_day_of_year(const char* date) {
+    static const int month_start[12] = {0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334};
+    int year = 2000, month = 1, day = 1;
+    sscanf(date, "%d-%d-%d", &year, &month, &day);
+    const int leap = (year % 4 == 0 && (year % 100 != 0 || year % 400 == 0));
+    return month_start[month - 1] + (leap && month > 2) + day - 1
+           + obsdate_cal_to_seconds_from_midnight(date) / 86400.0;
+}
+
+// Position of a zone on the 180 x 60 boundary maps, whose cells are the
+// zones of the production grid (2 deg, colatitudes 30..150 deg). On a
+// coarser grid (e.g. for the spin-up) k falls between map cells, which
+// are interpolated, and j is rounded. On a full-latitude grid zones
+// closer to the poles take the first or last row.
+// lat0 is the heliographic latitude of the grid equator, deg (nonzero
+// in ecliptic mode only).
+void map_to_global_indexes(const Grid* grid, const int local_j, const int local_k,
+                           const double lat0, double* global_j, double* global_k) {
+    const int kg = local_k - KBEG + grid->beg[KDIR] - grid->gbeg[KDIR];
+    const double theta = grid->x[JDIR][local_j] * 180.0 / CONST_PI - lat0;
+    *global_j = floor((theta - 30.0) / 2.0 + 1.e-6);
+    *global_k = (kg + 0.5) * 180.0 / grid->np_int_glob[KDIR] - 0.5;
     if (*global_j < 0)      *global_j = 0;
     if (*global_j > 59)     *global_j = 59;
     while (*global_k < 0)   *global_k += 180;